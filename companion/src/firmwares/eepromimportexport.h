@@ -24,7 +24,115 @@
 #include "customdebug.h"
 
 #include <QtCore>
-#include <QBitArray>
+
+// Bit stream writer appending to a QByteArray: a field's bit 0 goes to the lowest free bit of the stream,
+// fields are packed one after another without any alignment (little-endian, as in the radio datastructs)
+class BitWriter {
+  public:
+    explicit BitWriter(QByteArray & bytes):
+      bytes(bytes),
+      count(bytes.size() * 8)
+    {
+    }
+
+    // number of bits written
+    inline unsigned int size() const
+    {
+      return count;
+    }
+
+    // appends the lowest 'bits' bits of value
+    void write(quint64 value, unsigned int bits)
+    {
+      reserve(count + bits);
+      uchar * data = (uchar *)bytes.data();
+      while (bits > 0) {
+        unsigned int shift = count & 7;
+        unsigned int len = qMin(8 - shift, bits);
+        data[count >> 3] |= (uchar)((value & ((1u << len) - 1)) << shift);
+        value >>= len;
+        count += len;
+        bits -= len;
+      }
+    }
+
+    // pads with zero bits up to 'bits' bits
+    void resize(unsigned int bits)
+    {
+      if (bits > count) {
+        reserve(bits);
+        count = bits;
+      }
+    }
+
+  protected:
+    void reserve(unsigned int bits)
+    {
+      int len = (bits + 7) / 8;
+      if (len > bytes.size()) {
+        int previous = bytes.size();
+        bytes.resize(len);
+        memset(bytes.data() + previous, 0, len - previous);
+      }
+    }
+
+    QByteArray & bytes;
+    unsigned int count;
+};
+
+// Read-only view on a range of bits of a byte buffer, bits outside of the buffer read as 0
+class BitReader {
+  public:
+    explicit BitReader(const QByteArray & bytes):
+      data((const uchar *)bytes.constData()),
+      offset(0),
+      count(bytes.size() * 8)
+    {
+    }
+
+    inline unsigned int size() const
+    {
+      return count;
+    }
+
+    // sub-range of 'bits' bits starting at 'pos'
+    BitReader mid(unsigned int pos, unsigned int bits) const
+    {
+      BitReader result(*this);
+      result.offset = offset + pos;
+      result.count = (pos >= count ? 0 : qMin(bits, count - pos));
+      return result;
+    }
+
+    // reads 'bits' bits (up to 64) starting at 'pos'
+    quint64 read(unsigned int pos, unsigned int bits) const
+    {
+      quint64 value = 0;
+      unsigned int done = 0;
+      if (pos >= count)
+        return 0;
+      bits = qMin(qMin(bits, count - pos), 64u);  // the bits above 64 can't be returned (e.g. large spare fields)
+      pos += offset;
+      while (done < bits) {
+        unsigned int shift = pos & 7;
+        unsigned int len = qMin(8 - shift, bits - done);
+        value |= (quint64)((data[pos >> 3] >> shift) & ((1u << len) - 1)) << done;
+        pos += len;
+        done += len;
+      }
+      return value;
+    }
+
+    inline bool bit(unsigned int pos) const
+    {
+      return read(pos, 1);
+    }
+
+  protected:
+    const uchar * data;
+    unsigned int offset;
+    unsigned int count;
+};
 
 class DataField {
   Q_DECLARE_TR_FUNCTIONS(DataField)
@@ -46,60 +154,38 @@ class DataField {
     }
 
     virtual unsigned int size() = 0;
-    virtual void ExportBits(QBitArray & output) = 0;
-    virtual void ImportBits(const QBitArray & input) = 0;
-
-    QBitArray bytesToBits(QByteArray bytes)
-    {
-      QBitArray bits(bytes.count()*8);
-      // Convert from QByteArray to QBitArray
-      for (int i=0; i<bytes.count(); ++i)
-        for (int b=0; b<8; ++b)
-          bits.setBit(i*8+b, bytes.at(i)&(1<<b));
-      return bits;
-    }
-
-    QByteArray bitsToBytes(QBitArray bits, int offset=0)
-    {
-      QByteArray bytes;
-      bytes.resize((offset+bits.count()+7)/8);
-      bytes.fill(0);
-      // Convert from QBitArray to QByteArray
-      for (int b=0; b<bits.count(); ++b)
-        bytes[(b+offset)/8] = ( bytes.at((b+offset)/8) | ((bits[b]?1:0)<<((b+offset)%8)));
-      return bytes;
-    }
+    virtual void ExportBits(BitWriter & output) = 0;
+    virtual void ImportBits(const BitReader & input) = 0;
 
     int Export(QByteArray & output)
     {
-      QBitArray result;
-      ExportBits(result);
-      output = bitsToBytes(result);
+      output.clear();
+      BitWriter bits(output);
+      ExportBits(bits);
       return 0;
     }
 
     int Import(const QByteArray & input)
     {
-      QBitArray bits = bytesToBits(input);
-      if ((unsigned int)bits.size() < size()) {
+      if ((unsigned int)input.size() * 8 < size()) {
         qDebug() << QString("Error importing %1: size to small %2/%3").arg(getName()).arg(input.size()).arg(size());
         return -1;
       }
-      ImportBits(bits);
+      ImportBits(BitReader(input));
       return 0;
     }
 
     virtual int Dump(int level=0, int offset=0)
     {
-      QBitArray bits;
+      QByteArray bytes;
+      BitWriter bits(bytes);
       ExportBits(bits);
-      QByteArray bytes = bitsToBytes(bits);
-      int result = (offset+bits.count()) % 8;
+      int result = (offset+bits.size()) % 8;
       for (int i=0; i<level; i++) printf("  ");
-      if (bits.count() % 8 == 0)
+      if (bits.size() % 8 == 0)
         printf("%s (%dbytes) ", getName().toLatin1().constData(), bytes.count());
       else
-        printf("%s (%dbits) ", getName().toLatin1().constData(), bits.count());
+        printf("%s (%dbits) ", getName().toLatin1().constData(), bits.size());
       for (int i=0; i<bytes.count(); i++) {
         unsigned char c = bytes[i];
         if ((i==0 && offset) || (i==bytes.count()-1 && result!=0))
@@ -164,27 +250,18 @@ class BaseUnsignedField: public DataField {
     {
     }
 
-    virtual void ExportBits(QBitArray & output)
+    virtual void ExportBits(BitWriter & output)
     {
       container value = field;
       if (value > max) value = max;
       if (value < min) value = min;
 
-      output.resize(N);
-      for (int i=0; i<N; i++) {
-        if (value & ((container)1<<i)) {
-          output.setBit(i);
-        }
-      }
+      output.write((quint64)value, N);
     }
 
-    virtual void ImportBits(const QBitArray & input)
+    virtual void ImportBits(const BitReader & input)
     {
-      field = 0;
-      for (int i=0; i<N; i++) {
-        if (input[i])
-          field |= ((container)1<<i);
-      }
+      field = (container)input.read(0, N);
       qCDebug(eepromImport) << QString("\timported %1<%2>: 0x%3(%4)").arg(name).arg(N).arg(field, 0, 16).arg(field);
     }
 
@@ -231,17 +308,14 @@ class BoolField: public DataField {
     {
     }
 
-    virtual void ExportBits(QBitArray & output)
+    virtual void ExportBits(BitWriter & output)
     {
-      output.resize(N);
-      if (field) {
-        output.setBit(0);
-      }
+      output.write(field ? 1 : 0, N);
     }
 
-    virtual void ImportBits(const QBitArray & input)
+    virtual void ImportBits(const BitReader & input)
     {
-      field = input[0] ? true : false;
+      field = input.bit(0);
       qCDebug(eepromImport) << QString("\timported %1<%2>: 0x%3(%4)").arg(name).arg(N).arg(field, 0, 16).arg(field);
     }
 
@@ -284,31 +358,22 @@ class SignedField: public DataField {
     {
     }
 
-    virtual void ExportBits(QBitArray & output)
+    virtual void ExportBits(BitWriter & output)
     {
       int value = field;
       if (value > max) value = max;
       if (value < min) value = min;
 
-      output.resize(N);
-      for (int i=0; i<N; i++) {
-        if (((unsigned int)value) & (1<<i))
-          output.setBit(i);
-      }
+      output.write((unsigned int)value, N);
     }
 
-    virtual void ImportBits(const QBitArray & input)
+    virtual void ImportBits(const BitReader & input)
     {
-      unsigned int value = 0;
-      for (int i=0; i<N; i++) {
-        if (input[i])
-          value |= (1<<i);
-      }
+      unsigned int value = (unsigned int)input.read(0, N);
 
-      if (input[N-1]) {
-        for (unsigned int i=N; i<8*sizeof(int); i++) {
-          value |= (1<<i);
-        }
+      // sign extension
+      if (N < 8*sizeof(int) && input.bit(N-1)) {
+        value |= ~0u << (N % (8*sizeof(int)));
       }
 
       field = (int)value;
@@ -348,30 +413,19 @@ class CharField: public DataField {
     {
     }
 
-    virtual void ExportBits(QBitArray & output)
+    virtual void ExportBits(BitWriter & output)
     {
-      output.resize(N*8);
-      int b = 0;
       int len = truncate ? strlen(field) : N;
       for (int i=0; i<N; i++) {
         int idx = (i>=len ? 0 : field[i]);
-        for (int j=0; j<8; j++, b++) {
-          if (idx & (1<<j))
-            output.setBit(b);
-        }
+        output.write((uint8_t)idx, 8);
       }
     }
 
-    virtual void ImportBits(const QBitArray & input)
+    virtual void ImportBits(const BitReader & input)
     {
-      unsigned int b = 0;
       for (int i=0; i<N; i++) {
-        int8_t idx = 0;
-        for (int j=0; j<8; j++) {
-          if (input[b++])
-            idx |= (1<<j);
-        }
-        field[i] = idx;
+        field[i] = (int8_t)input.read(i*8, 8);
       }
       qCDebug(eepromImport) << QString("\timported %1<%2>: '%3'").arg(name).arg(N).arg(field);
     }
@@ -423,30 +477,19 @@ class ZCharField: public DataField {
     {
     }
 
-    virtual void ExportBits(QBitArray & output)
+    virtual void ExportBits(BitWriter & output)
     {
-      output.resize(N*8);
-      int b = 0;
       int len = strlen(field);
       for (int i=0; i<N; i++) {
         int idx = i>=len ? 0 : char2idx(field[i]);
-        for (int j=0; j<8; j++, b++) {
-          if (idx & (1<<j))
-            output.setBit(b);
-        }
+        output.write((uint8_t)idx, 8);
       }
     }
 
-    virtual void ImportBits(const QBitArray & input)
+    virtual void ImportBits(const BitReader & input)
     {
-      unsigned int b = 0;
       for (int i=0; i<N; i++) {
-        int8_t idx = 0;
-        for (int j=0; j<8; j++) {
-          if (input[b++])
-            idx |= (1<<j);
-        }
-        field[i] = idx2char(idx);
+        field[i] = idx2char((int8_t)input.read(i*8, 8));
       }
 
       field[N] = '\0';
@@ -486,29 +529,23 @@ class StructField: public DataField {
       fields.append(field);
     }
 
-    virtual void ExportBits(QBitArray & output)
+    virtual void ExportBits(BitWriter & output)
     {
-      int offset = 0;
-      output.resize(size());
+      unsigned int start = output.size();
       foreach(DataField *field, fields) {
-        QBitArray bits;
-        field->ExportBits(bits);
-        for (int i=0; i<bits.size(); i++)
-          output[offset++] = bits[i];
+        field->ExportBits(output);
       }
+      output.resize(start + size());
     }
 
-    virtual void ImportBits(const QBitArray & input)
+    virtual void ImportBits(const BitReader & input)
     {
       qCDebug(eepromImport) << QString("\timporting %1[%2]:").arg(name).arg(fields.size());
-      int offset = 0;
+      unsigned int offset = 0;
       foreach(DataField *field, fields) {
         unsigned int size = field->size();
-        QBitArray bits(size);
-        for (unsigned int i=0; i<size; i++) {
-          bits[i] = input[offset++];
-        }
-        field->ImportBits(bits);
+        field->ImportBits(input.mid(offset, size));
+        offset += size;
       }
     }
 
@@ -547,13 +584,13 @@ class TransformedField: public DataField {
     {
     }
 
-    virtual void ExportBits(QBitArray & output)
+    virtual void ExportBits(BitWriter & output)
     {
       beforeExport();
       field.ExportBits(output);
     }
 
-    virtual void ImportBits(const QBitArray & input)
+    virtual void ImportBits(const BitReader & input)
     {
       qCDebug(eepromImport) << QString("\timporting TransformedField %1:").arg(field.getName());
       field.ImportBits(input);
@@ -24,6 +24,7 @@
 #include "customdebug.h"
 #include <stdlib.h>
 #include <algorithm>
+#include <QMutex>
 
 using namespace Board;
 
@@ -205,11 +206,13 @@ class SwitchesConversionTable: public ConversionTable {
     };
 
     static std::list<Cache> internalCache;
+    static QMutex internalCacheMutex;  // models may be decoded concurrently
 
   public:
 
     static SwitchesConversionTable * getInstance(Board::Type board, unsigned int version, unsigned long flags=0)
     {
+      QMutexLocker locker(&internalCacheMutex);
       for (std::list<Cache>::iterator it=internalCache.begin(); it!=internalCache.end(); it++) {
         Cache & element = *it;
         if (element.board == board && element.version == version && element.flags == flags)
@@ -222,6 +225,7 @@ class SwitchesConversionTable: public ConversionTable {
     }
     static void Cleanup()
     {
+      QMutexLocker locker(&internalCacheMutex);
       for (std::list<Cache>::iterator it=internalCache.begin(); it!=internalCache.end(); it++) {
         Cache & element = *it;
         if (element.table)
@@ -232,6 +236,7 @@ class SwitchesConversionTable: public ConversionTable {
 };
 
 std::list<SwitchesConversionTable::Cache> SwitchesConversionTable::internalCache;
+QMutex SwitchesConversionTable::internalCacheMutex;
 
 #define FLAG_NONONE       0x01
 #define FLAG_NOSWITCHES   0x02
@@ -396,11 +401,13 @@ class SourcesConversionTable: public ConversionTable {
         SourcesConversionTable * table;
     };
     static std::list<Cache> internalCache;
+    static QMutex internalCacheMutex;  // models may be decoded concurrently
 
   public:
 
     static SourcesConversionTable * getInstance(Board::Type board, unsigned int version, unsigned int variant, unsigned long flags=0)
     {
+      QMutexLocker locker(&internalCacheMutex);
       for (std::list<Cache>::iterator it=internalCache.begin(); it!=internalCache.end(); it++) {
         Cache & element = *it;
         if (element.board == board && element.version == version && element.variant == variant && element.flags == flags)
@@ -413,6 +420,7 @@ class SourcesConversionTable: public ConversionTable {
     }
     static void Cleanup()
     {
+      QMutexLocker locker(&internalCacheMutex);
       for (std::list<Cache>::iterator it=internalCache.begin(); it!=internalCache.end(); it++) {
         Cache & element = *it;
         if (element.table)
@@ -423,6 +431,7 @@ class SourcesConversionTable: public ConversionTable {
 };
 
 std::list<SourcesConversionTable::Cache> SourcesConversionTable::internalCache;
+QMutex SourcesConversionTable::internalCacheMutex;
 
 void OpenTxEepromCleanup(void)
 {
@@ -2622,7 +2631,7 @@ class FrskyScreenField: public DataField {
       }
     }
 
-    virtual void ExportBits(QBitArray & output)
+    virtual void ExportBits(BitWriter & output)
     {
       if (IS_ARM(board) && version >= 217) {
         if (screen.type == TELEMETRY_SCREEN_SCRIPT)
@@ -2642,7 +2651,7 @@ class FrskyScreenField: public DataField {
       }
     }
 
-    virtual void ImportBits(const QBitArray & input)
+    virtual void ImportBits(const BitReader & input)
     {
       qCDebug(eepromImport) << QString("importing %1: type: %2").arg(name).arg(screen.type);
 
@@ -22,10 +22,20 @@
 
 #include <QApplication>
 #include <QCryptographicHash>
+#include <QDataStream>
 #include <QElapsedTimer>
 #include <QMutexLocker>
+#include <QPair>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QStandardPaths>
 
 #define SYNC_MAX_ERRORS       50  // give up after this many errors per destination
+#define SYNC_MAX_IO_JOBS      4   // files compared/copied at the same time
+#define SYNC_MAX_PENDING      32  // entries waiting to be reported, in order
+#define SYNC_HASH_CHUNK       (64 * 1024)
+#define SYNC_MANIFEST_MAGIC   0x4F545853  // "OTXS"
+#define SYNC_MANIFEST_VERSION 1
 
 // a flood of log messages can make the UI unresponsive so we'll introduce a dynamic sleep period based on log frequency (values in [us])
 #define PAUSE_FACTOR          60UL
@@ -45,6 +55,12 @@
 #define PRINT_INFO(str)       emit progressMessage((str))                // this is always emitted regardless of logLevel option
 #define PRINT_SEP()           PRINT_INFO(QString(70, '='))
 
+// messages of an entry are queued and printed when the entry is reported
+#define ENTRY_CREATE(str)     job->print((str), QtInfoMsg)
+#define ENTRY_REPLACE(str)    job->print((str), QtWarningMsg)
+#define ENTRY_ERROR(str)      job->print((str), QtFatalMsg)
+#define ENTRY_SKIP(str)       job->print((str), QtDebugMsg)
+
 #ifdef Q_OS_WIN
   extern Q_CORE_EXPORT int qt_ntfs_permission_lookup;
   #define FILTER_RE_SYNTX     QRegExp::Wildcard
@@ -52,6 +68,184 @@
   #define FILTER_RE_SYNTX     QRegExp::WildcardUnix
 #endif
 
+struct SyncProcess::SyncEntry : public QRunnable
+{
+  SyncEntry(SyncProcess * process, SyncManifest * srcManifest, SyncManifest * dstManifest) :
+    process(process),
+    srcManifest(srcManifest),
+    dstManifest(dstManifest),
+    counted(false),
+    isFile(false),
+    cancelled(false)
+  {
+    setAutoDelete(false);
+    stat.clear();
+  }
+
+  void run() override
+  {
+    process->updateFile(this);
+    done.release();
+  }
+
+  void print(const QString & text, int type)
+  {
+    messages.append(qMakePair(text, type));
+  }
+
+  SyncProcess * process;
+  SyncManifest * srcManifest;
+  SyncManifest * dstManifest;
+  QString srcPath;
+  QString destPath;
+  QVector<QPair<QString, int> > messages;
+  SyncStatus stat;     // only created/updated/skipped/errored are used
+  bool counted;        // included in the files count and status updates
+  bool isFile;
+  bool cancelled;
+  QSemaphore done;
+};
+
+static QByteArray fileHash(const QString & path, QString & error)
+{
+  QFile file(path);
+  if (!file.open(QFile::ReadOnly)) {
+    error = file.errorString();
+    return QByteArray();
+  }
+
+  QCryptographicHash hash(QCryptographicHash::Md5);
+  QByteArray buffer(SYNC_HASH_CHUNK, Qt::Uninitialized);
+  qint64 len;
+  while ((len = file.read(buffer.data(), buffer.size())) > 0)
+    hash.addData(buffer.constData(), len);
+  if (len < 0) {
+    error = file.errorString();
+    return QByteArray();
+  }
+  return hash.result();
+}
+
+QString SyncManifest::fileName() const
+{
+  const QString name = QString::fromLatin1(QCryptographicHash::hash(QDir::cleanPath(QDir(m_folder).absolutePath()).toUtf8(), QCryptographicHash::Md5).toHex());
+  return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) % "/sync/" % name % ".dat";
+}
+
+QString SyncManifest::key(const QFileInfo & fileInfo) const
+{
+  return QDir(m_folder).relativeFilePath(fileInfo.absoluteFilePath());
+}
+
+void SyncManifest::load(const QString & folder)
+{
+  QMutexLocker locker(&m_mutex);
+  m_folder = folder;
+  m_entries.clear();
+  m_dirty = false;
+
+  QFile file(fileName());
+  if (!file.open(QFile::ReadOnly))
+    return;
+
+  QDataStream in(&file);
+  in.setVersion(QDataStream::Qt_5_0);
+  quint32 magic, version, count;
+  in >> magic >> version >> count;
+  if (magic != SYNC_MANIFEST_MAGIC || version != SYNC_MANIFEST_VERSION)
+    return;
+
+  m_entries.reserve(count);
+  for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; i++) {
+    QString key;
+    Entry entry;
+    in >> key >> entry.size >> entry.modified >> entry.hash;
+    entry.used = false;
+    m_entries.insert(key, entry);
+  }
+  if (in.status() != QDataStream::Ok) {
+    qWarning() << "Discarding corrupted sync manifest" << file.fileName();
+    m_entries.clear();
+  }
+}
+
+void SyncManifest::save(bool prune)
+{
+  QMutexLocker locker(&m_mutex);
+  if (m_folder.isEmpty())
+    return;
+
+  if (prune) {
+    // entries of files which were not looked up during a complete run are stale
+    for (QHash<QString, Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ) {
+      if (it->used) {
+        ++it;
+      }
+      else {
+        it = m_entries.erase(it);
+        m_dirty = true;
+      }
+    }
+  }
+
+  if (!m_dirty)
+    return;
+
+  const QString path = fileName();
+  QDir().mkpath(QFileInfo(path).absolutePath());
+  QFile file(path);
+  if (!file.open(QFile::WriteOnly | QFile::Truncate)) {
+    qWarning() << "Could not save sync manifest" << path << file.errorString();
+    return;
+  }
+
+  QDataStream out(&file);
+  out.setVersion(QDataStream::Qt_5_0);
+  out << quint32(SYNC_MANIFEST_MAGIC) << quint32(SYNC_MANIFEST_VERSION) << quint32(m_entries.size());
+  for (QHash<QString, Entry>::const_iterator it = m_entries.constBegin(); it != m_entries.constEnd(); ++it)
+    out << it.key() << it->size << it->modified << it->hash;
+  m_dirty = false;
+}
+
+QByteArray SyncManifest::hash(const QFileInfo & fileInfo, QString & error)
+{
+  const QString k = key(fileInfo);
+  const qint64 size = fileInfo.size();
+  const qint64 modified = fileInfo.lastModified().toMSecsSinceEpoch();
+
+  {
+    QMutexLocker locker(&m_mutex);
+    QHash<QString, Entry>::iterator it = m_entries.find(k);
+    if (it != m_entries.end() && it->size == size && it->modified == modified && !it->hash.isEmpty()) {
+      it->used = true;
+      return it->hash;
+    }
+  }
+
+  // read the file without holding the lock, other workers may use the manifest meanwhile
+  const QByteArray result = fileHash(fileInfo.absoluteFilePath(), error);
+  if (!result.isEmpty())
+    setHash(fileInfo, result);
+  return result;
+}
+
+void SyncManifest::setHash(const QFileInfo & fileInfo, const QByteArray & hash)
+{
+  const QString k = key(fileInfo);
+  QMutexLocker locker(&m_mutex);
+  if (hash.isEmpty()) {
+    if (m_entries.remove(k))
+      m_dirty = true;
+    return;
+  }
+  Entry & entry = m_entries[k];
+  entry.size = fileInfo.size();
+  entry.modified = fileInfo.lastModified().toMSecsSinceEpoch();
+  entry.hash = hash;
+  entry.used = true;
+  m_dirty = true;
+}
+
 SyncProcess::SyncProcess(const SyncProcess::SyncOptions & options) :
   m_options(options),
   m_pauseTime(PAUSE_MINTM),
@@ -62,6 +256,8 @@ SyncProcess::SyncProcess(const SyncProcess::SyncOptions & options) :
   if (m_options.compareType == OVERWR_ALWAYS && (m_options.direction == SYNC_A2B_B2A || m_options.direction == SYNC_B2A_A2B))
     m_options.compareType = OVERWR_IF_DIFF;
 
+  m_pool.setMaxThreadCount(SYNC_MAX_IO_JOBS);
+
   m_dirFilters = QDir::Filters(m_options.dirFilterFlags);
   if (!(m_dirFilters & QDir::Dirs))
     m_dirFilters &= ~(QDir::AllDirs);
@@ -85,6 +281,8 @@ SyncProcess::SyncProcess(const SyncProcess::SyncOptions & options) :
 
 SyncProcess::~SyncProcess()
 {
+  m_pool.waitForDone();
+  qDeleteAll(m_entries);
 #ifdef Q_OS_WIN
   qt_ntfs_permission_lookup--;  // global revert NTFS permissions checking
 #endif
@@ -113,6 +311,8 @@ void SyncProcess::run()
 
   m_stat.clear();
   m_startTime = QDateTime::currentDateTime();
+  m_manifestA.load(folderA);
+  m_manifestB.load(folderB);
 
   emit started();
   emit fileCountChanged(0);
@@ -171,6 +371,9 @@ void SyncProcess::run()
 
 void SyncProcess::finish()
 {
+  m_manifestA.save(m_stat.index >= m_stat.count);
+  m_manifestB.save(m_stat.index >= m_stat.count);
+
   const std::lldiv_t elapsed = std::lldiv(m_startTime.secsTo(QDateTime::currentDateTime()), 60);
   QString endStr = testRunStr;
   if (m_stat.index < m_stat.count)
@@ -240,54 +443,66 @@ int SyncProcess::getFilesCount(const QString & directory)
   return result;
 }
 
+SyncManifest * SyncProcess::manifest(const QString & folder)
+{
+  return (folder == m_manifestA.folder() ? &m_manifestA : &m_manifestB);
+}
+
 void SyncProcess::updateDir(const QString & source, const QString & destination)
 {
   SyncStatus pStat = m_stat;
   const QDir srcDir(source), dstDir(destination);
+  SyncManifest * srcManifest = manifest(source);
+  SyncManifest * dstManifest = manifest(destination);
   FileFilterResult ffr;
+  bool proceed = true;
   emit statusMessage(testRunStr % tr("Synchronizing: %1\n    To: %2").arg(source, destination));
   PRINT_INFO(testRunStr % tr("Starting synchronization:\n  %1 -> %2\n").arg(source, destination));
 
   QFileInfoList infoList = dirInfoList(source);
   QMutableListIterator<QFileInfo> it(infoList);
   it.toBack();
-  while (it.hasPrevious() && !isStopRequsted()) {
+  while (it.hasPrevious() && !isStopRequsted() && proceed) {
     const QFileInfo fi(it.previous());
     it.remove();
+    SyncEntry * job = new SyncEntry(this, srcManifest, dstManifest);
+    bool queued = false;
     if ((ffr = fileFilter(fi)) == FILE_ALLOW) {
       pushDirEntries(fi, it);
       if ((m_dirFilters & QDir::Dirs) || fi.isFile()) {
-        updateEntry(fi.filePath(), srcDir, dstDir);
-        if (fi.isFile())
-          ++m_stat.index;
-        emit statusUpdate(m_stat);
-        if (m_stat.errored - pStat.errored > SYNC_MAX_ERRORS) {
-          PRINT_ERROR(tr("\nToo many errors, giving up."));
-          break;
+        job->counted = true;
+        job->isFile = fi.isFile();
+        if (updateEntry(fi.filePath(), srcDir, dstDir, job)) {
+          m_pool.start(job);
+          queued = true;
         }
       }
     }
     else if (m_options.logLevel == QtDebugMsg) {
       switch (ffr) {
         case FILE_OVERSIZE:
-          PRINT_SKIP(tr("Skipping large file: %1 (%2KB)").arg(fi.fileName()).arg(int(fi.size() / 1024)));
+          ENTRY_SKIP(tr("Skipping large file: %1 (%2KB)").arg(fi.fileName()).arg(int(fi.size() / 1024)));
           break;
         case FILE_EXCLUDE:
-          PRINT_SKIP(tr("Skipping filtered file: %1").arg(fi.fileName()));
+          ENTRY_SKIP(tr("Skipping filtered file: %1").arg(fi.fileName()));
           break;
         case FILE_LINK_IGNORE:
-          PRINT_SKIP(tr("Skipping linked file: %1").arg(fi.fileName()));
+          ENTRY_SKIP(tr("Skipping linked file: %1").arg(fi.fileName()));
           break;
         default:
           break;
       }
       // don't count as skipped because these weren't included in the total file count to begin with
     }
-    // throttle if needed
-    m_pauseTime = qMax(m_pauseTime - PAUSE_RECOVERY, PAUSE_MINTM);
-    pause();
+    if (!queued)
+      job->done.release();
+    m_entries.enqueue(job);
+    proceed = processEntries(pStat, SYNC_MAX_PENDING);
   }
 
+  // report the entries still in progress, even after giving up, since they may have been copied already
+  processEntries(pStat, 0);
+
   QString endStr = "\n" % testRunStr;
   if (isStopRequsted())
     endStr.append(tr("Aborted synchronization of:"));
@@ -299,7 +514,50 @@ void SyncProcess::updateDir(const QString & source, const QString & destination)
   PRINT_SEP();
 }
 
-bool SyncProcess::updateEntry(const QString & entry, const QDir & source, const QDir & destination)
+// Reports the finished entries in the order they were found, so the log reads the same as a sequential sync.
+// Waits for the oldest entry while more than maxPending are queued. Returns false once there were too many errors.
+bool SyncProcess::processEntries(const SyncStatus & pStat, int maxPending)
+{
+  while (!m_entries.isEmpty()) {
+    SyncEntry * job = m_entries.head();
+    if (m_entries.size() > maxPending) {
+      while (!job->done.tryAcquire(1, 20))
+        QApplication::processEvents();
+    }
+    else if (!job->done.tryAcquire()) {
+      break;
+    }
+    m_entries.dequeue();
+
+    const int errored = m_stat.errored;
+    if (!job->cancelled) {
+      for (const QPair<QString, int> & msg : job->messages)
+        emitProgressMessage(msg.first, msg.second);
+      m_stat.created += job->stat.created;
+      m_stat.updated += job->stat.updated;
+      m_stat.skipped += job->stat.skipped;
+      m_stat.errored += job->stat.errored;
+      if (job->counted) {
+        if (job->isFile)
+          ++m_stat.index;
+        emit statusUpdate(m_stat);
+      }
+    }
+    delete job;
+
+    if (errored - pStat.errored <= SYNC_MAX_ERRORS && m_stat.errored - pStat.errored > SYNC_MAX_ERRORS)
+      PRINT_ERROR(tr("\nToo many errors, giving up."));
+
+    // throttle if needed
+    m_pauseTime = qMax(m_pauseTime - PAUSE_RECOVERY, PAUSE_MINTM);
+    pause();
+  }
+
+  return (m_stat.errored - pStat.errored <= SYNC_MAX_ERRORS);
+}
+
+// Creates the destination directories, returns true if the entry is a file which still needs to be compared/copied
+bool SyncProcess::updateEntry(const QString & entry, const QDir & source, const QDir & destination, SyncEntry * job)
 {
   const QString srcPath = QDir::toNativeSeparators(source.absoluteFilePath(entry));
   const QString destPath = QDir::toNativeSeparators(destination.absoluteFilePath(source.relativeFilePath(entry)));
@@ -307,6 +565,9 @@ bool SyncProcess::updateEntry(const QString & entry, const QDir & source, const
   const QFileInfo destInfo(destPath);
   static QString lastMkPath;
 
+  job->srcPath = srcPath;
+  job->destPath = destPath;
+
   // check if this is a directory OR if we're copying a file with a path which doesn't exist yet.
   if (sourceInfo.isDir() || !destInfo.absoluteDir().exists()) {
     const QString mkPath = sourceInfo.isDir() ? destPath : QDir::toNativeSeparators(destInfo.absolutePath());
@@ -314,27 +575,43 @@ bool SyncProcess::updateEntry(const QString & entry, const QDir & source, const
       if (mkPath == lastMkPath) {
         // we've already tried, and apparently failed, to create this folder... bail out but log as error.
         if (!(m_options.flags & OPT_DRY_RUN)) {
-          ++m_stat.errored;
+          ++job->stat.errored;
           return false;
         }
       }
       else {
         lastMkPath = mkPath;
-        PRINT_CREATE(tr("Creating directory: %1").arg(mkPath));
+        ENTRY_CREATE(tr("Creating directory: %1").arg(mkPath));
         if (!(m_options.flags & OPT_DRY_RUN) && !destination.mkpath(mkPath)) {
-          PRINT_ERROR(tr("Could not create directory: %1").arg(mkPath));
-            ++m_stat.errored;
+          ENTRY_ERROR(tr("Could not create directory: %1").arg(mkPath));
+          ++job->stat.errored;
           return false;
         }
       }
     }
     else if (m_dirFilters & QDir::Dirs) {
-      PRINT_SKIP(tr("Directory exists: %1").arg(mkPath));
+      ENTRY_SKIP(tr("Directory exists: %1").arg(mkPath));
     }
     if (sourceInfo.isDir())
-      return true;
+      return false;
+  }
+
+  return true;
+}
+
+// Runs in a worker thread, only touches the job and the (locked) manifests
+void SyncProcess::updateFile(SyncEntry * job)
+{
+  if (isStopRequsted()) {
+    job->cancelled = true;
+    return;
   }
 
+  const QString & srcPath = job->srcPath;
+  const QString & destPath = job->destPath;
+  const QFileInfo sourceInfo(srcPath);
+  const QFileInfo destInfo(destPath);
+
   //qDebug() << destPath;
   QFile sourceFile(srcPath);
   QFile destinationFile(destPath);
@@ -342,71 +619,75 @@ bool SyncProcess::updateEntry(const QString & entry, const QDir & source, const
   bool checkDate = (m_options.compareType == OVERWR_NEWER_IF_DIFF || m_options.compareType == OVERWR_NEWER_ALWAYS);
   bool checkContent = (m_options.compareType == OVERWR_NEWER_IF_DIFF || m_options.compareType == OVERWR_IF_DIFF);
   bool existed = false;
+  QByteArray srcHash;
 
   if (destExists && checkDate) {
     const QDate cmprDate = QDate::currentDate();
     if (sourceInfo.lastModified().date() > cmprDate || destInfo.lastModified().date() > cmprDate) {
-      PRINT_ERROR(tr("At least one of the file modification dates is in the future, error on: %1").arg(srcPath));
-      ++m_stat.errored;
-      return false;
+      ENTRY_ERROR(tr("At least one of the file modification dates is in the future, error on: %1").arg(srcPath));
+      ++job->stat.errored;
+      return;
     }
     if (sourceInfo.lastModified() <= destInfo.lastModified()) {
-      PRINT_SKIP(tr("Skipping older file: %1").arg(srcPath));
-      ++m_stat.skipped;
-      return true;
+      ENTRY_SKIP(tr("Skipping older file: %1").arg(srcPath));
+      ++job->stat.skipped;
+      return;
     }
     checkDate = false;
   }
 
-  if (destExists && checkContent) {
-    if (!sourceFile.open(QFile::ReadOnly)) {
-      PRINT_ERROR(tr("Could not open source file '%1': %2").arg(srcPath, sourceFile.errorString()));
-      ++m_stat.errored;
-      return false;
+  // files of different sizes differ, otherwise compare the hashes (cached in the manifests when the files didn't change)
+  if (destExists && checkContent && sourceInfo.size() == destInfo.size()) {
+    QString error;
+    srcHash = job->srcManifest->hash(sourceInfo, error);
+    if (srcHash.isEmpty()) {
+      ENTRY_ERROR(tr("Could not open source file '%1': %2").arg(srcPath, error));
+      ++job->stat.errored;
+      return;
     }
-    if (!destinationFile.open(QFile::ReadOnly)) {
-      PRINT_ERROR(tr("Could not open destination file '%1': %2").arg(destPath, destinationFile.errorString()));
-      ++m_stat.errored;
-      return false;
+    const QByteArray destHash = job->dstManifest->hash(destInfo, error);
+    if (destHash.isEmpty()) {
+      ENTRY_ERROR(tr("Could not open destination file '%1': %2").arg(destPath, error));
+      ++job->stat.errored;
+      return;
     }
-
-    const bool skip = QCryptographicHash::hash(sourceFile.readAll(), QCryptographicHash::Md5) == QCryptographicHash::hash(destinationFile.readAll(), QCryptographicHash::Md5);
-    sourceFile.close();
-    destinationFile.close();
-    if (skip) {
-      PRINT_SKIP(tr("Skipping identical file: %1").arg(srcPath));
-      ++m_stat.skipped;
-      return true;
+    if (srcHash == destHash) {
+      ENTRY_SKIP(tr("Skipping identical file: %1").arg(srcPath));
+      ++job->stat.skipped;
+      return;
     }
-    checkContent = false;
   }
+  checkContent = false;
 
   if (!destExists || (!checkDate && !checkContent)) {
     if (destInfo.exists()) {
       existed = true;
-      PRINT_REPLACE(tr("Replacing file: %1").arg(destPath));
+      ENTRY_REPLACE(tr("Replacing file: %1").arg(destPath));
       if (!(m_options.flags & OPT_DRY_RUN) && !destinationFile.remove()) {
-        PRINT_ERROR(tr("Could not delete destination file '%1': %2").arg(destPath, destinationFile.errorString()));
-        ++m_stat.errored;
-        return false;
+        ENTRY_ERROR(tr("Could not delete destination file '%1': %2").arg(destPath, destinationFile.errorString()));
+        ++job->stat.errored;
+        return;
       }
     }
     else {
-      PRINT_CREATE(tr("Creating file: %1").arg(destPath));
+      ENTRY_CREATE(tr("Creating file: %1").arg(destPath));
     }
-    if (!(m_options.flags & OPT_DRY_RUN) && !sourceFile.copy(destPath)) {
-      PRINT_ERROR(tr("Copy failed: '%1' to '%2': %3").arg(srcPath, destPath, sourceFile.errorString()));
-      ++m_stat.errored;
-      return false;
+    if (!(m_options.flags & OPT_DRY_RUN)) {
+      if (!sourceFile.copy(destPath)) {
+        ENTRY_ERROR(tr("Copy failed: '%1' to '%2': %3").arg(srcPath, destPath, sourceFile.errorString()));
+        ++job->stat.errored;
+        job->dstManifest->setHash(QFileInfo(destPath), QByteArray());
+        return;
+      }
+      // the copy has the source contents, an unknown hash just drops the stale entry
+      job->dstManifest->setHash(QFileInfo(destPath), srcHash);
     }
 
     if (existed)
-      ++m_stat.updated;
+      ++job->stat.updated;
     else
-      ++m_stat.created;
+      ++job->stat.created;
   }
-
-  return true;
 }
 
 void SyncProcess::pause()
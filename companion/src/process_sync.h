@@ -26,10 +26,46 @@
 #include <QDebug>
 #include <QDir>
 #include <QDirIterator>
+#include <QHash>
+#include <QMutex>
+#include <QQueue>
 #include <QReadWriteLock>
 #include <QRegExp>
+#include <QThreadPool>
 #include <QVector>
 
+// Persistent cache of file sizes, modification times and content hashes of one sync folder,
+// so that files which did not change since the last sync don't have to be read again.
+class SyncManifest
+{
+  public:
+    struct Entry {
+        qint64 size;
+        qint64 modified;   // ms since epoch
+        QByteArray hash;
+        bool used;         // looked up during this run
+    };
+
+    explicit SyncManifest() : m_dirty(false) {}
+
+    void load(const QString & folder);
+    void save(bool prune);
+    inline const QString & folder() const { return m_folder; }
+    // returns an empty array and sets error if the file could not be read
+    QByteArray hash(const QFileInfo & fileInfo, QString & error);
+    // an empty hash removes the entry
+    void setHash(const QFileInfo & fileInfo, const QByteArray & hash);
+
+  protected:
+    QString key(const QFileInfo & fileInfo) const;
+    QString fileName() const;
+
+    QString m_folder;
+    QHash<QString, Entry> m_entries;
+    QMutex m_mutex;
+    bool m_dirty;
+};
+
 class SyncProcess : public QObject
 {
     Q_OBJECT
@@ -121,6 +157,8 @@ class SyncProcess : public QObject
   protected:
     enum FileFilterResult { FILE_ALLOW, FILE_OVERSIZE, FILE_EXCLUDE, FILE_LINK_IGNORE };
 
+    struct SyncEntry;  // one directory entry, compared and copied by a worker thread
+
     bool isStopRequsted();
     void finish();
     FileFilterResult fileFilter(const QFileInfo & fileInfo);
@@ -128,7 +166,10 @@ class SyncProcess : public QObject
     int getFilesCount(const QString & directory);
     void updateDir(const QString & source, const QString & destination);
     void pushDirEntries(const QFileInfo & fi, QMutableListIterator<QFileInfo> &it);
-    bool updateEntry(const QString & entry, const QDir & source, const QDir & destination);
+    bool updateEntry(const QString & entry, const QDir & source, const QDir & destination, SyncEntry * job);
+    void updateFile(SyncEntry * job);
+    bool processEntries(const SyncStatus & pStat, int maxPending);
+    SyncManifest * manifest(const QString & folder);
     void pause();
     void emitProgressMessage(const QString &text, int type);
 
@@ -140,6 +181,10 @@ class SyncProcess : public QObject
     QStringList m_dirIteratorFilters;
     QDir::Filters m_dirFilters;
     QDateTime m_startTime;
+    SyncManifest m_manifestA;
+    SyncManifest m_manifestB;
+    QThreadPool m_pool;
+    QQueue<SyncEntry *> m_entries;
     unsigned long m_pauseTime;
     bool stopping;
 };
@@ -33,6 +33,62 @@
   #define SIMULATOR_INTERFACE_LOADER_DYNAMIC    1  // How to load simulator libraries: 1=dynamic load and unload; 0=load once (old way)
 #endif
 
+void SimulatorInterface::pollOutputs()
+{
+  bool backlightEnable;
+  if (readLcd(backlightEnable))
+    emit lcdChange(backlightEnable);
+
+  TxOutputs outputs;
+  TxOutputsDirty dirty;
+  if (!readOutputs(outputs, dirty))
+    return;
+
+  for (int i=0; i < CPN_MAX_CHNOUT; i++) {
+    if (dirty.test(OUTPUT_SRC_CHAN_OUT, i)) {
+      emit channelOutValueChange(i, outputs.chans[i], outputs.chansLimit);
+      emit outputValueChange(OUTPUT_SRC_CHAN_OUT, i, outputs.chans[i]);
+    }
+    if (dirty.test(OUTPUT_SRC_CHAN_MIX, i)) {
+      emit channelMixValueChange(i, outputs.ex_chans[i], 512 * 2 * 2);
+      emit outputValueChange(OUTPUT_SRC_CHAN_MIX, i, outputs.ex_chans[i]);
+    }
+  }
+
+  for (int i=0; i < CPN_MAX_LOGICAL_SWITCHES; i++) {
+    if (dirty.test(OUTPUT_SRC_VIRTUAL_SW, i)) {
+      emit virtualSwValueChange(i, outputs.vsw[i]);
+      emit outputValueChange(OUTPUT_SRC_VIRTUAL_SW, i, outputs.vsw[i]);
+    }
+  }
+
+  for (int i=0; i < CPN_MAX_TRIMS; i++) {
+    if (dirty.test(OUTPUT_SRC_TRIM_VALUE, i)) {
+      emit trimValueChange(i, outputs.trims[i]);
+      emit outputValueChange(OUTPUT_SRC_TRIM_VALUE, i, outputs.trims[i]);
+    }
+  }
+
+  if (dirty.test(OUTPUT_SRC_TRIM_RANGE, 0)) {
+    emit trimRangeChange(CPN_MAX_TRIMS, -outputs.trimRange, outputs.trimRange);
+    emit outputValueChange(OUTPUT_SRC_TRIM_RANGE, CPN_MAX_TRIMS, outputs.trimRange);
+  }
+
+  if (dirty.test(OUTPUT_SRC_PHASE, 0)) {
+    emit phaseChanged(outputs.phase, QString(outputs.phaseName));
+    emit outputValueChange(OUTPUT_SRC_PHASE, 0, outputs.phase);
+  }
+
+  for (int fm=0; fm < CPN_MAX_FLIGHT_MODES; fm++) {
+    for (int gv=0; gv < CPN_MAX_GVARS; gv++) {
+      if (dirty.test(OUTPUT_SRC_GVAR, fm * CPN_MAX_GVARS + gv)) {
+        emit gVarValueChange(gv, outputs.gvars[fm][gv]);
+        emit outputValueChange(OUTPUT_SRC_GVAR, gv, outputs.gvars[fm][gv]);
+      }
+    }
+  }
+}
+
 QMap<QString, QLibrary *> SimulatorLoader::registeredSimulators;
 
 QStringList SimulatorLoader::getAvailableSimulators()
@@ -35,6 +35,7 @@
 #include <QMap>
 
 #define SIMULATOR_INTERFACE_HEARTBEAT_PERIOD    1000  // ms
+#define SIMULATOR_INTERFACE_POLL_PERIOD         20    // ms, see pollOutputs()
 
 class SimulatorInterface : public QObject
 {
@@ -115,19 +116,45 @@ class SimulatorInterface : public QObject
       bool vsw[CPN_MAX_LOGICAL_SWITCHES];  // virtual/logic switches
       int8_t phase;
       qint16 trimRange;                  // TRIM_MAX or TRIM_EXTENDED_MAX
+      qint32 chansLimit;                 // depends on extended limits
+      char phaseName[16];
       // bool beep;
     };
 
+    // One bit per output changed since the previous readOutputs(), by OutputSourceType
+    //  (OUTPUT_SRC_GVAR index is flight mode * CPN_MAX_GVARS + gvar)
+    struct TxOutputsDirty {
+      enum {
+        MAX_INDEX = CPN_MAX_FLIGHT_MODES * CPN_MAX_GVARS,
+        WORDS = (MAX_INDEX + 31) / 32
+      };
+
+      TxOutputsDirty() { clear(); }
+      void clear() { memset(bits, 0, sizeof(bits)); }
+      void set(int type, int index) { bits[type][index / 32] |= 1u << (index % 32); }
+      bool test(int type, int index) const { return bits[type][index / 32] & (1u << (index % 32)); }
+
+      quint32 bits[OUTPUT_SRC_ENUM_COUNT][WORDS];
+    };
+
     virtual ~SimulatorInterface() {}
 
     virtual QString name() = 0;
     virtual bool isRunning() = 0;
     virtual void readRadioData(QByteArray & dest) = 0;
-    virtual uint8_t * getLcd() = 0;
+    virtual uint8_t * getLcd() = 0;  // the frame copied by the last readLcd()
     virtual uint8_t getSensorInstance(uint16_t id, uint8_t defaultValue = 0) = 0;
     virtual uint16_t getSensorRatio(uint16_t id) = 0;
     virtual const int getCapability(Capability cap) = 0;
 
+    // The simulator publishes its outputs and LCD frames in lock-free snapshots, these can be
+    // called from any thread (and only one) to read the latest ones, they return false if nothing changed
+    virtual bool readOutputs(TxOutputs & outputs, TxOutputsDirty & dirty) = 0;
+    virtual bool readLcd(bool & backlightEnable) = 0;
+
+    // To be called every SIMULATOR_INTERFACE_POLL_PERIOD from the UI thread, emits the change signals below from there
+    void pollOutputs();
+
   public slots:
 
     virtual void init() = 0;
@@ -81,6 +81,11 @@ SimulatorMainWindow::SimulatorMainWindow(QWidget *parent, const QString & firmwa
   m_simulator->moveToThread(&simuThread);
   simuThread.start();
 
+  // the lambda makes sure the outputs signals are emitted from this thread, widgets get them as direct calls
+  m_pollTimer.setInterval(SIMULATOR_INTERFACE_POLL_PERIOD);
+  connect(&m_pollTimer, &QTimer::timeout, this, [this]() { m_simulator->pollOutputs(); });
+  m_pollTimer.start();
+
   ui->setupUi(this);
 
   setCorner(Qt::TopLeftCorner, Qt::LeftDockWidgetArea);
@@ -153,6 +158,7 @@ SimulatorMainWindow::SimulatorMainWindow(QWidget *parent, const QString & firmwa
 
 SimulatorMainWindow::~SimulatorMainWindow()
 {
+  m_pollTimer.stop();
   if (m_telemetryDockWidget)
     delete m_telemetryDockWidget;
   if (m_trainerDockWidget)
@@ -27,6 +27,7 @@
 #include <QFile>
 #include <QMainWindow>
 #include <QThread>
+#include <QTimer>
 
 class DebugOutput;
 class RadioData;
@@ -100,6 +101,7 @@ class SimulatorMainWindow : public QMainWindow
     QDockWidget * m_outputsDockWidget;
 
     QThread simuThread;
+    QTimer m_pollTimer;  // reads the simulator outputs and LCD from the UI thread
     QFile m_simuLogFile;
     QVector<keymapHelp_t> m_keymapHelp;
     QString m_simulatorId;
@@ -21,6 +21,25 @@
 #include "categorized.h"
 #include "firmwares/opentx/opentxinterface.h"
 
+#include <functional>
+
+class CategorizedModelLoader : public QRunnable
+{
+  public:
+    explicit CategorizedModelLoader(const std::function<void()> & task):
+      task(task)
+    {
+    }
+
+    virtual void run()
+    {
+      task();
+    }
+
+  protected:
+    std::function<void()> task;
+};
+
 bool CategorizedStorageFormat::load(RadioData & radioData)
 {
   QByteArray radioSettingsBuffer;
@@ -42,6 +61,16 @@ bool CategorizedStorageFormat::load(RadioData & radioData)
     return false;
   }
 
+  // parse the list first, the model files are then extracted together and decoded in parallel
+  struct ModelEntry {
+    QString fileName;
+    int modelIndex;
+    int categoryIndex;
+    bool loaded;
+  };
+  QVector<ModelEntry> entries;
+  QStringList fileNames;
+
   QList<QByteArray> lines = modelsListBuffer.split('\n');
   int modelIndex = 0;
   int categoryIndex = -1;
@@ -77,30 +106,14 @@ bool CategorizedStorageFormat::load(RadioData & radioData)
       parts.removeFirst();
     }
     if (parts.size() == 1) {
-      // parse model file name and load
-      QString fileName = parts[0];
-      qDebug() << "Loading model from file" << fileName << "into slot" << modelIndex;
-      QByteArray modelBuffer;
-      if (!loadFile(modelBuffer, QString("MODELS/%1").arg(fileName))) {
-        setError(tr("Can't extract %1").arg(fileName));
-        return false;
-      }
-      if ((int)radioData.models.size() <= modelIndex) {
-        radioData.models.resize(modelIndex + 1);
-      }
-      if (!loadModelFromByteArray(radioData.models[modelIndex], modelBuffer)) {
-        setError(tr("Error loading models"));
-        return false;
-      }
-      strncpy(radioData.models[modelIndex].filename, qPrintable(fileName), sizeof(radioData.models[modelIndex].filename));
-      if (IS_HORUS(board) && !strcmp(radioData.generalSettings.currModelFilename, qPrintable(fileName))) {
-        radioData.generalSettings.currModelIndex = modelIndex;
-        qDebug() << "currModelIndex =" << modelIndex;
-      }
-      if (getCurrentFirmware()->getCapability(HasModelCategories)) {
-        radioData.models[modelIndex].category = categoryIndex;
-      }
-      radioData.models[modelIndex].used = true;
+      // parse model file name
+      ModelEntry entry;
+      entry.fileName = parts[0];
+      entry.modelIndex = modelIndex;
+      entry.categoryIndex = categoryIndex;
+      entry.loaded = false;
+      entries.append(entry);
+      fileNames.append(QString("MODELS/%1").arg(entry.fileName));
       modelIndex++;
       continue;
     }
@@ -110,9 +123,67 @@ bool CategorizedStorageFormat::load(RadioData & radioData)
     qDebug() << "Invalid line" <<line;
     continue;
   }
+
+  QHash<QString, QByteArray> modelBuffers;
+  loadFiles(modelBuffers, fileNames);
+
+  // model indexes only increase, so the last one sizes the models list
+  if (!entries.isEmpty() && (int)radioData.models.size() <= entries.last().modelIndex) {
+    radioData.models.resize(entries.last().modelIndex + 1);
+  }
+
+  // each task decodes into its own slot, the list is not resized anymore
+  QThreadPool pool;
+  for (int i = 0; i < entries.size(); i++) {
+    QHash<QString, QByteArray>::const_iterator buffer = modelBuffers.constFind(fileNames[i]);
+    if (buffer == modelBuffers.constEnd())
+      continue;
+    ModelEntry * entry = &entries[i];
+    ModelData * model = &radioData.models[entry->modelIndex];
+    const QByteArray * modelBuffer = &buffer.value();
+    qDebug() << "Loading model from file" << entry->fileName << "into slot" << entry->modelIndex;
+    pool.start(new CategorizedModelLoader([entry, model, modelBuffer]() {
+      entry->loaded = (loadModelFromByteArray(*model, *modelBuffer) != nullptr);
+    }));
+  }
+  pool.waitForDone();
+
+  // report in the list order, as a serial load would
+  foreach (const ModelEntry & entry, entries) {
+    if (!modelBuffers.contains(QString("MODELS/%1").arg(entry.fileName))) {
+      setError(tr("Can't extract %1").arg(entry.fileName));
+      return false;
+    }
+    if (!entry.loaded) {
+      setError(tr("Error loading models"));
+      return false;
+    }
+    ModelData & model = radioData.models[entry.modelIndex];
+    strncpy(model.filename, qPrintable(entry.fileName), sizeof(model.filename));
+    if (IS_HORUS(board) && !strcmp(radioData.generalSettings.currModelFilename, qPrintable(entry.fileName))) {
+      radioData.generalSettings.currModelIndex = entry.modelIndex;
+      qDebug() << "currModelIndex =" << entry.modelIndex;
+    }
+    if (getCurrentFirmware()->getCapability(HasModelCategories)) {
+      model.category = entry.categoryIndex;
+    }
+    model.used = true;
+  }
   return true;
 }
 
+void CategorizedStorageFormat::loadFiles(QHash<QString, QByteArray> & filesData, const QStringList & fileNames)
+{
+  foreach (const QString & fileName, fileNames) {
+    QByteArray fileData;
+    if (!loadFile(fileData, fileName)) {
+      // a serial load stops at the first missing file
+      break;
+    }
+    filesData.insert(fileName, fileData);
+  }
+}
+
 bool CategorizedStorageFormat::write(const RadioData & radioData)
 {
   QByteArray modelsList;   // models.txt
@@ -40,6 +40,8 @@ class CategorizedStorageFormat : public StorageFormat
 
   protected:
     virtual bool loadFile(QByteArray & fileData, const QString & fileName) = 0;
+    // files which could not be read are left out of filesData
+    virtual void loadFiles(QHash<QString, QByteArray> & filesData, const QStringList & fileNames);
     virtual bool writeFile(const QByteArray & fileData, const QString & fileName) = 0;
 };
 
@@ -105,6 +105,38 @@ bool OtxFormat::loadFile(QByteArray & filedata, const QString & filename)
   return true;
 }
 
+void OtxFormat::loadFiles(QHash<QString, QByteArray> & filesData, const QStringList & fileNames)
+{
+  // one pass over the central directory instead of locating every file, names compare case-insensitively like mz_zip_reader_locate_file()
+  QHash<QString, QStringList> wanted;
+  foreach (const QString & fileName, fileNames) {
+    wanted[fileName.toLower()].append(fileName);
+  }
+
+  const mz_uint count = mz_zip_reader_get_num_files(&zip_archive);
+  for (mz_uint i = 0; i < count && !wanted.isEmpty(); i++) {
+    char name[MZ_ZIP_MAX_ARCHIVE_FILENAME_SIZE];
+    if (!mz_zip_reader_get_filename(&zip_archive, i, name, sizeof(name)) || mz_zip_reader_is_file_a_directory(&zip_archive, i)) {
+      continue;
+    }
+    QHash<QString, QStringList>::iterator it = wanted.find(QString(name).toLower());
+    if (it == wanted.end()) {
+      continue;
+    }
+    size_t size;
+    void * data = mz_zip_reader_extract_to_heap(&zip_archive, i, &size, 0);
+    if (data) {
+      qDebug() << QString("Extracted file %1, size=%2").arg(it.value().first()).arg(size);
+      const QByteArray fileData((char *)data, size);
+      foreach (const QString & fileName, it.value()) {
+        filesData.insert(fileName, fileData);
+      }
+      mz_free(data);
+    }
+    wanted.erase(it);
+  }
+}
+
 bool OtxFormat::writeFile(const QByteArray & filedata, const QString & filename)
 {
   if (!mz_zip_writer_add_mem(&zip_archive, filename.toStdString().c_str(), filedata.data(), filedata.size(), MZ_DEFAULT_LEVEL)) {
@@ -45,6 +45,7 @@ class OtxFormat : public CategorizedStorageFormat
 
   protected:
     virtual bool loadFile(QByteArray & fileData, const QString & fileName);
+    virtual void loadFiles(QHash<QString, QByteArray> & filesData, const QStringList & fileNames);
     virtual bool writeFile(const QByteArray & fileData, const QString & fileName);
 
     mz_zip_archive zip_archive;
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "firmwares/eepromimportexport.h"
+
+// Fields of odd sizes, as in the radio structs: no alignment, spare fields wider than 64 bits
+class TestStruct: public StructField {
+  public:
+    TestStruct():
+      StructField(NULL, "Test")
+    {
+      memset(name, 0, sizeof(name));
+      memset(zname, 0, sizeof(zname));
+      Append(new UnsignedField<3>(this, u3));
+      Append(new SignedField<5>(this, s5));
+      Append(new BoolField<1>(this, flag));
+      Append(new UnsignedField<11>(this, u11));
+      Append(new SpareBitsField<7>(this));
+      Append(new CharField<3>(this, name, false));
+      Append(new ZCharField<4>(this, zname));
+      Append(new SignedField<16>(this, s16));
+      Append(new UnsignedField<32>(this, u32));
+      Append(new SpareBitsField<70>(this));
+      Append(new BoolField<1>(this, last));
+      Append(new UnsignedField<2>(this, u2));
+    }
+
+    unsigned int u3 = 0;
+    int s5 = 0;
+    bool flag = false;
+    unsigned int u11 = 0;
+    char name[3];
+    char zname[4 + 1];
+    int s16 = 0;
+    unsigned int u32 = 0;
+    bool last = false;
+    unsigned int u2 = 0;
+};
+
+TEST(EepromImportExport, layout)
+{
+  unsigned int u3 = 5, u7 = 0x55;
+  int s5 = -3;
+  bool flag = true;
+  StructField data(NULL);
+  data.Append(new UnsignedField<3>(&data, u3));
+  data.Append(new SignedField<5>(&data, s5));
+  data.Append(new BoolField<1>(&data, flag));
+  data.Append(new UnsignedField<7>(&data, u7));
+
+  // the first field in the lowest bits
+  QByteArray bytes;
+  data.Export(bytes);
+  ASSERT_EQ(2, bytes.size());
+  EXPECT_EQ(0xED, (uint8_t)bytes[0]);
+  EXPECT_EQ(0xAB, (uint8_t)bytes[1]);
+}
+
+TEST(EepromImportExport, roundTrip)
+{
+  for (int i = 0; i < 100; i++) {
+    TestStruct source;
+    source.u3 = rand() & 0x07;
+    source.s5 = (rand() & 0x1F) - 0x10;
+    source.flag = rand() & 1;
+    source.u11 = rand() & 0x7FF;
+    for (unsigned int j = 0; j < sizeof(source.name); j++) {
+      source.name[j] = 'a' + rand() % 26;
+    }
+    strcpy(source.zname, i & 1 ? "Ab1" : "Z_9.");
+    source.s16 = (rand() & 0xFFFF) - 0x8000;
+    source.u32 = rand() ^ ((unsigned int)rand() << 16);
+    source.last = rand() & 1;
+    source.u2 = rand() & 0x03;
+
+    QByteArray exported;
+    source.Export(exported);
+    EXPECT_EQ((int)(source.size() + 7) / 8, exported.size());
+
+    TestStruct imported;
+    ASSERT_EQ(0, imported.Import(exported));
+    EXPECT_EQ(source.u3, imported.u3);
+    EXPECT_EQ(source.s5, imported.s5);
+    EXPECT_EQ(source.flag, imported.flag);
+    EXPECT_EQ(source.u11, imported.u11);
+    EXPECT_EQ(0, memcmp(source.name, imported.name, sizeof(source.name)));
+    EXPECT_STREQ(source.zname, imported.zname);
+    EXPECT_EQ(source.s16, imported.s16);
+    EXPECT_EQ(source.u32, imported.u32);
+    EXPECT_EQ(source.last, imported.last);
+    EXPECT_EQ(source.u2, imported.u2);
+
+    // export -> import -> export gives the same bytes
+    QByteArray reexported;
+    imported.Export(reexported);
+    EXPECT_EQ(exported, reexported);
+  }
+}
+
+TEST(EepromImportExport, tooSmall)
+{
+  TestStruct data;
+  QByteArray bytes((data.size() + 7) / 8 - 1, 0);
+  EXPECT_EQ(-1, data.Import(bytes));
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <QFile>
+#include "eeprominterface.h"
+#include "opentxeeprom.h"
+
+// The fixtures were exported by the QBitArray implementation of eepromimportexport, X7 board, version 218
+#define FIXTURES_BOARD    Board::BOARD_TARANIS_X7
+#define FIXTURES_VERSION  218
+
+static QByteArray readFixture(const char * name)
+{
+  QFile file(QString(FIXTURES_DIR "/opentx-x7-218-%1.bin").arg(name));
+  if (!file.open(QIODevice::ReadOnly))
+    return QByteArray();
+  return file.readAll();
+}
+
+static void setFixturesFirmware()
+{
+  static bool registered = false;
+  if (!registered) {
+    registerOpenTxFirmwares();
+    registered = true;
+  }
+  // the data models read the current firmware
+  Firmware::setCurrentVariant(Firmware::getFirmwareForId("opentx-x7"));
+}
+
+// A few values in each part of the structs, the fixtures must be exported again if they are changed
+static void fillGeneralSettings(GeneralSettings & settings)
+{
+  // the constructor reads the companion profile, the fixture starts from zeroes
+  memset(reinterpret_cast<void *>(&settings), 0, sizeof(GeneralSettings));
+  settings.setDefaultControlTypes(FIXTURES_BOARD);
+  for (int i = 0; i < 6; i++) {
+    settings.calibMid[i] = 0x200 + i;
+    settings.calibSpanNeg[i] = 0x180 - i;
+    settings.calibSpanPos[i] = 0x180 + 2 * i;
+  }
+  settings.currModelIndex = 3;
+  settings.contrast = 25;
+  settings.vBatWarn = 65;
+  settings.vBatMin = -30;
+  settings.vBatMax = -40;
+  settings.backlightMode = 3;
+  settings.trainer.calib[1] = -12;
+  settings.trainer.mix[2].src = 2;
+  settings.trainer.mix[2].weight = -50;
+  settings.trainer.mix[2].mode = 1;
+  settings.beeperMode = GeneralSettings::BEEPER_QUIET;
+  settings.hapticMode = GeneralSettings::BEEPER_ALL;
+  settings.stickMode = 1;
+  settings.timezone = -5;
+  settings.inactivityTimer = 10;
+  settings.templateSetup = 4;
+  settings.speakerVolume = 12;
+  strcpy(settings.bluetoothName, "Taranis");
+}
+
+static void fillModelData(ModelData & model)
+{
+  model.clear();
+  strcpy(model.name, "Golden");
+  model.timers[0].mode = RawSwitch(SWITCH_TYPE_TIMER_MODE, 1);
+  model.timers[0].val = 300;
+  model.timers[0].countdownBeep = TimerData::COUNTDOWN_VOICE;
+  strcpy(model.timers[0].name, "Flt");
+  model.thrTrim = true;
+  model.extendedLimits = true;
+
+  strcpy(model.flightModeData[1].name, "Land");
+  model.flightModeData[1].swtch = RawSwitch(SWITCH_TYPE_SWITCH, 2);
+  model.flightModeData[1].trim[0] = -25;
+  model.flightModeData[1].fadeIn = 10;
+
+  for (int i = 0; i < 4; i++) {
+    ExpoData & expo = model.expoData[i];
+    expo.srcRaw = RawSource(SOURCE_TYPE_STICK, i);
+    expo.chn = i;
+    expo.mode = INPUT_MODE_BOTH;
+    expo.weight = 100 - 10 * i;
+    strcpy(model.inputNames[i], "In");
+    MixData & mix = model.mixData[i];
+    mix.destCh = i + 1;
+    mix.srcRaw = RawSource(SOURCE_TYPE_VIRTUAL_INPUT, i);
+    mix.weight = 100 - i;
+    mix.sOffset = i;
+    mix.speedUp = 2 * i;
+  }
+  model.mixData[4].destCh = 5;
+  model.mixData[4].srcRaw = RawSource(SOURCE_TYPE_SWITCH, 1);
+  model.mixData[4].swtch = RawSwitch(SWITCH_TYPE_VIRTUAL, 1);
+  model.mixData[4].mltpx = MLTPX_REP;
+  strcpy(model.mixData[4].name, "Gear");
+
+  model.limitData[0].min = -200;
+  model.limitData[0].max = 150;
+  model.limitData[0].offset = 12;
+  model.limitData[1].revert = true;
+  model.limitData[2].ppmCenter = 15;
+  strcpy(model.limitData[3].name, "Rud");
+
+  model.curves[0].type = CurveData::CURVE_TYPE_STANDARD;
+  model.curves[0].count = 5;
+  for (int i = 0; i < 5; i++) {
+    model.curves[0].points[i].y = -100 + 50 * i;
+  }
+  strcpy(model.curves[0].name, "Lin");
+
+  model.logicalSw[0].func = LS_FN_VPOS;
+  model.logicalSw[0].val1 = RawSource(SOURCE_TYPE_STICK, 2).toValue();
+  model.logicalSw[0].val2 = -20;
+  model.logicalSw[0].delay = 5;
+
+  model.customFn[0].swtch = RawSwitch(SWITCH_TYPE_VIRTUAL, 1);
+  model.customFn[0].func = FuncOverrideCH1;
+  model.customFn[0].param = 50;
+  model.customFn[0].enabled = 1;
+
+  strcpy(model.gvarData[0].name, "Rate");
+  model.gvarData[0].min = -50;
+  model.gvarData[0].max = 50;
+  model.flightModeData[0].gvars[0] = 25;
+
+  model.moduleData[0].protocol = PULSES_PXX_XJT_D8;
+  model.moduleData[0].channelsCount = 8;
+  model.moduleData[0].modelId = 7;
+}
+
+TEST(OpenTxFixtures, generalExport)
+{
+  setFixturesFirmware();
+  QByteArray fixture = readFixture("general");
+  ASSERT_FALSE(fixture.isEmpty());
+
+  alignas(GeneralSettings) static char buffer[sizeof(GeneralSettings)];
+  GeneralSettings & settings = *reinterpret_cast<GeneralSettings *>(buffer);
+  fillGeneralSettings(settings);
+  OpenTxGeneralData generalData(settings, FIXTURES_BOARD, FIXTURES_VERSION, 0);
+  QByteArray exported;
+  generalData.Export(exported);
+  EXPECT_EQ(fixture, exported);
+}
+
+TEST(OpenTxFixtures, modelExport)
+{
+  setFixturesFirmware();
+  QByteArray fixture = readFixture("model");
+  ASSERT_FALSE(fixture.isEmpty());
+
+  static ModelData model;
+  fillModelData(model);
+  OpenTxModelData modelData(model, FIXTURES_BOARD, FIXTURES_VERSION, 0);
+  QByteArray exported;
+  modelData.Export(exported);
+  EXPECT_EQ(fixture, exported);
+}
+
+TEST(OpenTxFixtures, modelImport)
+{
+  setFixturesFirmware();
+  QByteArray fixture = readFixture("model");
+  ASSERT_FALSE(fixture.isEmpty());
+
+  // fixture -> import -> export gives the same bytes
+  static ModelData model;
+  model.clear();
+  OpenTxModelData modelData(model, FIXTURES_BOARD, FIXTURES_VERSION, 0);
+  ASSERT_EQ(0, modelData.Import(fixture));
+  QByteArray exported;
+  modelData.Export(exported);
+  EXPECT_EQ(fixture, exported);
+  EXPECT_STREQ("Golden", model.name);
+  EXPECT_EQ(-25, model.flightModeData[1].trim[0]);
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _ANALOGS_FILTER_H_
+#define _ANALOGS_FILTER_H_
+
+#include <inttypes.h>
+
+/*
+ * The ADC drivers convert all analogs continuously into a ring of ADC_FILTER_DEPTH
+ * sample sets (circular DMA), adcRead() only runs this filter stage on the ring:
+ *   - median of ADC_FILTER_MEDIAN consecutive samples (1 = none, 3 or 5), against spikes
+ *   - average of ADC_FILTER_OVERSAMPLING medians (decimation), against noise
+ * The jitter filter then runs in getADC() on the result.
+ * Boards may override both values in board.h.
+ */
+
+#if !defined(ADC_FILTER_MEDIAN)
+  #define ADC_FILTER_MEDIAN            1
+#endif
+
+#if !defined(ADC_FILTER_OVERSAMPLING)
+  #define ADC_FILTER_OVERSAMPLING      4
+#endif
+
+#define ADC_FILTER_DEPTH               (ADC_FILTER_MEDIAN * ADC_FILTER_OVERSAMPLING)
+
+#if ADC_FILTER_MEDIAN != 1 && ADC_FILTER_MEDIAN != 3 && ADC_FILTER_MEDIAN != 5
+  #error "ADC_FILTER_MEDIAN must be 1, 3 or 5"
+#endif
+
+inline uint16_t median3(uint16_t a, uint16_t b, uint16_t c)
+{
+  if (a > b) {
+    uint16_t tmp = a; a = b; b = tmp;
+  }
+  // a <= b
+  if (c <= a)
+    return a;
+  if (c >= b)
+    return b;
+  return c;
+}
+
+inline uint16_t median5(uint16_t a, uint16_t b, uint16_t c, uint16_t d, uint16_t e)
+{
+  uint16_t values[5] = { a, b, c, d, e };
+  for (unsigned i = 1; i < 5; i++) {
+    uint16_t value = values[i];
+    unsigned j = i;
+    for (; j > 0 && values[j - 1] > value; j--) {
+      values[j] = values[j - 1];
+    }
+    values[j] = value;
+  }
+  return values[2];
+}
+
+// Filters one channel of the ring: samples points to its first sample, stride is the size of a sample set
+inline uint16_t adcFilterChannel(const uint16_t * samples, unsigned stride, unsigned median, unsigned oversampling)
+{
+  uint32_t sum = 0;
+
+  for (unsigned i = 0; i < oversampling; i++, samples += median * stride) {
+    if (median == 5)
+      sum += median5(samples[0], samples[stride], samples[2 * stride], samples[3 * stride], samples[4 * stride]);
+    else if (median == 3)
+      sum += median3(samples[0], samples[stride], samples[2 * stride]);
+    else
+      sum += samples[0];
+  }
+
+  return (sum + oversampling / 2) / oversampling;
+}
+
+// Jitter filter step (see getADC() for the explanation): filtered holds alpha times the output,
+// small changes go through a moving average, changes of threshold or more go through unfiltered
+inline uint16_t jitterFilter(uint16_t filtered, uint16_t value, uint16_t alpha, uint16_t threshold)
+{
+  uint16_t previous = filtered / alpha;
+  uint16_t diff = (value > previous) ? (value - previous) : (previous - value);
+  if (diff < threshold)
+    return (filtered - previous) + value;
+  else
+    return value * alpha;
+}
+
+#endif // _ANALOGS_FILTER_H_
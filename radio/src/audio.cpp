@@ -19,7 +19,9 @@
  */
 
 #include "opentx.h"
+#include "audio_kernels.h"
 #include <math.h>
+#include <ctype.h>
 
 extern RTOS_MUTEX_HANDLE audioMutex;
 
@@ -354,6 +356,101 @@ void getLogicalSwitchAudioFile(char * filename, int index, unsigned int event)
   strcat(str, SOUNDS_EXT);
 }
 
+/*
+ The names of the model audio files which can be played (flight modes, switches and logical
+ switches) are hashed once into a table, so that each file of the model sounds directory is
+ resolved with one lookup. The result is cached for the last models, and is reused as long
+ as the flight modes names don't change. FAT doesn't update the timestamp of a directory when
+ its files change, so the cache is emptied each time the SD card is mounted again (USB mass
+ storage session, card swap) instead.
+ */
+
+#define MODEL_AUDIO_FLIGHTMODE_FILES   (MAX_FLIGHT_MODES * 2)
+#define MODEL_AUDIO_SWITCH_FILES       (SWSRC_LAST_SWITCH + NUM_XPOTS * XPOTS_MULTIPOS_COUNT)
+#define MODEL_AUDIO_LS_FILES           (MAX_LOGICAL_SWITCHES * 2)
+#define MODEL_AUDIO_FILES              (MODEL_AUDIO_FLIGHTMODE_FILES + MODEL_AUDIO_SWITCH_FILES + MODEL_AUDIO_LS_FILES)
+#define MODEL_AUDIO_HASH_SIZE          512  // power of 2, at least twice the number of files
+#define MODEL_AUDIO_CACHE_SIZE         4
+
+static_assert(MODEL_AUDIO_HASH_SIZE >= 2 * MODEL_AUDIO_FILES, "MODEL_AUDIO_HASH_SIZE too small");
+
+struct ModelAudioFiles {
+  uint32_t key;  // hash of the directory and of the flight modes names, 0 = unused
+  BitField<MODEL_AUDIO_FLIGHTMODE_FILES> flightModes;
+  BitField<MODEL_AUDIO_SWITCH_FILES> switches;
+  BitField<MODEL_AUDIO_LS_FILES> logicalSwitches;
+};
+
+static ModelAudioFiles modelAudioFilesCache[MODEL_AUDIO_CACHE_SIZE];
+static uint8_t modelAudioFilesCacheNext;
+
+// each slot is (hash >> 16) << 16 | (file index + 1), 0 = empty
+static uint32_t modelAudioHashTable[MODEL_AUDIO_HASH_SIZE];
+
+// FNV-1a of the lower case name
+static uint32_t hashAudioFilename(const char * name, uint32_t hash = 2166136261u)
+{
+  while (*name) {
+    hash = (hash ^ (uint8_t)tolower(*name++)) * 16777619u;
+  }
+  return hash;
+}
+
+// writes the full path of the model audio file index
+static void getModelAudioFile(char * path, unsigned int index)
+{
+  if (index < MODEL_AUDIO_FLIGHTMODE_FILES) {
+    getFlightmodeAudioFile(path, index / 2, index % 2);
+    return;
+  }
+  index -= MODEL_AUDIO_FLIGHTMODE_FILES;
+  if (index < MODEL_AUDIO_SWITCH_FILES) {
+    getSwitchAudioFile(path, SWSRC_FIRST_SWITCH + index);
+    return;
+  }
+  index -= MODEL_AUDIO_SWITCH_FILES;
+  getLogicalSwitchAudioFile(path, index / 2, index % 2);
+}
+
+// the files are inserted in the order in which they were searched, the first one wins
+static void buildModelAudioHashTable(char * path, const char * filename)
+{
+  memclear(modelAudioHashTable, sizeof(modelAudioHashTable));
+  for (unsigned int index = 0; index < MODEL_AUDIO_FILES; index++) {
+    getModelAudioFile(path, index);
+    uint32_t hash = hashAudioFilename(filename);
+    unsigned int slot = hash & (MODEL_AUDIO_HASH_SIZE - 1);
+    while (modelAudioHashTable[slot]) {
+      slot = (slot + 1) & (MODEL_AUDIO_HASH_SIZE - 1);
+    }
+    modelAudioHashTable[slot] = (hash & 0xFFFF0000) | (index + 1);
+  }
+}
+
+// returns the index of the model audio file, -1 if none
+static int findModelAudioFile(char * path, const char * filename, const char * name)
+{
+  uint32_t hash = hashAudioFilename(name);
+  for (unsigned int slot = hash & (MODEL_AUDIO_HASH_SIZE - 1); modelAudioHashTable[slot]; slot = (slot + 1) & (MODEL_AUDIO_HASH_SIZE - 1)) {
+    uint32_t entry = modelAudioHashTable[slot];
+    if ((entry & 0xFFFF0000) == (hash & 0xFFFF0000)) {
+      unsigned int index = (entry & 0xFFFF) - 1;
+      getModelAudioFile(path, index);
+      if (!strcasecmp(filename, name)) {
+        return index;
+      }
+    }
+  }
+  return -1;
+}
+
+void invalidateModelAudioFiles()
+{
+  for (unsigned int i=0; i<MODEL_AUDIO_CACHE_SIZE; i++) {
+    modelAudioFilesCache[i].key = 0;
+  }
+}
+
 void referenceModelAudioFiles()
 {
   char path[AUDIO_FILENAME_MAXLEN+1];
@@ -367,58 +464,67 @@ void referenceModelAudioFiles()
   char * filename = getModelAudioPath(path);
   *(filename-1) = '\0';
 
+  // the flight modes names are part of the file names
+  uint32_t key = hashAudioFilename(path);
+  for (int i=0; i<MAX_FLIGHT_MODES; i++) {
+    getFlightmodeAudioFile(path, i, 0);
+    key = hashAudioFilename(filename, key);
+  }
+  key |= 1;
+
+  for (unsigned int i=0; i<MODEL_AUDIO_CACHE_SIZE; i++) {
+    if (modelAudioFilesCache[i].key == key) {
+      TRACE("referenceModelAudioFiles(): cached");
+      sdAvailableFlightmodeAudioFiles = modelAudioFilesCache[i].flightModes;
+      sdAvailableSwitchAudioFiles = modelAudioFilesCache[i].switches;
+      sdAvailableLogicalSwitchAudioFiles = modelAudioFilesCache[i].logicalSwitches;
+      return;
+    }
+  }
+
+  buildModelAudioHashTable(path, filename);
+
+  getModelAudioPath(path);
+  *(filename-1) = '\0';
+
   FRESULT res = f_opendir(&dir, path);        /* Open the directory */
   if (res == FR_OK) {
     for (;;) {
       res = f_readdir(&dir, &fno);                   /* Read a directory item */
       if (res != FR_OK || fno.fname[0] == 0) break;  /* Break on error or end of dir */
       uint8_t len = strlen(fno.fname);
-      bool found = false;
 
       // Eliminates directories / non wav files
       if (len < 5 || strcasecmp(fno.fname+len-4, SOUNDS_EXT) || (fno.fattrib & AM_DIR)) continue;
       TRACE("referenceModelAudioFiles(): using file: %s", fno.fname);
 
-      // Flight modes Audio Files <flightmodename>-[on|off].wav
-      for (int i=0; i<MAX_FLIGHT_MODES && !found; i++) {
-        for (int event=0; event<2; event++) {
-          getFlightmodeAudioFile(path, i, event);
-          // TRACE("referenceModelAudioFiles(): searching for %s in %s", filename, fno.fname);
-          if (!strcasecmp(filename, fno.fname)) {
-            sdAvailableFlightmodeAudioFiles.setBit(INDEX_PHASE_AUDIO_FILE(i, event));
-            found = true;
-            TRACE("\tfound: %s", filename);
-            break;
-          }
-        }
-      }
+      int index = findModelAudioFile(path, filename, fno.fname);
+      if (index < 0) continue;
+      TRACE("\tfound: %s", filename);
 
-      // Switches Audio Files <switchname>-[up|mid|down].wav
-      for (int i=SWSRC_FIRST_SWITCH; i<=SWSRC_LAST_SWITCH+NUM_XPOTS*XPOTS_MULTIPOS_COUNT && !found; i++) {
-        getSwitchAudioFile(path, i);
-        // TRACE("referenceModelAudioFiles(): searching for %s in %s (%d)", path, fno.fname, i);
-        if (!strcasecmp(filename, fno.fname)) {
-          sdAvailableSwitchAudioFiles.setBit(i-SWSRC_FIRST_SWITCH);
-          found = true;
-          TRACE("\tfound: %s", filename);
-        }
+      if (index < MODEL_AUDIO_FLIGHTMODE_FILES) {
+        // Flight modes Audio Files <flightmodename>-[on|off].wav
+        sdAvailableFlightmodeAudioFiles.setBit(index);
       }
-
-      // Logical Switches Audio Files <switchname>-[on|off].wav
-      for (int i=0; i<MAX_LOGICAL_SWITCHES && !found; i++) {
-        for (int event=0; event<2; event++) {
-          getLogicalSwitchAudioFile(path, i, event);
-          // TRACE("referenceModelAudioFiles(): searching for %s in %s", filename, fno.fname);
-          if (!strcasecmp(filename, fno.fname)) {
-            sdAvailableLogicalSwitchAudioFiles.setBit(INDEX_LOGICAL_SWITCH_AUDIO_FILE(i, event));
-            found = true;
-            TRACE("\tfound: %s", filename);
-            break;
-          }
-        }
+      else if (index < MODEL_AUDIO_FLIGHTMODE_FILES + MODEL_AUDIO_SWITCH_FILES) {
+        // Switches Audio Files <switchname>-[up|mid|down].wav
+        sdAvailableSwitchAudioFiles.setBit(index - MODEL_AUDIO_FLIGHTMODE_FILES);
+      }
+      else {
+        // Logical Switches Audio Files <switchname>-[on|off].wav
+        sdAvailableLogicalSwitchAudioFiles.setBit(index - MODEL_AUDIO_FLIGHTMODE_FILES - MODEL_AUDIO_SWITCH_FILES);
       }
     }
     f_closedir(&dir);
+
+    if (res == FR_OK) {
+      ModelAudioFiles * cache = &modelAudioFilesCache[modelAudioFilesCacheNext];
+      modelAudioFilesCacheNext = (modelAudioFilesCacheNext + 1) % MODEL_AUDIO_CACHE_SIZE;
+      cache->key = key;
+      cache->flightModes = sdAvailableFlightmodeAudioFiles;
+      cache->switches = sdAvailableSwitchAudioFiles;
+      cache->logicalSwitches = sdAvailableLogicalSwitchAudioFiles;
+    }
   }
 }
 
@@ -750,9 +856,7 @@ void AudioQueue::wakeup()
     int size = 0;
 
     // write silence in the buffer
-    for (uint32_t i=0; i<AUDIO_BUFFER_SIZE; i++) {
-      buffer->data[i] = AUDIO_DATA_SILENCE; /* silence */
-    }
+    audioFill((uint16_t *)buffer->data, AUDIO_BUFFER_SIZE, AUDIO_DATA_SILENCE);
 
     // mix the priority context (only tones)
     result = priorityContext.mixBuffer(buffer, g_eeGeneral.beepVolume, fade);
@@ -795,9 +899,8 @@ void AudioQueue::wakeup()
 
 #if defined(SOFTWARE_VOLUME)
       if (currentSpeakerVolume > 0) {
-        for (uint32_t i=0; i<buffer->size; ++i) {
-          int32_t tmpSample = (int32_t) ((uint32_t) (buffer->data[i]) - AUDIO_DATA_SILENCE);  // conversion from uint16_t
-          buffer->data[i] = (int16_t) (((tmpSample * currentSpeakerVolume) / VOLUME_LEVEL_MAX) + AUDIO_DATA_SILENCE);
+        if (currentSpeakerVolume < VOLUME_LEVEL_MAX) {
+          audioApplyGain((uint16_t *)buffer->data, buffer->size, AUDIO_DATA_SILENCE, (currentSpeakerVolume * AUDIO_GAIN_UNIT) / VOLUME_LEVEL_MAX);
         }
         buffersFifo.audioPushBuffer();
       }
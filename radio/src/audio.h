@@ -647,6 +647,7 @@ char * getAudioPath(char * path);
 
 void referenceSystemAudioFiles();
 void referenceModelAudioFiles();
+void invalidateModelAudioFiles();
 
 bool isAudioFileReferenced(uint32_t i, char * filename/*at least AUDIO_FILENAME_MAXLEN+1 long*/);
 
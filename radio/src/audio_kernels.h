@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _AUDIO_KERNELS_H_
+#define _AUDIO_KERNELS_H_
+
+#include <inttypes.h>
+
+/*
+ * Block kernels of the audio output stage, shared by the radio (AudioQueue::wakeup())
+ * and the simulator (SDL output).
+ * The samples are unsigned and centered on a silence value (0x800 for the 12 bits DAC,
+ * 0x8000 in the simulator), or signed with a silence of 0 (X12S), handled as uint16_t.
+ * Gains are fixed point, AUDIO_GAIN_UNIT is 1.0, the scaled samples are rounded down
+ * and saturated to 16 bits.
+ *
+ * Each kernel has a portable reference version (xxxRef) and is built with SSE2 or NEON
+ * on the host and with the DSP instructions on Cortex-M4. All versions give exactly the
+ * same output, which is checked by the gtests.
+ * The Cortex-M4 versions use the CMSIS intrinsics, this file is included after board.h.
+ */
+
+#define AUDIO_GAIN_SHIFT               12
+#define AUDIO_GAIN_UNIT                (1 << AUDIO_GAIN_SHIFT)
+#define AUDIO_GAIN_MAX                 INT16_MAX   // a bit less than 8.0
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define AUDIO_KERNELS_SSE2
+  // the CMSIS register qualifiers of the simulated boards clash with the parameter names of the intrinsics
+  #pragma push_macro("__I")
+  #undef __I
+  #include <emmintrin.h>
+  #pragma pop_macro("__I")
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #define AUDIO_KERNELS_NEON
+  #include <arm_neon.h>
+#elif defined(__ARM_FEATURE_DSP) && defined(__CORE_CM4_SIMD_H)
+  #define AUDIO_KERNELS_DSP
+#endif
+
+#if !defined(AUDIO_KERNELS_SSE2) && !defined(AUDIO_KERNELS_NEON) && !defined(SIMU)
+// 2 samples accessed as one word, the buffers are declared as audio_data_t
+typedef uint32_t __attribute__((may_alias)) audio_sample_pair_t;
+#endif
+
+inline int16_t audioScaleSample(int16_t sample, int16_t gain)
+{
+  int32_t result = ((int32_t)sample * gain) >> AUDIO_GAIN_SHIFT;
+  if (result > INT16_MAX)
+    return INT16_MAX;
+  if (result < INT16_MIN)
+    return INT16_MIN;
+  return result;
+}
+
+// data[i] = value
+inline void audioFillRef(uint16_t * data, uint32_t count, uint16_t value)
+{
+  for (uint32_t i = 0; i < count; i++) {
+    data[i] = value;
+  }
+}
+
+// data[i] = silence + (data[i] - silence) * gain
+inline void audioApplyGainRef(uint16_t * data, uint32_t count, uint16_t silence, int16_t gain)
+{
+  for (uint32_t i = 0; i < count; i++) {
+    data[i] = silence + audioScaleSample(data[i] - silence, gain);
+  }
+}
+
+// dest[i] = ((src[i] - silence) << shift) * gain, signed 16 bits samples for the host sound output
+// (shift is 4 for the 12 bits DAC samples, 0 for the 16 bits ones)
+inline void audioConvertS16Ref(int16_t * dest, const uint16_t * src, uint32_t count, uint16_t silence, uint32_t shift, int16_t gain)
+{
+  for (uint32_t i = 0; i < count; i++) {
+    dest[i] = audioScaleSample((uint16_t)(src[i] - silence) << shift, gain);
+  }
+}
+
+#if defined(AUDIO_KERNELS_SSE2)
+// 16 x 16 bits products on 32 bits, shifted and saturated back to 16 bits
+inline __m128i audioScaleSamples(__m128i samples, __m128i gain)
+{
+  __m128i low = _mm_mullo_epi16(samples, gain);
+  __m128i high = _mm_mulhi_epi16(samples, gain);
+  __m128i result0 = _mm_srai_epi32(_mm_unpacklo_epi16(low, high), AUDIO_GAIN_SHIFT);
+  __m128i result1 = _mm_srai_epi32(_mm_unpackhi_epi16(low, high), AUDIO_GAIN_SHIFT);
+  return _mm_packs_epi32(result0, result1);
+}
+#elif defined(AUDIO_KERNELS_NEON)
+inline int16x8_t audioScaleSamples(int16x8_t samples, int16x4_t gain)
+{
+  int32x4_t result0 = vmull_s16(vget_low_s16(samples), gain);
+  int32x4_t result1 = vmull_s16(vget_high_s16(samples), gain);
+  return vcombine_s16(vqshrn_n_s32(result0, AUDIO_GAIN_SHIFT), vqshrn_n_s32(result1, AUDIO_GAIN_SHIFT));
+}
+#elif defined(AUDIO_KERNELS_DSP)
+// 2 samples packed in a word, gain in the low half of a word
+inline uint32_t audioScaleSamples(uint32_t samples, uint32_t gain)
+{
+  int32_t result0 = __SSAT((int32_t)__SMUAD(samples, gain) >> AUDIO_GAIN_SHIFT, 16);
+  int32_t result1 = __SSAT((int32_t)__SMUADX(samples, gain) >> AUDIO_GAIN_SHIFT, 16);
+  return __PKHBT(result0, result1, 16);
+}
+#endif
+
+inline void audioFill(uint16_t * data, uint32_t count, uint16_t value)
+{
+  uint32_t i = 0;
+#if defined(AUDIO_KERNELS_SSE2)
+  __m128i values = _mm_set1_epi16(value);
+  for (; i + 8 <= count; i += 8) {
+    _mm_storeu_si128((__m128i *)&data[i], values);
+  }
+#elif defined(AUDIO_KERNELS_NEON)
+  uint16x8_t values = vdupq_n_u16(value);
+  for (; i + 8 <= count; i += 8) {
+    vst1q_u16(&data[i], values);
+  }
+#elif !defined(SIMU)
+  // 2 samples per store once the pointer is aligned, on all Cortex-M
+  if (count > 0 && ((uintptr_t)data & 2)) {
+    data[i++] = value;
+  }
+  uint32_t values = value | ((uint32_t)value << 16);
+  for (; i + 2 <= count; i += 2) {
+    *(audio_sample_pair_t *)&data[i] = values;
+  }
+#endif
+  audioFillRef(&data[i], count - i, value);
+}
+
+inline void audioApplyGain(uint16_t * data, uint32_t count, uint16_t silence, int16_t gain)
+{
+  uint32_t i = 0;
+#if defined(AUDIO_KERNELS_SSE2)
+  __m128i silences = _mm_set1_epi16(silence);
+  __m128i gains = _mm_set1_epi16(gain);
+  for (; i + 8 <= count; i += 8) {
+    __m128i samples = _mm_sub_epi16(_mm_loadu_si128((const __m128i *)&data[i]), silences);
+    _mm_storeu_si128((__m128i *)&data[i], _mm_add_epi16(audioScaleSamples(samples, gains), silences));
+  }
+#elif defined(AUDIO_KERNELS_NEON)
+  int16x8_t silences = vdupq_n_s16(silence);
+  int16x4_t gains = vdup_n_s16(gain);
+  for (; i + 8 <= count; i += 8) {
+    int16x8_t samples = vsubq_s16(vreinterpretq_s16_u16(vld1q_u16(&data[i])), silences);
+    vst1q_u16(&data[i], vreinterpretq_u16_s16(vaddq_s16(audioScaleSamples(samples, gains), silences)));
+  }
+#elif defined(AUDIO_KERNELS_DSP)
+  if (count > 0 && ((uintptr_t)data & 2)) {
+    data[i] = silence + audioScaleSample(data[i] - silence, gain);
+    i++;
+  }
+  uint32_t silences = silence | ((uint32_t)silence << 16);
+  for (; i + 2 <= count; i += 2) {
+    audio_sample_pair_t * samples = (audio_sample_pair_t *)&data[i];
+    *samples = __SADD16(audioScaleSamples(__SSUB16(*samples, silences), (uint16_t)gain), silences);
+  }
+#endif
+  audioApplyGainRef(&data[i], count - i, silence, gain);
+}
+
+inline void audioConvertS16(int16_t * dest, const uint16_t * src, uint32_t count, uint16_t silence, uint32_t shift, int16_t gain)
+{
+  uint32_t i = 0;
+#if defined(AUDIO_KERNELS_SSE2)
+  __m128i silences = _mm_set1_epi16(silence);
+  __m128i shifts = _mm_cvtsi32_si128(shift);
+  __m128i gains = _mm_set1_epi16(gain);
+  for (; i + 8 <= count; i += 8) {
+    __m128i samples = _mm_sll_epi16(_mm_sub_epi16(_mm_loadu_si128((const __m128i *)&src[i]), silences), shifts);
+    _mm_storeu_si128((__m128i *)&dest[i], audioScaleSamples(samples, gains));
+  }
+#elif defined(AUDIO_KERNELS_NEON)
+  int16x8_t silences = vdupq_n_s16(silence);
+  int16x8_t shifts = vdupq_n_s16(shift);
+  int16x4_t gains = vdup_n_s16(gain);
+  for (; i + 8 <= count; i += 8) {
+    int16x8_t samples = vshlq_s16(vsubq_s16(vreinterpretq_s16_u16(vld1q_u16(&src[i])), silences), shifts);
+    vst1q_s16(&dest[i], audioScaleSamples(samples, gains));
+  }
+#endif
+  // not used by the radios, no Cortex-M version
+  audioConvertS16Ref(&dest[i], &src[i], count - i, silence, shift, gain);
+}
+
+#endif // _AUDIO_KERNELS_H_
@@ -0,0 +1,335 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "opentx.h"
+#include "bench.h"
+#include "audio_kernels.h"
+
+#if defined(CLI) || defined(SIMU)
+
+// results are accumulated here so that the bodies are not optimized away
+static volatile int32_t benchSink;
+
+static uint8_t benchBuffer[512];
+
+// inputs sweeping the whole stick range
+static int benchInput()
+{
+  static int x = -RESX;
+  x += 37;
+  if (x > RESX)
+    x -= 2 * RESX;
+  return x;
+}
+
+static bool benchFillBuffer()
+{
+  for (unsigned i = 0; i < sizeof(benchBuffer); i++) {
+    benchBuffer[i] = i * 7 + (i >> 3);
+  }
+  return true;
+}
+
+// Mixer
+
+static void benchMixer()
+{
+  evalMixes(1);
+}
+
+static void benchCurve()
+{
+  benchSink += applyCustomCurve(benchInput(), 0);
+}
+
+static void benchExpo()
+{
+  benchSink += expo(benchInput(), 40);
+}
+
+// LCD
+
+#if defined(COLORLCD)
+  #define BENCH_LCD_FLAGS              TEXT_COLOR
+#else
+  #define BENCH_LCD_FLAGS              0
+#endif
+
+static void benchLcdText()
+{
+  lcdDrawText(0, LCD_H / 2, "The quick brown fox jumps", BENCH_LCD_FLAGS);
+}
+
+static void benchLcdFill()
+{
+  lcdDrawFilledRect(0, 0, LCD_W, LCD_H, SOLID, BENCH_LCD_FLAGS);
+}
+
+static void benchLcdClear()
+{
+  lcdClear();
+}
+
+// CRC
+
+static void benchCrc8()
+{
+#if defined(PCBI6X)
+  benchSink += crc8_hw(benchBuffer, 64);
+#else
+  benchSink += crc8(benchBuffer, 64);
+#endif
+}
+
+#if !defined(PCBI6X)
+static void benchCrc16()
+{
+  benchSink += crc16(CRC_1021, benchBuffer, sizeof(benchBuffer));
+}
+#endif
+
+// Audio
+
+#if defined(AUDIO)
+static audio_data_t benchAudioBuffer[AUDIO_BUFFER_SIZE];
+
+static void benchAudioFill()
+{
+  audioFill((uint16_t *)benchAudioBuffer, AUDIO_BUFFER_SIZE, AUDIO_DATA_SILENCE);
+}
+
+static void benchAudioVolume()
+{
+  audioApplyGain((uint16_t *)benchAudioBuffer, AUDIO_BUFFER_SIZE, AUDIO_DATA_SILENCE, (11 * AUDIO_GAIN_UNIT) / VOLUME_LEVEL_MAX);
+}
+#endif
+
+// Telemetry
+
+#if defined(CROSSFIRE)
+static uint8_t benchCrossfireFrame[12];
+static uint8_t benchAllowNewSensors;
+
+// the sensors of the model are updated, but no sensor is created
+static bool benchTelemetrySetup()
+{
+  // battery frame: 11.8V, 2.5A, 1234mAh, 56%
+  const uint8_t frame[] = { RADIO_ADDRESS, 10, BATTERY_ID, 0x00, 0x76, 0x00, 0x19, 0x00, 0x04, 0xD2, 56, 0 };
+  memcpy(benchCrossfireFrame, frame, sizeof(frame));
+#if defined(PCBI6X)
+  benchCrossfireFrame[sizeof(frame) - 1] = crc8_hw(&benchCrossfireFrame[2], benchCrossfireFrame[1] - 1);
+#else
+  benchCrossfireFrame[sizeof(frame) - 1] = crc8(&benchCrossfireFrame[2], benchCrossfireFrame[1] - 1);
+#endif
+  benchAllowNewSensors = allowNewSensors;
+  allowNewSensors = false;
+  return true;
+}
+
+static void benchTelemetry()
+{
+  processCrossfireTelemetryChunk(benchCrossfireFrame, sizeof(benchCrossfireFrame));
+}
+
+static void benchTelemetryTeardown()
+{
+  allowNewSensors = benchAllowNewSensors;
+}
+#endif
+
+// SD card
+
+#if defined(SDCARD)
+#define BENCH_FILE_PATH                ROOT_PATH "BENCH.BIN"
+#define BENCH_FILE_BLOCKS              128   // 64kB
+
+static FIL benchFile;
+
+// a file is written for the read benchmarks, and deleted at the end
+static bool benchSdSetup()
+{
+  if (!sdMounted() || f_open(&benchFile, BENCH_FILE_PATH, FA_CREATE_ALWAYS | FA_WRITE | FA_READ) != FR_OK)
+    return false;
+
+  benchFillBuffer();
+  for (unsigned i = 0; i < BENCH_FILE_BLOCKS; i++) {
+    UINT written;
+    if (f_write(&benchFile, benchBuffer, sizeof(benchBuffer), &written) != FR_OK || written != sizeof(benchBuffer)) {
+      f_close(&benchFile);
+      f_unlink(BENCH_FILE_PATH);
+      return false;
+    }
+  }
+  return f_lseek(&benchFile, 0) == FR_OK;
+}
+
+static void benchSdRead()
+{
+  UINT read;
+  if (f_read(&benchFile, benchBuffer, sizeof(benchBuffer), &read) != FR_OK || read != sizeof(benchBuffer)) {
+    f_lseek(&benchFile, 0);
+  }
+}
+
+static void benchSdSeek()
+{
+  static uint32_t seed = 1;
+  seed = seed * 1103515245 + 12345;
+  UINT read;
+  f_lseek(&benchFile, ((seed >> 16) % BENCH_FILE_BLOCKS) * sizeof(benchBuffer));
+  f_read(&benchFile, benchBuffer, sizeof(benchBuffer), &read);
+}
+
+static void benchSdTeardown()
+{
+  f_close(&benchFile);
+  f_unlink(BENCH_FILE_PATH);
+}
+#endif
+
+// Lua
+
+#if defined(LUA)
+static int benchLuaFunction = LUA_NOREF;
+
+// chunk returns the function which is benchmarked
+static bool benchLuaLoad(const char * chunk)
+{
+  if (!lsScripts)
+    return false;
+  if (luaL_loadstring(lsScripts, chunk) != LUA_OK || lua_pcall(lsScripts, 0, 1, 0) != LUA_OK) {
+    lua_pop(lsScripts, 1);
+    return false;
+  }
+  benchLuaFunction = luaL_ref(lsScripts, LUA_REGISTRYINDEX);
+  return true;
+}
+
+static bool benchLuaSetup()
+{
+  return benchLuaLoad("return function(x) return x + 1 end");
+}
+
+// a model line (the first output, which always exists), in a new table and in the same table
+static bool benchLuaGetOutputSetup()
+{
+  return benchLuaLoad("return function(x) model.getOutput(0) return x end");
+}
+
+static bool benchLuaGetOutputInPlaceSetup()
+{
+  return benchLuaLoad("local t = {} return function(x) model.getOutput(0, t) return x end");
+}
+
+static void benchLuaCall()
+{
+  lua_rawgeti(lsScripts, LUA_REGISTRYINDEX, benchLuaFunction);
+  lua_pushinteger(lsScripts, benchSink);
+  if (lua_pcall(lsScripts, 1, 1, 0) == LUA_OK)
+    benchSink = lua_tointeger(lsScripts, -1);
+  lua_pop(lsScripts, 1);
+}
+
+static void benchLuaTeardown()
+{
+  luaL_unref(lsScripts, LUA_REGISTRYINDEX, benchLuaFunction);
+  benchLuaFunction = LUA_NOREF;
+}
+#endif
+
+const Benchmark benchmarks[] = {
+  { "mixer", nullptr, benchMixer, nullptr },
+  { "curve", nullptr, benchCurve, nullptr },
+  { "expo", nullptr, benchExpo, nullptr },
+  { "lcd-text", nullptr, benchLcdText, nullptr },
+  { "lcd-fill", nullptr, benchLcdFill, nullptr },
+  { "lcd-clear", nullptr, benchLcdClear, nullptr },
+  { "crc8", benchFillBuffer, benchCrc8, nullptr },
+#if !defined(PCBI6X)
+  { "crc16", benchFillBuffer, benchCrc16, nullptr },
+#endif
+#if defined(AUDIO)
+  { "audio-fill", nullptr, benchAudioFill, nullptr },
+  { "audio-volume", nullptr, benchAudioVolume, nullptr },
+#endif
+#if defined(CROSSFIRE)
+  { "telemetry-crsf", benchTelemetrySetup, benchTelemetry, benchTelemetryTeardown },
+#endif
+#if defined(SDCARD)
+  { "sd-read", benchSdSetup, benchSdRead, benchSdTeardown },
+  { "sd-seek", benchSdSetup, benchSdSeek, benchSdTeardown },
+#endif
+#if defined(LUA)
+  { "lua-call", benchLuaSetup, benchLuaCall, benchLuaTeardown },
+  { "lua-getoutput", benchLuaGetOutputSetup, benchLuaCall, benchLuaTeardown },
+  { "lua-getoutput-inplace", benchLuaGetOutputInPlaceSetup, benchLuaCall, benchLuaTeardown },
+#endif
+  { nullptr, nullptr, nullptr, nullptr }  /* sentinel */
+};
+
+const Benchmark * benchFind(const char * name)
+{
+  for (const Benchmark * bench = benchmarks; bench->name != nullptr; bench++) {
+    if (!strcmp(bench->name, name)) {
+      return bench;
+    }
+  }
+  return nullptr;
+}
+
+#define BENCH_BATCH_TICKS              8000  // 4ms, far from the 32ms wrap of getTmr2MHz()
+
+bool benchRun(const Benchmark * bench, uint32_t duration, BenchmarkResult & result)
+{
+  result.runs = 0;
+  result.ticks = 0;
+
+  if (bench->setup && !bench->setup()) {
+    return false;
+  }
+
+  // the batch size doubles until a batch lasts BENCH_BATCH_TICKS / 2 or more
+  uint32_t batch = 1;
+  uint32_t maxTicks = min<uint32_t>(duration, BENCH_MAX_DURATION) * 2000;
+  tmr10ms_t start = get_tmr10ms();
+  while (result.ticks < maxTicks) {
+    uint16_t t0 = getTmr2MHz();
+    for (uint32_t i = 0; i < batch; i++) {
+      bench->run();
+    }
+    uint16_t elapsed = getTmr2MHz() - t0;
+    result.ticks += elapsed;
+    result.runs += batch;
+    if (elapsed < BENCH_BATCH_TICKS / 2 && batch < 0x10000) {
+      batch *= 2;
+    }
+    // safety net in case a body is too slow for the 2MHz timer
+    if ((tmr10ms_t)(get_tmr10ms() - start) > BENCH_MAX_DURATION / 10) {
+      break;
+    }
+  }
+
+  if (bench->teardown) {
+    bench->teardown();
+  }
+  return true;
+}
+
+#endif // defined(CLI) || defined(SIMU)
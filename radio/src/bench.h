@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+#include <inttypes.h>
+
+/*
+ * Microbenchmarks, built in the firmware with the CLI ("bench" command) and in the
+ * simulator / gtests, so that the same bodies can be compared between builds and
+ * between the radio and the host.
+ * A benchmark runs its body in batches timed with getTmr2MHz(), one call of the body
+ * must stay well under the 32ms period of the 16 bits timer.
+ */
+
+#define BENCH_DEFAULT_DURATION         200   // ms
+#define BENCH_MAX_DURATION             2000  // ms
+
+struct Benchmark
+{
+  const char * name;
+  bool (*setup)();        // optional, false if the benchmark is not available
+  void (*run)();
+  void (*teardown)();     // optional
+};
+
+struct BenchmarkResult
+{
+  uint32_t runs;
+  uint32_t ticks;         // getTmr2MHz() ticks (0.5us)
+
+  uint32_t timeUs() const
+  {
+    return ticks / 2;
+  }
+
+  uint32_t nsPerRun() const
+  {
+    return runs ? uint32_t((uint64_t(ticks) * 500) / runs) : 0;
+  }
+};
+
+extern const Benchmark benchmarks[];
+
+const Benchmark * benchFind(const char * name);
+bool benchRun(const Benchmark * bench, uint32_t duration, BenchmarkResult & result);
+
+#endif // _BENCH_H_
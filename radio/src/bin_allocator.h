@@ -31,8 +31,9 @@ private:
   });
   struct Bin Bins[NUM_BINS];
   int NoUsedBins;
+  int MaxUsedBins;
 public:
-  BinAllocator() : NoUsedBins(0) {
+  BinAllocator() : NoUsedBins(0), MaxUsedBins(0) {
     memclear(Bins, sizeof(Bins));
   }
   bool free(void * ptr) {
@@ -61,7 +62,9 @@ public:
     for (size_t n = 0; n < NUM_BINS; ++n) {
       if (!Bins[n].Used) {
         Bins[n].Used = true;
-        ++NoUsedBins;
+        if (++NoUsedBins > MaxUsedBins) {
+          MaxUsedBins = NoUsedBins;
+        }
         // TRACE("\tBinAllocator<%d> malloc %lu[%lu]", SIZE_SLOT, n, size);
         return Bins[n].data;
       }
@@ -77,6 +80,8 @@ public:
   }
   unsigned int capacity() { return NUM_BINS; }
   unsigned int size() { return NoUsedBins; }
+  unsigned int peak() { return MaxUsedBins; }
+  void resetPeak() { MaxUsedBins = NoUsedBins; }
 };
 
 #if defined(SIMU)
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x 
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _CHANNELS_PACKING_H_
+#define _CHANNELS_PACKING_H_
+
+#include <inttypes.h>
+
+/*
+ * 16 channels x 11 bits packed LSB first into 22 bytes, as used by CRSF and SBUS.
+ * The byte/channel layout is computed at compile time and the loops are fully
+ * unrolled, so each byte is built from one or two channels with constant shifts.
+ */
+
+#define PACKED_CHANNELS_COUNT          16
+#define PACKED_CHANNEL_BITS            11
+#define PACKED_CHANNEL_MASK            ((1 << PACKED_CHANNEL_BITS) - 1)
+#define PACKED_CHANNELS_SIZE           (PACKED_CHANNELS_COUNT * PACKED_CHANNEL_BITS / 8)
+
+template <int BYTE>
+struct ChannelsPacker
+{
+  static constexpr int channel = (BYTE * 8) / PACKED_CHANNEL_BITS;
+  static constexpr int shift = (BYTE * 8) % PACKED_CHANNEL_BITS;
+
+  static inline void pack(uint8_t * out, const uint16_t * in)
+  {
+    ChannelsPacker<BYTE - 1>::pack(out, in);
+    if (shift > PACKED_CHANNEL_BITS - 8)
+      out[BYTE] = (in[channel] >> shift) | (in[channel + 1] << (PACKED_CHANNEL_BITS - shift));
+    else
+      out[BYTE] = in[channel] >> shift;
+  }
+};
+
+template <>
+struct ChannelsPacker<-1>
+{
+  static inline void pack(uint8_t *, const uint16_t *)
+  {
+  }
+};
+
+template <int CHANNEL>
+struct ChannelsUnpacker
+{
+  static constexpr int byte = (CHANNEL * PACKED_CHANNEL_BITS) / 8;
+  static constexpr int shift = (CHANNEL * PACKED_CHANNEL_BITS) % 8;
+
+  static inline void unpack(uint16_t * out, const uint8_t * in)
+  {
+    ChannelsUnpacker<CHANNEL - 1>::unpack(out, in);
+    uint32_t bits = (in[byte] >> shift) | (in[byte + 1] << (8 - shift));
+    if (shift > 16 - PACKED_CHANNEL_BITS)
+      bits |= in[byte + 2] << (16 - shift);
+    out[CHANNEL] = bits & PACKED_CHANNEL_MASK;
+  }
+};
+
+template <>
+struct ChannelsUnpacker<-1>
+{
+  static inline void unpack(uint16_t *, const uint8_t *)
+  {
+  }
+};
+
+// in[] values must fit in PACKED_CHANNEL_BITS
+inline void packChannels(uint8_t * out, const uint16_t * in)
+{
+  ChannelsPacker<PACKED_CHANNELS_SIZE - 1>::pack(out, in);
+}
+
+inline void unpackChannels(uint16_t * out, const uint8_t * in)
+{
+  ChannelsUnpacker<PACKED_CHANNELS_COUNT - 1>::unpack(out, in);
+}
+
+// x * 4 / 5 rounded toward 0 like the C division, without division (Cortex-M0 has none)
+// exact for -20479 <= x <= 20479
+#define PACKED_CHANNEL_SCALE_MAX       20479
+
+inline int32_t channelScale4div5(int32_t x)
+{
+  int32_t sign = x >> 31;
+  uint32_t abs = (x ^ sign) - sign;
+  int32_t result = (abs * (4 * 52429)) >> 18;
+  return (result ^ sign) - sign;
+}
+
+#endif // _CHANNELS_PACKING_H_
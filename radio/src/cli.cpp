@@ -22,6 +22,10 @@
 #if defined(SDCARD)
 #include "diskio.h"
 #endif
+#if defined(LUA)
+#include "bin_allocator.h"
+#endif
+#include "bench.h"
 #include <ctype.h>
 #include <malloc.h>
 #include <new>
@@ -359,7 +363,6 @@ int cliTestNew()
 
 #if defined(COLORLCD)
 
-extern bool perMainEnabled;
 typedef void (*timedTestFunc_t)(void);
 
 void testDrawSolidFilledRectangle()
@@ -691,6 +694,67 @@ int cliTest(const char ** argv)
   return 0;
 }
 
+void cliRunBenchmark(const Benchmark * bench, uint32_t duration)
+{
+  BenchmarkResult result;
+  watchdogSuspend(BENCH_MAX_DURATION / 10 + 100);
+  if (benchRun(bench, duration, result))
+    serialPrint("bench,%s,%u,%u,%u", bench->name, result.runs, result.timeUs(), result.nsPerRun());
+  else
+    serialPrint("bench,%s,skipped", bench->name);
+  RTOS_WAIT_MS(20);
+}
+
+int cliBench(const char ** argv)
+{
+  int duration = 0;
+  if (toInt(argv, 2, &duration) == 0) {
+    duration = BENCH_DEFAULT_DURATION;
+  }
+  else if (duration <= 0 || duration > BENCH_MAX_DURATION) {
+    serialPrint("%s: Invalid duration", argv[0]);
+    return 0;
+  }
+
+  const Benchmark * bench = nullptr;
+  bool all = !strcmp(argv[1], "all");
+  if (!all && !(bench = benchFind(argv[1]))) {
+    serialPrint("%s: Invalid argument \"%s\"", argv[0], argv[1]);
+    for (bench = benchmarks; bench->name != nullptr; bench++) {
+      serialPrint("  %s", bench->name);
+    }
+    return 0;
+  }
+
+  // nothing else runs on the CPU meanwhile (except the interrupts)
+  if (pulsesStarted()) {
+    pausePulses();
+  }
+  pauseMixerCalculations();
+  perMainEnabled = false;
+  RTOS_WAIT_MS(100);
+
+  // machine readable results: name, runs, total time (us), time per run (ns)
+  serialPrint("bench,name,runs,us,ns/run");
+  if (all) {
+    for (bench = benchmarks; bench->name != nullptr; bench++) {
+      cliRunBenchmark(bench, duration);
+    }
+  }
+  else {
+    cliRunBenchmark(bench, duration);
+  }
+
+  perMainEnabled = true;
+  if (pulsesStarted()) {
+    resumePulses();
+  }
+  resumeMixerCalculations();
+  watchdogSuspend(0);
+
+  return 0;
+}
+
 #if defined(DEBUG)
 int cliTrace(const char ** argv)
 {
@@ -770,6 +834,65 @@ int cliMemoryInfo(const char ** argv)
   return 0;
 }
 
+#if defined(LUA)
+void cliPrintLuaStateStats(const char * name, lua_State * L, const LuaStateStats & stats)
+{
+  serialPrint("[%s] mem %u peak %u gc runs %u last %uus max %uus total %ums", name,
+              luaGetMemUsed(L), stats.memPeak, stats.gcRuns,
+              stats.gcTime, stats.gcMaxTime, stats.gcTotalTime / 1000);
+  serialPrintf("[%s] gc pauses", name);
+  for (int i=0; i<LUA_GC_PAUSE_BUCKETS-1; i++) {
+    serialPrintf(" <%uus %u", luaGcPauseLimits[i], stats.gcPauses[i]);
+  }
+  serialPrint(" >=%uus %u", luaGcPauseLimits[LUA_GC_PAUSE_BUCKETS-2], stats.gcPauses[LUA_GC_PAUSE_BUCKETS-1]);
+}
+
+void cliPrintLuaScriptStats(const char * type, const char * name, const LuaScriptStats & stats)
+{
+  serialPrint("%-9s %-8s runs %u instr %u max %u time %uus max %uus", type, name,
+              stats.runs, stats.instructions, stats.maxInstructions,
+              stats.time, stats.maxTime);
+}
+
+int cliLua(const char ** argv)
+{
+  if (!strcmp(argv[1], "stats")) {
+    if (!strcmp(argv[2], "reset")) {
+      luaResetStats();
+      return 0;
+    }
+    char name[LUA_STATS_NAME_LEN+1];
+    for (int i=0; i<luaScriptsCount; i++) {
+      const ScriptInternalData & sid = scriptInternalData[i];
+      luaGetScriptName(sid, name);
+      cliPrintLuaScriptStats(luaGetScriptType(sid), name, sid.stats);
+    }
+    if (luaState & INTERPRETER_RUNNING_STANDALONE_SCRIPT) {
+      cliPrintLuaScriptStats("standalone", "", standaloneScript.stats);
+    }
+#if defined(COLORLCD)
+    cliPrintLuaScriptStats("widgets", "", luaWidgetsRunStats);
+#endif
+    cliPrintLuaStateStats("Scripts", lsScripts, luaScriptsStats);
+#if defined(COLORLCD)
+    cliPrintLuaStateStats("Widgets", lsWidgets, luaWidgetsStats);
+#endif
+#if defined(USE_BIN_ALLOCATOR)
+    serialPrint("[BinAllocator] slots1 %u peak %u / %u, slots2 %u peak %u / %u",
+                slots1.size(), slots1.peak(), slots1.capacity(),
+                slots2.size(), slots2.peak(), slots2.capacity());
+#endif
+#if !defined(SIMU)
+    serialPrint("[Heap] used %u bytes", luaGetSystemHeapUsed());
+#endif
+  }
+  else {
+    serialPrint("%s: Invalid arguments", argv[0]);
+  }
+  return 0;
+}
+#endif
+
 int cliReboot(const char ** argv)
 {
 #if !defined(SIMU)
@@ -933,6 +1056,27 @@ void printDebugTimers()
 }
 #endif
 
+#if defined(DEBUG_LOAD)
+void printLoad()
+{
+  static LoadCounters counters;  // since the previous call
+  LoadReport report;
+  loadGetReport(report, counters);
+
+  serialPrint("CPU load in the last %u ms:", report.duration / 1000);
+  for (int n = 0; n < LOAD_TASK_COUNT; n++) {
+    serialPrint("%s: %u.%u%%", loadTaskNames[n], report.tasks[n] / 10, report.tasks[n] % 10);
+  }
+  for (int n = 0; n < LOAD_INT_COUNT; n++) {
+    serialPrint("int %s: %u.%u%%, longest %uus", loadInterruptNames[n], report.interrupts[n] / 10, report.interrupts[n] % 10, report.interruptsMax[n]);
+  }
+  loadResetMax();
+
+  serialPrint("Stacks high-water (unused/size):");
+  cliStackInfo(nullptr);
+}
+#endif
+
 #include "OsMutex.h"
 extern RTOS_MUTEX_HANDLE audioMutex;
 
@@ -1084,6 +1228,11 @@ int cliDisplay(const char ** argv)
     printDebugTimers();
   }
 #endif
+#if defined(DEBUG_LOAD)
+  else if (!strcmp(argv[1], "load")) {
+    printLoad();
+  }
+#endif
 #if defined(AUDIO)
   else if (!strcmp(argv[1], "audio")) {
     printAudioVars();
@@ -1163,11 +1312,22 @@ int cliShowJitter(const char ** argv)
 int cliGps(const char ** argv)
 {
   int baudrate = 0;
+  int rate = 0;
 
   if (argv[1][0] == '$') {
     // send command to GPS
     gpsSendFrame(argv[1]);
   }
+  else if (!strcmp(argv[1], "ubx")) {
+    if (toInt(argv, 2, &rate) > 0 && rate > 0 && rate <= 10) {
+      gpsUbxRate = rate;
+      gpsConfigureUBX(rate);
+      serialPrint("GPS UBX rate set to %dHz", rate);
+    }
+    else {
+      serialPrint("%s: Invalid rate", argv[0]);
+    }
+  }
 #if defined(DEBUG)
   else if (!strcmp(argv[1], "trace")) {
     gpsTraceEnabled = !gpsTraceEnabled;
@@ -1230,7 +1390,11 @@ const CliCommand cliCommands[] = {
   { "set", cliSet, "<what> <value>" },
   { "stackinfo", cliStackInfo, "" },
   { "meminfo", cliMemoryInfo, "" },
+#if defined(LUA)
+  { "lua", cliLua, "stats [reset]" },
+#endif
   { "test", cliTest, "new | std::exception | graphics | memspd" },
+  { "bench", cliBench, "<name> | all [<duration ms>]" },
 #if defined(DEBUG)
   { "trace", cliTrace, "on | off" },
 #endif
@@ -1241,7 +1405,7 @@ const CliCommand cliCommands[] = {
   { "jitter", cliShowJitter, "" },
 #endif
 #if defined(INTERNAL_GPS)
-  { "gps", cliGps, "<baudrate>|$<command>|trace" },
+  { "gps", cliGps, "<baudrate>|$<command>|ubx <rate>|trace" },
 #endif
 #if defined(BLUETOOTH)
   { "bt", cliBlueTooth, "<baudrate>|<command>" },
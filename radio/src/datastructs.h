@@ -108,6 +108,28 @@ PACK(struct ExpoData {
   CurveRef curve;
 });
 
+#if defined(MODEL_ARENA)
+/*
+ * Mixes and expos of the model in RAM: only the lines in use, the mixes first,
+ * then the expos. On disk they keep their fixed size tables (see MODEL_DATA_SIZE)
+ * With the default size the RAM used is a bit higher than with the tables: the 2
+ * counts, the empty line read after the lists and the segments list used to save
+ * the model (about 80 bytes). Set MODEL_ARENA_SIZE smaller to save RAM, a model
+ * whose lines do not fit is then not loaded (see eeModelArenaOverflow()).
+ * The lists are still limited to MAX_MIXERS and MAX_EXPOS lines.
+ */
+
+#if !defined(MODEL_ARENA_SIZE)
+  #define MODEL_ARENA_SIZE             (MAX_MIXERS * sizeof(MixData) + MAX_EXPOS * sizeof(ExpoData))
+#endif
+
+PACK(struct ModelArena {
+  uint8_t mixesCount;
+  uint8_t exposCount;
+  uint8_t data[MODEL_ARENA_SIZE];
+});
+#endif
+
 /*
  * Limit structure
  */
@@ -609,9 +631,15 @@ PACK(struct ModelData {
   uint8_t extendedTrims : 1;
   uint8_t throttleReversed : 1;
   BeepANACenter beepANACenter;
+#if defined(MODEL_ARENA)
+  ModelArena arena;
+#else
   MixData mixData[MAX_MIXERS];
+#endif
   LimitData limitData[MAX_OUTPUT_CHANNELS];
+#if !defined(MODEL_ARENA)
   ExpoData expoData[MAX_EXPOS];
+#endif
 
   CurveData curves[MAX_CURVES];
   int8_t points[MAX_CURVE_POINTS];
@@ -638,6 +666,13 @@ PACK(struct ModelData {
   CUSTOM_SCREENS_DATA
 });
 
+// Size of the model on disk
+#if defined(MODEL_ARENA)
+  #define MODEL_DATA_SIZE              (sizeof(ModelData) - sizeof(ModelArena) + MAX_MIXERS * sizeof(MixData) + MAX_EXPOS * sizeof(ExpoData))
+#else
+  #define MODEL_DATA_SIZE              sizeof(ModelData)
+#endif
+
 /*
  * Radio structure
  */
@@ -830,6 +865,11 @@ void check_size() {
 static inline void check_struct() {
 #define CHKSIZE(x, y) check_size<struct x, y>()
 #define CHKTYPE(x, y) check_size<x, y>()
+#if defined(MODEL_ARENA)
+  #define CHKMODELSIZE(y) static_assert(MODEL_DATA_SIZE == y, "struct size changed")
+#else
+  #define CHKMODELSIZE(y) CHKSIZE(ModelData, y)
+#endif
 
   CHKSIZE(CurveRef, 2);
 
@@ -938,28 +978,29 @@ static inline void check_struct() {
 
 #if defined(PCBI6X)
   CHKSIZE(RadioData, 318);
-  CHKSIZE(ModelData, 2848);
+  CHKMODELSIZE(2848);
 #elif defined(PCBXLITE)
   CHKSIZE(RadioData, 844);
-  CHKSIZE(ModelData, 6025);
+  CHKMODELSIZE(6025);
 #elif defined(PCBX7)
   CHKSIZE(RadioData, 850);
-  CHKSIZE(ModelData, 6025);
+  CHKMODELSIZE(6025);
 #elif defined(PCBX9E)
   CHKSIZE(RadioData, 952);
-  CHKSIZE(ModelData, 6520);
+  CHKMODELSIZE(6520);
 #elif defined(PCBX9D)
   CHKSIZE(RadioData, 872);
-  CHKSIZE(ModelData, 6507);
+  CHKMODELSIZE(6507);
 #elif defined(PCBSKY9X)
   CHKSIZE(RadioData, 727);
-  CHKSIZE(ModelData, 5188);
+  CHKMODELSIZE(5188);
 #elif defined(PCBHORUS)
   CHKSIZE(RadioData, 847);
-  CHKSIZE(ModelData, 9380);
+  CHKMODELSIZE(9380);
 #endif
 
 #undef CHKSIZE
 #undef CHKSIZEUNION
+#undef CHKMODELSIZE
 }
 #endif /* BACKUP */
@@ -177,10 +177,183 @@ struct InterruptCounters interruptCounters;
 #endif //#if defined(DEBUG_INTERRUPTS)
 
 #if defined(DEBUG_TASKS)
-
 uint32_t taskSwitchLog[DEBUG_TASKS_LOG_SIZE] __SDRAM;
 uint16_t taskSwitchLogPos;
+#endif // #if defined(DEBUG_TASKS)
+
+#if defined(DEBUG_LOAD)
+
+const char * const loadTaskNames[LOAD_TASK_COUNT] = {
+  "mixer",  // LOAD_TASK_MIXER
+  "menus",  // LOAD_TASK_MENUS
+  "audio",  // LOAD_TASK_AUDIO
+  "cli",    // LOAD_TASK_CLI
+  "idle",   // LOAD_TASK_IDLE
+};
+
+const char * const loadInterruptNames[LOAD_INT_COUNT] = {
+  "tick",       // LOAD_INT_TICK
+  "pulses",     // LOAD_INT_PULSES
+  "telemetry",  // LOAD_INT_TELEMETRY
+};
+
+static uint16_t loadPermille(uint32_t time, uint32_t duration)
+{
+  return duration ? (uint64_t)time * 1000 / duration : 0;
+}
+
+#if defined(SIMU)
+// The tasks are threads, the system gives their CPU time
+static uint32_t loadThreadTime(RTOS_TASK_HANDLE thread)
+{
+#if defined(__linux__)
+  clockid_t clock;
+  struct timespec ts;
+  if (thread && !pthread_getcpuclockid(thread, &clock) && !clock_gettime(clock, &ts)) {
+    return ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+  }
+#endif
+  return 0;
+}
+
+void loadGetCounters(LoadCounters & counters)
+{
+  memclear(&counters, sizeof(counters));
+  counters.time = simuTimerMicros();
+  counters.tasks[LOAD_TASK_MIXER] = loadThreadTime(mixerTaskId);
+  counters.tasks[LOAD_TASK_MENUS] = loadThreadTime(menusTaskId);
+}
+
+void loadResetMax()
+{
+}
+#else
+// The time of each task is accounted at each task switch (and each 5ms to stay within the
+// 16 bits range of getTmr2MHz()), without the time spent in the instrumented interrupts
+#define LOAD_TASK_IDS            (CFG_MAX_USER_TASKS + 2)
+
+static uint32_t loadTime;
+static uint32_t loadTaskTime[LOAD_TASK_IDS];
+static uint32_t loadInterruptTime[LOAD_INT_COUNT];
+static uint16_t loadInterruptMax[LOAD_INT_COUNT];
+static uint32_t loadInterruptsTotal;      // outermost interrupts only
+static uint32_t loadInterruptsAtSwitch;
+static uint16_t loadSwitchTime;
+static uint8_t loadInterruptNesting;
+static uint8_t loadRunningTask;
+
+static void loadSwitchTask(uint8_t taskID)
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  uint16_t now = getTmr2MHz();
+  uint16_t elapsed = now - loadSwitchTime;
+  uint32_t interrupts = loadInterruptsTotal - loadInterruptsAtSwitch;
+  loadTime += elapsed;
+  if (loadRunningTask < LOAD_TASK_IDS && interrupts < elapsed) {
+    loadTaskTime[loadRunningTask] += elapsed - interrupts;
+  }
+  loadSwitchTime = now;
+  loadInterruptsAtSwitch = loadInterruptsTotal;
+  loadRunningTask = taskID;
+  __set_PRIMASK(primask);
+}
+
+void loadSample()
+{
+  loadSwitchTask(loadRunningTask);
+}
+
+// The interrupts can nest (several of them share LOAD_INT_PULSES), the counters are
+// updated with the interrupts disabled
+uint16_t loadInterruptStart()
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  loadInterruptNesting++;
+  __set_PRIMASK(primask);
+  return getTmr2MHz();
+}
+
+void loadInterruptStop(uint8_t interrupt, uint16_t start)
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  uint16_t duration = getTmr2MHz() - start;
+  loadInterruptTime[interrupt] += duration;
+  if (duration > loadInterruptMax[interrupt]) {
+    loadInterruptMax[interrupt] = duration;
+  }
+  if (--loadInterruptNesting == 0) {
+    loadInterruptsTotal += duration;
+  }
+  __set_PRIMASK(primask);
+}
+
+static uint32_t loadGetTaskTime(RTOS_TASK_HANDLE taskID)
+{
+  return taskID < LOAD_TASK_IDS ? loadTaskTime[taskID] : 0;
+}
+
+void loadGetCounters(LoadCounters & counters)
+{
+  memclear(&counters, sizeof(counters));
+  loadSample();
+  __disable_irq();
+  counters.time = loadTime;
+  counters.tasks[LOAD_TASK_MIXER] = loadGetTaskTime(mixerTaskId);
+  counters.tasks[LOAD_TASK_MENUS] = loadGetTaskTime(menusTaskId);
+#if defined(VOICE)
+  counters.tasks[LOAD_TASK_AUDIO] = loadGetTaskTime(audioTaskId);
+#endif
+#if defined(CLI)
+  counters.tasks[LOAD_TASK_CLI] = loadGetTaskTime(cliTaskId);
+#endif
+  counters.tasks[LOAD_TASK_IDLE] = loadTaskTime[0];
+  memcpy(counters.interrupts, loadInterruptTime, sizeof(loadInterruptTime));
+  __enable_irq();
+}
+
+void loadResetMax()
+{
+  memclear(loadInterruptMax, sizeof(loadInterruptMax));
+}
+#endif
+
+void loadGetReport(LoadReport & report, LoadCounters & counters)
+{
+  LoadCounters now;
+  loadGetCounters(now);
+
+  uint32_t duration = now.time - counters.time;
+  report.duration = duration / LOAD_TICKS_PER_US;
+  for (uint8_t i = 0; i < LOAD_TASK_COUNT; i++) {
+    report.tasks[i] = loadPermille(now.tasks[i] - counters.tasks[i], duration);
+  }
+  for (uint8_t i = 0; i < LOAD_INT_COUNT; i++) {
+    report.interrupts[i] = loadPermille(now.interrupts[i] - counters.interrupts[i], duration);
+#if defined(SIMU)
+    report.interruptsMax[i] = 0;
+#else
+    report.interruptsMax[i] = loadInterruptMax[i] / LOAD_TICKS_PER_US;
+#endif
+  }
+
+#if defined(SIMU)
+  // no idle task, what is left of one CPU
+  uint16_t busy = 0;
+  for (uint8_t i = 0; i < LOAD_TASK_COUNT; i++) {
+    busy += report.tasks[i];
+  }
+  report.tasks[LOAD_TASK_IDLE] = (busy < 1000 ? 1000 - busy : 0);
+#endif
 
+  counters = now;
+}
+
+#endif // #if defined(DEBUG_LOAD)
+
+#if defined(DEBUG_TASKS) || (defined(DEBUG_LOAD) && !defined(SIMU))
 /**
  *******************************************************************************
  * @brief      Hook for task switch logging
@@ -188,19 +361,24 @@ uint16_t taskSwitchLogPos;
  * @retval     None
  *
  * @par Description
- * @details    This function logs the time when a task entered the RUNNING state.
+ * @details    This function logs the time when a task entered the RUNNING state,
+ *             and accounts the CPU time of the task which leaves it.
  *******************************************************************************
  */
 void CoTaskSwitchHook(uint8_t taskID)
 {
+#if defined(DEBUG_TASKS)
   /* Log task switch here */
   taskSwitchLog[taskSwitchLogPos] = (taskID << 24) + ((uint32_t)CoGetOSTime() & 0xFFFFFF);
   if(++taskSwitchLogPos >= DEBUG_TASKS_LOG_SIZE) {
     taskSwitchLogPos = 0;
   }
+#endif
+#if defined(DEBUG_LOAD)
+  loadSwitchTask(taskID);
+#endif
 }
-
-#endif // #if defined(DEBUG_TASKS)
+#endif
 
 #if defined(DEBUG_TIMERS)
 
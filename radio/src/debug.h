@@ -318,6 +318,9 @@ extern struct InterruptCounters interruptCounters;
 extern uint32_t taskSwitchLog[DEBUG_TASKS_LOG_SIZE];
 extern uint16_t taskSwitchLogPos;
 
+#endif // #if defined(DEBUG_TASKS)
+
+#if defined(DEBUG_TASKS) || defined(DEBUG_LOAD)
 #if defined(__cplusplus)
 extern "C" {
 #endif
@@ -325,8 +328,76 @@ extern void CoTaskSwitchHook(uint8_t taskID);
 #if defined(__cplusplus)
 }
 #endif
+#endif
 
-#endif // #if defined(DEBUG_TASKS)
+#if defined(DEBUG_LOAD) && defined(__cplusplus)
+
+enum LoadTasks {
+  LOAD_TASK_MIXER,
+  LOAD_TASK_MENUS,
+  LOAD_TASK_AUDIO,
+  LOAD_TASK_CLI,
+  LOAD_TASK_IDLE,
+  LOAD_TASK_COUNT
+};
+
+// interrupts instrumented with DEBUG_LOAD_INT_START() / DEBUG_LOAD_INT_STOP()
+enum LoadInterrupts {
+  LOAD_INT_TICK,
+  LOAD_INT_PULSES,
+  LOAD_INT_TELEMETRY,
+  LOAD_INT_COUNT
+};
+
+#if defined(SIMU)
+  #define LOAD_TICKS_PER_US     1
+#else
+  #define LOAD_TICKS_PER_US     2   // getTmr2MHz()
+#endif
+
+// CPU time spent in each task and interrupt since the start, in LOAD_TICKS_PER_US units
+// (they wrap around, only the differences between two snapshots are meaningful)
+struct LoadCounters
+{
+  uint32_t time;
+  uint32_t tasks[LOAD_TASK_COUNT];
+  uint32_t interrupts[LOAD_INT_COUNT];
+};
+
+// CPU load between two snapshots, in 0.1%
+struct LoadReport
+{
+  uint32_t duration;                       // us
+  uint16_t tasks[LOAD_TASK_COUNT];
+  uint16_t interrupts[LOAD_INT_COUNT];
+  uint16_t interruptsMax[LOAD_INT_COUNT];  // longest run in us since loadResetMax(), tasks can't run meanwhile
+};
+
+extern const char * const loadTaskNames[LOAD_TASK_COUNT];
+extern const char * const loadInterruptNames[LOAD_INT_COUNT];
+
+void loadGetCounters(LoadCounters & counters);
+// fills report with the load since the counters snapshot, which is then updated
+void loadGetReport(LoadReport & report, LoadCounters & counters);
+void loadResetMax();
+
+#if !defined(SIMU)
+void loadSample();
+uint16_t loadInterruptStart();
+void loadInterruptStop(uint8_t interrupt, uint16_t start);
+
+#define DEBUG_LOAD_SAMPLE()        loadSample()
+#define DEBUG_LOAD_INT_START()     uint16_t _loadInterruptStart = loadInterruptStart()
+#define DEBUG_LOAD_INT_STOP(int)   loadInterruptStop(int, _loadInterruptStart)
+#endif
+
+#endif // #if defined(DEBUG_LOAD) && defined(__cplusplus)
+
+#if !defined(DEBUG_LOAD) || !defined(__cplusplus) || defined(SIMU)
+#define DEBUG_LOAD_SAMPLE()
+#define DEBUG_LOAD_INT_START()
+#define DEBUG_LOAD_INT_STOP(int)
+#endif
 
 
 #if defined(DEBUG_TIMERS)
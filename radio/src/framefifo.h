@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _FRAMEFIFO_H_
+#define _FRAMEFIFO_H_
+
+#include <inttypes.h>
+
+// Fifo of N buffers of SIZE bytes, each holding one received chunk (typically what a DMA
+// received until the line went idle). The receiver fills writeBuffer() in place and commits it,
+// the reader parses the chunk in place and pops it: no byte is copied.
+// One buffer is always owned by the receiver, so N-1 chunks can wait for the reader.
+template <int N, int SIZE>
+class FrameFifo
+{
+  static_assert((N > 1) & !(N & (N - 1)), "FrameFifo size must be a power of two!");
+
+  public:
+    FrameFifo():
+      widx(0),
+      ridx(0),
+      overruns(0)
+    {
+    }
+
+    void clear()
+    {
+      widx = ridx = 0;
+    }
+
+    uint8_t * writeBuffer()
+    {
+      return frames[widx];
+    }
+
+    // Receiver side: len bytes were written in writeBuffer(), returns the buffer to fill next
+    // (the same one if the fifo is full, the chunk is then dropped)
+    uint8_t * commit(uint32_t len)
+    {
+      if (len > 0) {
+        uint32_t next = nextIndex(widx);
+        if (next != ridx) {
+          lengths[widx] = len;
+          widx = next;
+        }
+        else {
+          overruns++;
+        }
+      }
+      return frames[widx];
+    }
+
+    // Reader side: the chunk stays valid until pop()
+    bool peek(const uint8_t * & frame, uint32_t & len) const
+    {
+      if (isEmpty()) {
+        return false;
+      }
+      else {
+        frame = frames[ridx];
+        len = lengths[ridx];
+        return true;
+      }
+    }
+
+    void pop()
+    {
+      if (!isEmpty()) {
+        ridx = nextIndex(ridx);
+      }
+    }
+
+    bool isEmpty() const
+    {
+      return (ridx == widx);
+    }
+
+    uint32_t getOverruns() const
+    {
+      return overruns;
+    }
+
+  protected:
+    uint8_t frames[N][SIZE];
+    uint16_t lengths[N];
+    volatile uint32_t widx;
+    volatile uint32_t ridx;
+    uint32_t overruns;
+
+    static inline uint32_t nextIndex(uint32_t idx)
+    {
+      return (idx + 1) & (N - 1);
+    }
+};
+
+#endif // _FRAMEFIFO_H_
@@ -127,6 +127,86 @@ bool isRepeatDelayElapsed(const CustomFunctionData * functions, CustomFunctionsC
 #define VOLUME_HYSTERESIS 10            // how much must a input value change to actually be considered for new volume setting
 getvalue_t requiredSpeakerVolumeRawLast = 1024 + 1; //initial value must be outside normal range
 
+#if defined(OVERRIDE_CHANNEL_FUNCTION)
+static_assert(MAX_OUTPUT_CHANNELS <= 32, "The overridden channels don't fit in a 32 bits mask");
+static uint32_t overriddenChannels = (uint32_t)-1;  // the safetyCh[] set since the last reset
+#endif
+
+#if defined(GVARS)
+static uint8_t gvarTrims = (uint8_t)-1;  // the trimGvar[] set since the last reset
+#endif
+
+// groups the functions by trigger switch, so that each switch is read once per evaluation
+static void buildFunctionsIndex(const CustomFunctionData * functions, CustomFunctionsContext & functionsContext)
+{
+  functionsContext.switchesCount = 0;
+  functionsContext.configuredFunctions = 0;
+  functionsContext.midposDelaySwitches = 0;
+
+  for (uint8_t i=0; i<MAX_SPECIAL_FUNCTIONS; i++) {
+    const CustomFunctionData * cfn = &functions[i];
+    swsrc_t swtch = CFN_SWITCH(cfn);
+    if (!swtch) {
+      continue;
+    }
+
+    bool midposDelay = IS_PLAY_FUNC(CFN_FUNC(cfn));
+    uint8_t index = 0;
+    while (index < functionsContext.switchesCount &&
+           (CFN_SWITCH(&functions[functionsContext.switchFunction[index]]) != swtch || (bool)(functionsContext.midposDelaySwitches & ((MASK_CFN_TYPE)1 << index)) != midposDelay)) {
+      index++;
+    }
+    if (index == functionsContext.switchesCount) {
+      functionsContext.switchFunction[index] = i;
+      if (midposDelay) {
+        functionsContext.midposDelaySwitches |= ((MASK_CFN_TYPE)1 << index);
+      }
+      functionsContext.switchesCount++;
+    }
+
+    functionsContext.functionSwitch[i] = index;
+    functionsContext.configuredFunctions |= ((MASK_CFN_TYPE)1 << i);
+  }
+
+  functionsContext.indexValid = true;
+}
+
+// the functions may be edited while the index is built (the menus call storageDirty() before the write),
+// a few bit tests check that each function still has the switch and the type of its group
+static bool isFunctionsIndexValid(const CustomFunctionData * functions, const CustomFunctionsContext & functionsContext)
+{
+  if (!functionsContext.indexValid) {
+    return false;
+  }
+
+  for (uint8_t i=0; i<MAX_SPECIAL_FUNCTIONS; i++) {
+    const CustomFunctionData * cfn = &functions[i];
+    swsrc_t swtch = CFN_SWITCH(cfn);
+    bool configured = functionsContext.configuredFunctions & ((MASK_CFN_TYPE)1 << i);
+    if (!swtch || !configured) {
+      if (swtch || configured) {
+        return false;
+      }
+      continue;
+    }
+    uint8_t index = functionsContext.functionSwitch[i];
+    if (CFN_SWITCH(&functions[functionsContext.switchFunction[index]]) != swtch ||
+        (bool)(functionsContext.midposDelaySwitches & ((MASK_CFN_TYPE)1 << index)) != IS_PLAY_FUNC(CFN_FUNC(cfn))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*
+ Only the functions whose switch is on, and the ones which were active at the previous
+ evaluation (falling edge) are evaluated. The parameters are read at each evaluation,
+ the index only depends on the switch and the type of the functions, it is checked against them
+ at each evaluation.
+ The functions of IS_PLAY_BOTH_FUNC() would need to be evaluated with their switch off,
+ there are none.
+ */
 void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext & functionsContext)
 {
   MASK_FUNC_TYPE newActiveFunctions  = 0;
@@ -142,24 +222,49 @@ void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext
 #endif
 
 #if defined(OVERRIDE_CHANNEL_FUNCTION)
-  for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++) {
-    safetyCh[i] = OVERRIDE_CHANNEL_UNDEFINED;
+  for (uint8_t i=0; overriddenChannels && i<MAX_OUTPUT_CHANNELS; i++, overriddenChannels >>= 1) {
+    if (overriddenChannels & 1) {
+      safetyCh[i] = OVERRIDE_CHANNEL_UNDEFINED;
+    }
   }
+  overriddenChannels = 0;
 #endif
 
 #if defined(GVARS)
-  for (uint8_t i=0; i<NUM_TRIMS; i++) {
-    trimGvar[i] = -1;
+  for (uint8_t i=0; gvarTrims && i<NUM_TRIMS; i++, gvarTrims >>= 1) {
+    if (gvarTrims & 1) {
+      trimGvar[i] = -1;
+    }
   }
+  gvarTrims = 0;
 #endif
 
-  for (uint8_t i=0; i<MAX_SPECIAL_FUNCTIONS; i++) {
-    const CustomFunctionData * cfn = &functions[i];
-    swsrc_t swtch = CFN_SWITCH(cfn);
-    if (swtch) {
+  if (!isFunctionsIndexValid(functions, functionsContext)) {
+    buildFunctionsIndex(functions, functionsContext);
+  }
+
+  MASK_CFN_TYPE switchesOn = 0;
+  for (uint8_t i=0; i<functionsContext.switchesCount; i++) {
+    if (getSwitch(CFN_SWITCH(&functions[functionsContext.switchFunction[i]]), (functionsContext.midposDelaySwitches & ((MASK_CFN_TYPE)1 << i)) ? GETSWITCH_MIDPOS_DELAY : 0)) {
+      switchesOn |= ((MASK_CFN_TYPE)1 << i);
+    }
+  }
+
+  MASK_CFN_TYPE triggered = 0;
+  MASK_CFN_TYPE configured = functionsContext.configuredFunctions;
+  for (uint8_t i=0; configured; i++, configured >>= 1) {
+    if ((configured & 1) && (switchesOn & ((MASK_CFN_TYPE)1 << functionsContext.functionSwitch[i]))) {
+      triggered |= ((MASK_CFN_TYPE)1 << i);
+    }
+  }
+
+  MASK_CFN_TYPE evaluated = (triggered | functionsContext.activeSwitches) & functionsContext.configuredFunctions;
+  for (uint8_t i=0; evaluated; i++, evaluated >>= 1) {
+    if (evaluated & 1) {
+      const CustomFunctionData * cfn = &functions[i];
       MASK_CFN_TYPE switch_mask = ((MASK_CFN_TYPE)1 << i);
 
-      bool active = getSwitch(swtch, IS_PLAY_FUNC(CFN_FUNC(cfn)) ? GETSWITCH_MIDPOS_DELAY : 0);
+      bool active = (triggered & switch_mask);
 
       if (HAS_ENABLE_PARAM(CFN_FUNC(cfn))) {
         active &= (bool)CFN_ACTIVE(cfn);
@@ -172,6 +277,7 @@ void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext
 #if defined(OVERRIDE_CHANNEL_FUNCTION)
           case FUNC_OVERRIDE_CHANNEL:
             safetyCh[CFN_CH_INDEX(cfn)] = CFN_PARAM(cfn);
+            overriddenChannels |= (1u << CFN_CH_INDEX(cfn));
             break;
 #endif
 
@@ -264,6 +370,7 @@ void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext
             }
             else if (CFN_PARAM(cfn) >= MIXSRC_FIRST_TRIM && CFN_PARAM(cfn) <= MIXSRC_LAST_TRIM) {
               trimGvar[CFN_PARAM(cfn)-MIXSRC_FIRST_TRIM] = CFN_GVAR_INDEX(cfn);
+              gvarTrims |= (1 << (CFN_PARAM(cfn)-MIXSRC_FIRST_TRIM));
             }
 #if defined(ROTARY_ENCODERS)
             else if (CFN_PARAM(cfn) >= MIXSRC_REa && CFN_PARAM(cfn) < MIXSRC_TrimRud) {
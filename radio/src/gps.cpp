@@ -54,6 +54,11 @@ gpsdata_t gpsData;
      // added by Mis
      - GPS altitude (for OSD displaying)
      - GPS speed (for OSD displaying)
+
+   u-blox receivers are switched to the UBX binary protocol as soon as they are
+   seen sending NMEA: one NAV-PVT frame then gives all the data at GPS_UBX_RATE
+   without any ASCII conversion. The NMEA parser takes over again when no NAV-PVT
+   is received anymore (receiver power cycled, or not a u-blox one).
 */
 
 #define NO_FRAME   0
@@ -253,6 +258,10 @@ bool gpsNewFrameNMEA(char c)
                            ((string[1] >= 'A') ? string[1] - 'A' + 10 : string[1] - '0');
         if (checksum == parity) {
           gpsData.packetCount++;
+          if (gpsProtocol != GPS_PROTOCOL_NMEA) {
+            // the receiver outputs NAV-PVT, the sentences it still sends are ignored
+            gps_frame = NO_FRAME;
+          }
           switch (gps_frame) {
             case FRAME_GGA:
               frameOK = 1;
@@ -302,8 +311,198 @@ bool gpsNewFrameNMEA(char c)
   return frameOK;
 }
 
+#define UBX_SYNC1                 0xB5
+#define UBX_SYNC2                 0x62
+#define UBX_CLASS_NAV             0x01
+#define UBX_CLASS_CFG             0x06
+#define UBX_CLASS_NMEA            0xF0
+#define UBX_NAV_PVT               0x07
+#define UBX_CFG_MSG               0x01
+#define UBX_CFG_RATE              0x08
+#define UBX_NMEA_GGA              0x00
+#define UBX_NMEA_RMC              0x04
+#define UBX_NAV_PVT_MIN_LENGTH    84   // u-blox 7 (u-blox 8 and later: 92)
+#define UBX_MAX_PAYLOAD           100
+
+#define GPS_UBX_TIMEOUT           200  // 10ms units, no NAV-PVT for 2s: back to NMEA
+#define GPS_UBX_RETRY_PERIOD      200  // 10ms units
+#define GPS_UBX_MAX_RETRIES       3
+
+enum UbxStates {
+  UBX_IDLE,
+  UBX_HEADER,
+  UBX_CLASS,
+  UBX_ID,
+  UBX_LENGTH1,
+  UBX_LENGTH2,
+  UBX_PAYLOAD,
+  UBX_CK_A,
+  UBX_CK_B,
+};
+
+uint8_t gpsProtocol = GPS_PROTOCOL_NMEA;
+uint8_t gpsUbxRate = GPS_UBX_RATE;
+
+static struct {
+  uint8_t state;
+  uint8_t msgClass;
+  uint8_t msgId;
+  uint8_t ckA;
+  uint8_t ckB;
+  uint16_t length;
+  uint16_t offset;
+  uint8_t payload[UBX_MAX_PAYLOAD];
+} ubx;
+
+static tmr10ms_t ubxLastFrame;
+static tmr10ms_t ubxLastRetry;
+static uint8_t ubxRetries;
+
+static inline void ubxChecksum(uint8_t c)
+{
+  ubx.ckA += c;
+  ubx.ckB += ubx.ckA;
+}
+
+static inline uint16_t ubxU16(const uint8_t * p)
+{
+  return p[0] | (p[1] << 8);
+}
+
+static inline int32_t ubxI32(const uint8_t * p)
+{
+  return (int32_t)(p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24));
+}
+
+static void gpsSetNMEARate(uint8_t msgId, uint8_t rate)
+{
+  const uint8_t payload[] = { UBX_CLASS_NMEA, msgId, rate };
+  gpsSendUBX(UBX_CLASS_CFG, UBX_CFG_MSG, payload, sizeof(payload));
+}
+
+// NAV-PVT payload, converted to the units of the NMEA parser
+static void gpsDecodeNavPvt(const uint8_t * payload)
+{
+  uint8_t valid = payload[11];
+  uint8_t fixType = payload[20];
+  uint8_t fix = (payload[21] & 0x01) && fixType >= 2 && fixType <= 4;
+
+  gpsData.fix = fix;
+  gpsData.numSat = payload[23];
+  if (fix) {
+    __disable_irq();    // do the atomic update of lat/lon
+    gpsData.longitude = ubxI32(&payload[24]) / 10;            // 1e-7 deg
+    gpsData.latitude = ubxI32(&payload[28]) / 10;
+    gpsData.altitude = ubxI32(&payload[36]) / 1000;           // mm above MSL
+    __enable_irq();
+  }
+  gpsData.speed = ubxI32(&payload[60]) / 10;                  // mm/s
+  gpsData.groundCourse = ubxI32(&payload[64]) / 10000;        // 1e-5 deg
+
+#if defined(RTCLOCK)
+  // set RTC clock if needed (UTC date and time both valid)
+  if (g_eeGeneral.adjustRTC && fix && (valid & 0x03) == 0x03) {
+    rtcAdjust(ubxU16(&payload[4]), payload[6], payload[7], payload[8], payload[9], payload[10]);
+  }
+#else
+  (void)valid;
+#endif
+}
+
+bool gpsNewFrameUBX(uint8_t c)
+{
+  switch (ubx.state) {
+    case UBX_IDLE:
+      if (c == UBX_SYNC1)
+        ubx.state = UBX_HEADER;
+      return false;
+
+    case UBX_HEADER:
+      ubx.state = (c == UBX_SYNC2 ? UBX_CLASS : (c == UBX_SYNC1 ? UBX_HEADER : UBX_IDLE));
+      ubx.ckA = ubx.ckB = 0;
+      return false;
+
+    case UBX_CLASS:
+      ubx.msgClass = c;
+      ubxChecksum(c);
+      ubx.state = UBX_ID;
+      return false;
+
+    case UBX_ID:
+      ubx.msgId = c;
+      ubxChecksum(c);
+      ubx.state = UBX_LENGTH1;
+      return false;
+
+    case UBX_LENGTH1:
+      ubx.length = c;
+      ubxChecksum(c);
+      ubx.state = UBX_LENGTH2;
+      return false;
+
+    case UBX_LENGTH2:
+      ubx.length |= c << 8;
+      if (ubx.length > UBX_MAX_PAYLOAD) {
+        // not a message we use (or a corrupted length), the next bytes are parsed again
+        ubx.state = UBX_IDLE;
+        gpsData.errorCount++;
+        return false;
+      }
+      ubxChecksum(c);
+      ubx.offset = 0;
+      ubx.state = (ubx.length > 0 ? UBX_PAYLOAD : UBX_CK_A);
+      return false;
+
+    case UBX_PAYLOAD:
+      ubx.payload[ubx.offset] = c;
+      ubxChecksum(c);
+      if (++ubx.offset == ubx.length)
+        ubx.state = UBX_CK_A;
+      return false;
+
+    case UBX_CK_A:
+      ubx.state = (c == ubx.ckA ? UBX_CK_B : UBX_IDLE);
+      if (ubx.state == UBX_IDLE)
+        gpsData.errorCount++;
+      return false;
+
+    case UBX_CK_B:
+      ubx.state = UBX_IDLE;
+      if (c != ubx.ckB) {
+        gpsData.errorCount++;
+        return false;
+      }
+      gpsData.packetCount++;
+      if (ubx.msgClass == UBX_CLASS_NAV && ubx.msgId == UBX_NAV_PVT &&
+          ubx.length >= UBX_NAV_PVT_MIN_LENGTH) {
+        gpsDecodeNavPvt(ubx.payload);
+        return true;
+      }
+      return false;
+  }
+
+  ubx.state = UBX_IDLE;
+  return false;
+}
+
 bool gpsNewFrame(uint8_t c)
 {
+  // UBX frames start with a byte which is never found in NMEA sentences,
+  // the bytes of a UBX frame are kept away from the NMEA parser
+  if (c == UBX_SYNC1 || ubx.state != UBX_IDLE) {
+    if (gpsNewFrameUBX(c)) {
+      ubxLastFrame = get_tmr10ms();
+      if (gpsProtocol != GPS_PROTOCOL_UBX) {
+        TRACE("GPS: UBX");
+        gpsProtocol = GPS_PROTOCOL_UBX;
+        gpsSetNMEARate(UBX_NMEA_GGA, 0);
+        gpsSetNMEARate(UBX_NMEA_RMC, 0);
+      }
+      return true;
+    }
+    return false;
+  }
+
   return gpsNewFrameNMEA(c);
 }
 
@@ -312,6 +511,17 @@ void gpsNewData(uint8_t c)
   if (!gpsNewFrame(c)) {
     return;
   }
+
+  // NMEA frame received: try to switch the receiver to UBX (a few times only,
+  // it may not be a u-blox one)
+  if (gpsProtocol == GPS_PROTOCOL_NMEA && ubxRetries < GPS_UBX_MAX_RETRIES) {
+    tmr10ms_t now = get_tmr10ms();
+    if (ubxRetries == 0 || (tmr10ms_t)(now - ubxLastRetry) >= GPS_UBX_RETRY_PERIOD) {
+      ubxLastRetry = now;
+      ubxRetries++;
+      gpsConfigureUBX(gpsUbxRate);
+    }
+  }
 }
 
 void gpsWakeup()
@@ -320,6 +530,13 @@ void gpsWakeup()
   while (gpsGetByte(&byte)) {
     gpsNewData(byte);
   }
+
+  if (gpsProtocol == GPS_PROTOCOL_UBX && (tmr10ms_t)(get_tmr10ms() - ubxLastFrame) >= GPS_UBX_TIMEOUT) {
+    TRACE("GPS: NMEA");
+    gpsProtocol = GPS_PROTOCOL_NMEA;
+    gpsData.fix = 0;
+    ubxRetries = 0;
+  }
 }
 
 char hex(uint8_t b) {
@@ -343,3 +560,33 @@ void gpsSendFrame(const char * frame)
   gpsSendByte('\n');
   TRACE("*%02x", parity);
 }
+
+void gpsSendUBX(uint8_t msgClass, uint8_t msgId, const uint8_t * payload, uint16_t length)
+{
+  // send given frame, add header and checksum
+  uint8_t ckA = 0, ckB = 0;
+  const uint8_t header[] = { msgClass, msgId, uint8_t(length), uint8_t(length >> 8) };
+  TRACE("gps> UBX %02x %02x (%d bytes)", msgClass, msgId, length);
+  gpsSendByte(UBX_SYNC1);
+  gpsSendByte(UBX_SYNC2);
+  for (uint16_t i = 0; i < sizeof(header) + length; i++) {
+    uint8_t c = (i < sizeof(header) ? header[i] : payload[i - sizeof(header)]);
+    ckA += c;
+    ckB += ckA;
+    gpsSendByte(c);
+  }
+  gpsSendByte(ckA);
+  gpsSendByte(ckB);
+}
+
+void gpsConfigureUBX(uint8_t rate)
+{
+  // measurement period in ms, one navigation solution per measurement, GPS time reference
+  uint16_t period = 1000 / (rate > 0 ? rate : 1);
+  const uint8_t cfgRate[] = { uint8_t(period), uint8_t(period >> 8), 0x01, 0x00, 0x01, 0x00 };
+  gpsSendUBX(UBX_CLASS_CFG, UBX_CFG_RATE, cfgRate, sizeof(cfgRate));
+
+  // NAV-PVT on each navigation solution, on the port receiving this message
+  const uint8_t cfgMsg[] = { UBX_CLASS_NAV, UBX_NAV_PVT, 0x01 };
+  gpsSendUBX(UBX_CLASS_CFG, UBX_CFG_MSG, cfgMsg, sizeof(cfgMsg));
+}
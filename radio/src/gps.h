@@ -32,14 +32,35 @@ struct gpsdata_t
   uint8_t numSat;
   uint32_t packetCount;
   uint32_t errorCount;
-  uint16_t altitude;              // altitude in 0.1m
-  uint16_t speed;                 // speed in 0.1m/s
+  uint16_t altitude;              // altitude in m
+  uint16_t speed;                 // speed in cm/s
   uint16_t groundCourse;          // degrees * 10
 };
 
+// NAV-PVT update rate once the receiver is switched to UBX, a NAV-PVT frame
+// takes ~1000 bits on the serial link
+#if !defined(GPS_UBX_RATE)
+  #if GPS_USART_BAUDRATE > 9600
+    #define GPS_UBX_RATE               10
+  #else
+    #define GPS_UBX_RATE               5
+  #endif
+#endif
+
+enum GpsProtocols {
+  GPS_PROTOCOL_NMEA,
+  GPS_PROTOCOL_UBX,
+};
+
 extern gpsdata_t gpsData;
+extern uint8_t gpsProtocol;
+extern uint8_t gpsUbxRate;
+
 void gpsWakeup();
+void gpsNewData(uint8_t c);
 
 void gpsSendFrame(const char * frame);
+void gpsSendUBX(uint8_t msgClass, uint8_t msgId, const uint8_t * payload, uint16_t length);
+void gpsConfigureUBX(uint8_t rate);
 
 #endif // _GPS_H_
@@ -72,7 +72,7 @@ uint8_t getExpoMixCount(uint8_t expo)
 bool reachExpoMixCountLimit(uint8_t expo)
 {
   // check mixers count limit
-  if (getExpoMixCount(expo) >= (expo ? MAX_EXPOS : MAX_MIXERS)) {
+  if (expo ? !hasFreeExpo() : !hasFreeMix()) {
     POPUP_WARNING(expo ? STR_NOFREEEXPO : STR_NOFREEMIXER);
     return true;
   }
@@ -83,14 +83,10 @@ void deleteExpoMix(uint8_t expo, uint8_t idx)
 {
   pauseMixerCalculations();
   if (expo) {
-    ExpoData *expo = expoAddress(idx);
-    memmove(expo, expo+1, (MAX_EXPOS-(idx+1))*sizeof(ExpoData));
-    memclear(&g_model.expoData[MAX_EXPOS-1], sizeof(ExpoData));
+    deleteExpoData(idx);
   }
   else {
-    MixData *mix = mixAddress(idx);
-    memmove(mix, mix+1, (MAX_MIXERS-(idx+1))*sizeof(MixData));
-    memclear(&g_model.mixData[MAX_MIXERS-1], sizeof(MixData));
+    deleteMixData(idx);
   }
   resumeMixerCalculations();
   storageDirty(EE_MODEL);
@@ -102,17 +98,13 @@ void insertExpoMix(uint8_t expo, uint8_t idx)
 {
   pauseMixerCalculations();
   if (expo) {
-    ExpoData *expo = expoAddress(idx);
-    memmove(expo+1, expo, (MAX_EXPOS-(idx+1))*sizeof(ExpoData));
-    memclear(expo, sizeof(ExpoData));
+    ExpoData *expo = insertExpoData(idx);
     expo->mode = 3; // pos&neg
     expo->chn = s_currCh - 1;
     expo->weight = 100;
   }
   else {
-    MixData *mix = mixAddress(idx);
-    memmove(mix+1, mix, (MAX_MIXERS-(idx+1))*sizeof(MixData));
-    memclear(mix, sizeof(MixData));
+    MixData *mix = insertMixData(idx);
     mix->destCh = s_currCh-1;
     mix->srcRaw = (s_currCh > 4 ? MIXSRC_Rud - 1 + s_currCh : MIXSRC_Rud - 1 + channelOrder(s_currCh));
     mix->weight = 100;
@@ -125,12 +117,12 @@ void copyExpoMix(uint8_t expo, uint8_t idx)
 {
   pauseMixerCalculations();
   if (expo) {
-    ExpoData *expo = expoAddress(idx);
-    memmove(expo+1, expo, (MAX_EXPOS-(idx+1))*sizeof(ExpoData));
+    ExpoData *expo = insertExpoData(idx+1);
+    if (expo) memcpy(expo, expoAddress(idx), sizeof(ExpoData));
   }
   else {
-    MixData *mix = mixAddress(idx);
-    memmove(mix+1, mix, (MAX_MIXERS-(idx+1))*sizeof(MixData));
+    MixData *mix = insertMixData(idx+1);
+    if (mix) memcpy(mix, mixAddress(idx), sizeof(MixData));
   }
   resumeMixerCalculations();
   storageDirty(EE_MODEL);
@@ -812,7 +804,7 @@ void menuModelExpoMix(uint8_t expo, event_t event)
             }
           }
         }
-        cur++; y+=FH; mixCnt++; i++; if (expo) ed++; else md++;
+        cur++; y+=FH; mixCnt++; i++; if (expo) ed = expoAddress(i); else md = mixAddress(i);
       } while (expo ? (i<MAX_EXPOS && ed->chn+1 == ch && EXPO_VALID(ed)) : (i<MAX_MIXERS && md->srcRaw && md->destCh+1 == ch));
       if (s_copyMode == MOVE_MODE && menuVerticalOffset < cur && cur-menuVerticalOffset < LCD_LINES && s_copySrcCh == ch && i == (s_copySrcIdx + (s_copyTgtOfs<0))) {
         lcdDrawRect(expo ? EXPO_LINE_SELECT_POS : 22, y-1, expo ? LCD_W-EXPO_LINE_SELECT_POS : LCD_W-22, 9, DOTTED);
@@ -113,6 +113,7 @@ void menuStatisticsView(event_t event)
   #define MENU_DEBUG_Y_USB             (2*FH)
   #define MENU_DEBUG_Y_LUA             (3*FH)
   #define MENU_DEBUG_Y_FREE_RAM        (4*FH)
+  #define MENU_DEBUG_ROW3              (3*FH+1)
 
 void menuStatisticsDebug(event_t event)
 {
@@ -250,6 +251,9 @@ void menuStatisticsDebug2(event_t event)
   switch (event) {
     case EVT_KEY_FIRST(KEY_ENTER):
       telemetryErrors  = 0;
+#if defined(DEBUG_LOAD)
+      loadResetMax();
+#endif
       break;
 
     case EVT_KEY_FIRST(KEY_UP):
@@ -279,6 +283,31 @@ void menuStatisticsDebug2(event_t event)
   lcdDrawTextAlignedLeft(MENU_DEBUG_ROW2, "BT status");
   lcdDrawNumber(MENU_DEBUG_COL1_OFS, MENU_DEBUG_ROW2, IS_BLUETOOTH_CHIP_PRESENT(), RIGHT);
 #endif
+#endif
+#if defined(DEBUG_LOAD)
+  // the load over the last second
+  static LoadCounters loadCounters;
+  static LoadReport loadReport;
+  static tmr10ms_t loadReportTime;
+  if ((tmr10ms_t)(get_tmr10ms() - loadReportTime) >= 100) {
+    loadReportTime = get_tmr10ms();
+    loadGetReport(loadReport, loadCounters);
+  }
+  static const uint8_t loadTasks[] = { LOAD_TASK_MIXER, LOAD_TASK_MENUS, LOAD_TASK_IDLE };
+  coord_t y = MENU_DEBUG_ROW3;
+  for (uint8_t i = 0; i < DIM(loadTasks); i++, y += FH) {
+    lcdDrawText(0, y, "CPU ");
+    lcdDrawText(lcdLastRightPos, y, loadTaskNames[loadTasks[i]]);
+    lcdDrawNumber(MENU_DEBUG_COL1_OFS + FW, y, loadReport.tasks[loadTasks[i]], PREC1|RIGHT);
+    lcdDrawChar(lcdLastRightPos, y, '%');
+  }
+  uint16_t interruptMax = 0;
+  for (uint8_t i = 0; i < LOAD_INT_COUNT; i++) {
+    interruptMax = max(interruptMax, loadReport.interruptsMax[i]);
+  }
+  lcdDrawText(0, y, "Int. max");
+  lcdDrawNumber(MENU_DEBUG_COL1_OFS + FW, y, interruptMax, RIGHT);
+  lcdDrawText(lcdLastRightPos, y, "us");
 #endif
   lcdDrawText(4*FW, 7*FH+1, STR_MENUTORESET);
   lcdInvertLastLine();
@@ -37,6 +37,108 @@ void BitmapBuffer::drawAlphaPixel(display_t * p, uint8_t opacity, uint16_t color
   }
 }
 
+// Puts the bytes decoded from a RLE bitmap in place: the bitmap data is in the same
+// order as the frame buffer data (rotated by 180° on X10 hardware for both)
+class RlePixelWriter
+{
+  public:
+    RlePixelWriter(uint16_t * dest, coord_t destw, coord_t desth, coord_t x, coord_t y, coord_t w):
+      dest(dest),
+      destw(destw),
+      desth(desth),
+      x(x),
+      y(y),
+      w(w),
+      col(0),
+      row(0),
+      low(0),
+      half(false)
+    {
+    }
+
+    void putByte(uint8_t value)
+    {
+      if (half) {
+        putPixels(low | (value << 8), 1);
+        half = false;
+      }
+      else {
+        low = value;
+        half = true;
+      }
+    }
+
+    void putRun(uint8_t value, uint32_t count)
+    {
+      if (half && count > 0) {
+        putByte(value);
+        count--;
+      }
+      putPixels(value | (value << 8), count / 2);
+      if (count & 1) {
+        putByte(value);
+      }
+    }
+
+  protected:
+    uint16_t * dest;
+    coord_t destw;
+    coord_t desth;
+    coord_t x;
+    coord_t y;
+    coord_t w;
+    coord_t col;
+    coord_t row;
+    uint8_t low;
+    bool half;
+
+    void putPixels(uint16_t value, uint32_t count)
+    {
+      while (count > 0) {
+        coord_t n = min<uint32_t>(count, w - col);
+        fillSpan(value, x + col, y + row, n);
+        count -= n;
+        col += n;
+        if (col == w) {
+          col = 0;
+          row++;
+        }
+      }
+    }
+
+    // one row span, clipped
+    void fillSpan(uint16_t value, coord_t x1, coord_t y1, coord_t n)
+    {
+      if (y1 < 0 || y1 >= desth)
+        return;
+      coord_t x2 = min<coord_t>(x1 + n, destw);
+      if (x1 < 0)
+        x1 = 0;
+      for (uint16_t * p = dest + y1 * destw + x1, * end = p + (x2 - x1); p < end; p++) {
+        *p = value;
+      }
+    }
+};
+
+void BitmapBuffer::drawRleBitmap(coord_t x, coord_t y, const uint8_t * rle_data)
+{
+  if (!data)
+    return;
+
+  coord_t w = *((uint16_t *)rle_data);
+  coord_t h = *(((uint16_t *)rle_data)+1);
+
+#if defined(PCBX10) && !defined(SIMU)
+  x = width - (x + w);
+  y = height - (y + h);
+#endif
+
+  RlePixelWriter writer(data, width, height, x, y, w);
+  if (rle_decode_8bit_stream(writer, w * h * sizeof(uint16_t), rle_data + 4) < 0) {
+    TRACE("drawRleBitmap: corrupted bitmap");
+  }
+}
+
 void BitmapBuffer::drawHorizontalLine(coord_t x, coord_t y, coord_t w, uint8_t pat, LcdFlags att)
 {
   if (y >= height) return;
@@ -493,13 +595,161 @@ void BitmapBuffer::drawBitmapPatternPie(coord_t x0, coord_t y0, const uint8_t *
 
 #if !defined(BOOT)
 
+/*
+ The decoded bitmaps are kept in a cache (in SDRAM) bounded to BITMAP_CACHE_SIZE bytes, keyed
+ by the path and validated by the date and size of the file. load() returns a copy, as the
+ callers own (and sometimes modify) the bitmap they get.
+ A bitmap may also be pre-converted on a PC (radio/util/img2raw.py) into a raw file next to
+ it (<filename>.raw), which is read directly into the buffer without any decoding.
+ */
+
+#if !defined(BITMAP_CACHE_SIZE)
+  #define BITMAP_CACHE_SIZE            (1024 * 1024)
+#endif
+#define BITMAP_CACHE_ENTRIES           16
+
+#define RAW_BITMAP_EXT                 ".raw"
+
+PACK(struct RawBitmapHeader {
+  char magic[4];        // "OTXB"
+  uint8_t format;       // BitmapFormats
+  uint8_t spare1;
+  uint16_t width;
+  uint16_t height;
+  uint16_t spare2;
+  uint32_t sourceSize;  // size of the image it was converted from, to detect a stale file
+});
+
+static BitmapBuffer * copyBitmap(const BitmapBuffer * bitmap)
+{
+  BitmapBuffer * result = new BitmapBuffer(bitmap->getFormat(), bitmap->getWidth(), bitmap->getHeight());
+  if (result && !result->getData()) {
+    delete result;
+    return nullptr;
+  }
+  if (result) {
+    memcpy(result->getData(), bitmap->getData(), bitmap->getDataSize());
+  }
+  return result;
+}
+
+class BitmapCache
+{
+  public:
+    BitmapBuffer * find(const char * filename, const FILINFO & info)
+    {
+      for (auto & entry: entries) {
+        if (entry.bitmap && !strcmp(entry.path, filename)) {
+          if (entry.fdate == info.fdate && entry.ftime == info.ftime && entry.fsize == info.fsize) {
+            entry.lastUse = ++useCounter;
+            return copyBitmap(entry.bitmap);
+          }
+          remove(entry);
+          break;
+        }
+      }
+      return nullptr;
+    }
+
+    void add(const char * filename, const FILINFO & info, const BitmapBuffer * bitmap)
+    {
+      uint32_t size = bitmap->getDataSize();
+      if (size > BITMAP_CACHE_SIZE / 2) {
+        return;
+      }
+
+      // evict the least recently used bitmaps
+      Entry * entry;
+      while ((entry = getFreeEntry()) == nullptr || totalSize + size > BITMAP_CACHE_SIZE) {
+        Entry * lru = nullptr;
+        for (auto & e: entries) {
+          if (e.bitmap && (!lru || e.lastUse < lru->lastUse)) {
+            lru = &e;
+          }
+        }
+        if (!lru) {
+          return;
+        }
+        remove(*lru);
+      }
+
+      entry->path = strdup(filename);
+      entry->bitmap = copyBitmap(bitmap);
+      if (!entry->path || !entry->bitmap) {
+        remove(*entry);
+        return;
+      }
+      entry->fdate = info.fdate;
+      entry->ftime = info.ftime;
+      entry->fsize = info.fsize;
+      entry->lastUse = ++useCounter;
+      totalSize += size;
+    }
+
+  protected:
+    struct Entry {
+      char * path;
+      BitmapBuffer * bitmap;
+      uint32_t fsize;
+      uint32_t lastUse;
+      uint16_t fdate;
+      uint16_t ftime;
+    };
+
+    Entry entries[BITMAP_CACHE_ENTRIES] = {};
+    uint32_t totalSize = 0;
+    uint32_t useCounter = 0;
+
+    Entry * getFreeEntry()
+    {
+      for (auto & entry: entries) {
+        if (!entry.bitmap && !entry.path) {
+          return &entry;
+        }
+      }
+      return nullptr;
+    }
+
+    void remove(Entry & entry)
+    {
+      if (entry.bitmap) {
+        totalSize -= entry.bitmap->getDataSize();
+        delete entry.bitmap;
+      }
+      free(entry.path);
+      entry.bitmap = nullptr;
+      entry.path = nullptr;
+    }
+};
+
+static BitmapCache bitmapCache;
+
 BitmapBuffer * BitmapBuffer::load(const char * filename)
 {
-  const char * ext = getFileExtension(filename);
-  if (ext && !strcmp(ext, ".bmp"))
-    return load_bmp(filename);
-  else
-    return load_stb(filename);
+  FILINFO info;
+  if (f_stat(filename, &info) != FR_OK) {
+    return nullptr;
+  }
+
+  BitmapBuffer * bitmap = bitmapCache.find(filename, info);
+  if (bitmap) {
+    return bitmap;
+  }
+
+  bitmap = load_raw(filename, info.fsize);
+  if (!bitmap) {
+    const char * ext = getFileExtension(filename);
+    if (ext && !strcmp(ext, ".bmp"))
+      bitmap = load_bmp(filename);
+    else
+      bitmap = load_stb(filename);
+  }
+
+  if (bitmap) {
+    bitmapCache.add(filename, info, bitmap);
+  }
+
+  return bitmap;
 }
 
 BitmapBuffer * BitmapBuffer::loadMask(const char * filename)
@@ -532,6 +782,59 @@ BitmapBuffer * BitmapBuffer::loadMaskOnBackground(const char * filename, LcdFlag
 
 FIL imgFile __DMA;
 
+BitmapBuffer * BitmapBuffer::load_raw(const char * filename, uint32_t sourceSize)
+{
+  char path[_MAX_LFN + 1];
+  if (strlen(filename) + sizeof(RAW_BITMAP_EXT) > sizeof(path)) {
+    return nullptr;
+  }
+  strAppend(strAppend(path, filename), RAW_BITMAP_EXT);
+
+  FRESULT result = f_open(&imgFile, path, FA_OPEN_EXISTING | FA_READ);
+  if (result != FR_OK) {
+    return nullptr;
+  }
+
+  UINT read;
+  RawBitmapHeader header;
+  result = f_read(&imgFile, &header, sizeof(header), &read);
+  if (result != FR_OK || read != sizeof(header) || memcmp(header.magic, "OTXB", 4) || header.sourceSize != sourceSize ||
+      (header.format != BMP_RGB565 && header.format != BMP_ARGB4444) ||
+      f_size(&imgFile) != sizeof(header) + header.width * header.height * sizeof(uint16_t)) {
+    TRACE("load_raw(%s) invalid or stale", path);
+    f_close(&imgFile);
+    return nullptr;
+  }
+
+  BitmapBuffer * bmp = new BitmapBuffer(header.format, header.width, header.height);
+  if (bmp == NULL || bmp->getData() == NULL) {
+    TRACE("load_raw() malloc failed");
+    delete bmp;
+    f_close(&imgFile);
+    return nullptr;
+  }
+
+  result = f_read(&imgFile, bmp->getData(), bmp->getDataSize(), &read);
+  f_close(&imgFile);
+  if (result != FR_OK || read != bmp->getDataSize()) {
+    delete bmp;
+    return nullptr;
+  }
+
+#if defined(PCBX10) && !defined(SIMU)
+  // the pixels are stored from the bottom right
+  display_t * first = bmp->getData();
+  display_t * last = first + header.width * header.height - 1;
+  while (first < last) {
+    display_t tmp = *first;
+    *first++ = *last;
+    *last-- = tmp;
+  }
+#endif
+
+  return bmp;
+}
+
 BitmapBuffer * BitmapBuffer::load_bmp(const char * filename)
 {
   UINT read;
@@ -109,28 +109,6 @@ class BitmapBufferBase
 
 typedef BitmapBufferBase<const uint16_t> Bitmap;
 
-class RLEBitmap:
-  public BitmapBufferBase<uint16_t>
-{
-public:
-  RLEBitmap(uint8_t format, const uint8_t* rle_data)
-    : BitmapBufferBase<uint16_t>(format, 0, 0, NULL)
-  {
-    width  = *((uint16_t *)rle_data);
-    height = *(((uint16_t *)rle_data)+1);
-
-    uint32_t pixels = width * height;
-    data = (uint16_t*)malloc(pixels * sizeof(uint16_t));
-    rle_decode_8bit((uint8_t*)data, pixels * sizeof(uint16_t), rle_data+4);
-    data_end = data + pixels;
-  }
-
-  ~RLEBitmap()
-  {
-    free(data);
-  }
-};
-
 class BitmapBuffer: public BitmapBufferBase<uint16_t>
 {
   private:
@@ -342,6 +320,10 @@ class BitmapBuffer: public BitmapBufferBase<uint16_t>
       }
     }
 
+    // RGB565 RLE bitmap (built-in bitmaps converted with the "rle" option), decoded
+    // straight into the buffer: no intermediate copy, runs become span fills
+    void drawRleBitmap(coord_t x, coord_t y, const uint8_t * rle_data);
+
     template<class T>
     void drawScaledBitmap(const T * bitmap, coord_t x, coord_t y, coord_t w, coord_t h)
     {
@@ -358,6 +340,7 @@ class BitmapBuffer: public BitmapBufferBase<uint16_t>
 #if !defined(BOOT)
     static BitmapBuffer * load_bmp(const char * filename);
     static BitmapBuffer * load_stb(const char * filename);
+    static BitmapBuffer * load_raw(const char * filename, uint32_t sourceSize);
 #endif
 };
 
@@ -66,7 +66,7 @@ uint8_t getExposCount()
 
 bool reachExposLimit()
 {
-  if (getExposCount() >= MAX_EXPOS) {
+  if (!hasFreeExpo()) {
     POPUP_WARNING(STR_NOFREEEXPO);
     return true;
   }
@@ -76,10 +76,8 @@ bool reachExposLimit()
 void deleteExpo(uint8_t idx)
 {
   pauseMixerCalculations();
-  ExpoData * expo = expoAddress(idx);
-  int input = expo->chn;
-  memmove(expo, expo+1, (MAX_EXPOS-(idx+1))*sizeof(ExpoData));
-  memclear(&g_model.expoData[MAX_EXPOS-1], sizeof(ExpoData));
+  int input = expoAddress(idx)->chn;
+  deleteExpoData(idx);
   if (!isInputAvailable(input)) {
     memclear(&g_model.inputNames[input], LEN_INPUT_NAME);
   }
@@ -92,9 +90,7 @@ int8_t s_currCh;
 void insertExpo(uint8_t idx)
 {
   pauseMixerCalculations();
-  ExpoData * expo = expoAddress(idx);
-  memmove(expo+1, expo, (MAX_EXPOS-(idx+1))*sizeof(ExpoData));
-  memclear(expo, sizeof(ExpoData));
+  ExpoData * expo = insertExpoData(idx);
   expo->srcRaw = (s_currCh > 4 ? MIXSRC_Rud - 1 + s_currCh : MIXSRC_Rud - 1 + channel_order(s_currCh));
   expo->curve.type = CURVE_REF_EXPO;
   expo->mode = 3; // pos+neg
@@ -107,8 +103,10 @@ void insertExpo(uint8_t idx)
 void copyExpo(uint8_t idx)
 {
   pauseMixerCalculations();
-  ExpoData * expo = expoAddress(idx);
-  memmove(expo+1, expo, (MAX_EXPOS-(idx+1))*sizeof(ExpoData));
+  ExpoData * expo = insertExpoData(idx+1);
+  if (expo) {
+    memcpy(expo, expoAddress(idx), sizeof(ExpoData));
+  }
   resumeMixerCalculations();
   storageDirty(EE_MODEL);
 }
@@ -538,7 +536,7 @@ bool menuModelExposAll(event_t event)
             }
           }
         }
-        cur++; y+=FH; mixCnt++; i++; ed++;
+        cur++; y+=FH; mixCnt++; i++; ed = expoAddress(i);
       } while (i<MAX_EXPOS && ed->chn+1 == ch && EXPO_VALID(ed));
       if (s_copyMode == MOVE_MODE && cur-menuVerticalOffset >= 0 && cur-menuVerticalOffset < NUM_BODY_LINES && s_copySrcCh == ch && i == (s_copySrcIdx + (s_copyTgtOfs<0))) {
         lineExpoSurround(y);
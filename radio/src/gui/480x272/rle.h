@@ -3,5 +3,35 @@
 
 int rle_decode_8bit(unsigned char* dest, unsigned int dest_size, const unsigned char* src);
 
+// Same decoding as rle_decode_8bit() without destination buffer: each literal byte
+// goes to output.putByte(value), each run of count bytes to output.putRun(value, count)
+template <class T>
+int rle_decode_8bit_stream(T & output, unsigned int dest_size, const unsigned char* src)
+{
+  unsigned char prev_byte = 0;
+  bool prev_byte_valid = false;
+  unsigned int remaining = dest_size;
+
+  while (remaining > 0) {
+    unsigned char value = *src++;
+    output.putByte(value);
+    remaining--;
+    if (prev_byte_valid && value == prev_byte) {
+      unsigned int count = *src++;
+      if (count > remaining) {
+        return -1;
+      }
+      output.putRun(value, count);
+      remaining -= count;
+      prev_byte_valid = false;
+    }
+    else {
+      prev_byte = value;
+      prev_byte_valid = true;
+    }
+  }
+
+  return dest_size;
+}
 
 #endif
@@ -22,10 +22,9 @@
 
 #if defined(SPLASH)
 
-const uint8_t __bmp_splash[] __ALIGNED(4) {
+const uint8_t __bmp_splash_rle[] __ALIGNED(4) {
 #include "bmp_splash.lbm"
 };
-Bitmap BMP_SPLASH(BMP_RGB565, (const uint16_t *)__bmp_splash);
 
 void drawSplash()
 {
@@ -50,9 +49,10 @@ void drawSplash()
                     splashImg);
   }
   else {
-    lcd->drawBitmap((LCD_W - BMP_SPLASH.getWidth())/2,
-                    (LCD_H - BMP_SPLASH.getHeight())/2,
-                    &BMP_SPLASH);
+    const uint16_t * size = (const uint16_t *)__bmp_splash_rle;
+    lcd->drawRleBitmap((LCD_W - size[0])/2,
+                       (LCD_H - size[1])/2,
+                       __bmp_splash_rle);
   }
   
   lcdRefresh();
@@ -99,6 +99,7 @@ bool menuStatsDebug(event_t event)
   {
     case EVT_KEY_FIRST(KEY_ENTER):
       maxMixerDuration  = 0;
+      storageMaxWriteDuration = 0;
 #if defined(LUA)
       maxLuaInterval = 0;
       maxLuaDuration = 0;
@@ -124,6 +125,14 @@ bool menuStatsDebug(event_t event)
   lcdDrawNumber(lcdNextPos+5, MENU_CONTENT_TOP+2*FH, audioStack.available(), LEFT);
   line++;
 
+  lcdDrawText(MENUS_MARGIN_LEFT, MENU_CONTENT_TOP+line*FH, "SD writes");
+  lcdDrawNumber(MENU_STATS_COLUMN1, MENU_CONTENT_TOP+line*FH, storageWriteCount, LEFT);
+  lcdDrawText(lcdNextPos+20, MENU_CONTENT_TOP+line*FH+1, "[Skip]", HEADER_COLOR|SMLSIZE);
+  lcdDrawNumber(lcdNextPos+5, MENU_CONTENT_TOP+line*FH, storageSkipCount, LEFT);
+  lcdDrawText(lcdNextPos+20, MENU_CONTENT_TOP+line*FH+1, "[Max]", HEADER_COLOR|SMLSIZE);
+  lcdDrawNumber(lcdNextPos+5, MENU_CONTENT_TOP+line*FH, 10*storageMaxWriteDuration, LEFT, 0, NULL, "ms");
+  ++line;
+
 #if defined(DISK_CACHE)
   lcdDrawText(MENUS_MARGIN_LEFT, MENU_CONTENT_TOP+line*FH, "SD cache hits");
   lcdDrawNumber(MENU_STATS_COLUMN1, MENU_CONTENT_TOP+line*FH, diskCache.getHitRate(), PREC1|LEFT, 0, NULL, "%");
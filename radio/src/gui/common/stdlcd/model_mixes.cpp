@@ -39,7 +39,7 @@ uint8_t getMixesCount()
 
 bool reachMixesLimit()
 {
-  if (getMixesCount() >= MAX_MIXERS) {
+  if (!hasFreeMix()) {
     POPUP_WARNING(STR_NOFREEMIXER);
     return true;
   }
@@ -49,9 +49,7 @@ bool reachMixesLimit()
 void deleteMix(uint8_t idx)
 {
   pauseMixerCalculations();
-  MixData * mix = mixAddress(idx);
-  memmove(mix, mix+1, (MAX_MIXERS-(idx+1))*sizeof(MixData));
-  memclear(&g_model.mixData[MAX_MIXERS-1], sizeof(MixData));
+  deleteMixData(idx);
   resumeMixerCalculations();
   storageDirty(EE_MODEL);
 }
@@ -59,9 +57,7 @@ void deleteMix(uint8_t idx)
 void insertMix(uint8_t idx)
 {
   pauseMixerCalculations();
-  MixData * mix = mixAddress(idx);
-  memmove(mix+1, mix, (MAX_MIXERS-(idx+1))*sizeof(MixData));
-  memclear(mix, sizeof(MixData));
+  MixData * mix = insertMixData(idx);
   mix->destCh = s_currCh-1;
   mix->srcRaw = s_currCh;
   if (!isSourceAvailable(mix->srcRaw)) {
@@ -78,8 +74,10 @@ void insertMix(uint8_t idx)
 void copyMix(uint8_t idx)
 {
   pauseMixerCalculations();
-  MixData * mix = mixAddress(idx);
-  memmove(mix+1, mix, (MAX_MIXERS-(idx+1))*sizeof(MixData));
+  MixData * mix = insertMixData(idx+1);
+  if (mix) {
+    memcpy(mix, mixAddress(idx), sizeof(MixData));
+  }
   resumeMixerCalculations();
   storageDirty(EE_MODEL);
 }
@@ -465,7 +463,7 @@ void menuModelMixAll(event_t event)
             }
           }
         }
-        cur++; y+=FH; mixCnt++; i++; md++;
+        cur++; y+=FH; mixCnt++; i++; md = mixAddress(i);
       } while (i<MAX_MIXERS && md->srcRaw && md->destCh+1 == ch);
       if (s_copyMode == MOVE_MODE && cur-menuVerticalOffset >= 0 && cur-menuVerticalOffset < NUM_BODY_LINES && s_copySrcCh == ch && i == (s_copySrcIdx + (s_copyTgtOfs<0))) {
         lcdDrawRect(22, y-1, LCD_W-22, 9, DOTTED);
@@ -1220,6 +1220,102 @@ static int luaGetUsage(lua_State * L)
   return 1;
 }
 
+static void luaPushScriptStats(lua_State * L, const LuaScriptStats & stats)
+{
+  lua_pushtableinteger(L, "runs", stats.runs);
+  lua_pushtableinteger(L, "instructions", stats.instructions);
+  lua_pushtableinteger(L, "maxInstructions", stats.maxInstructions);
+  lua_pushtableinteger(L, "time", stats.time);
+  lua_pushtableinteger(L, "maxTime", stats.maxTime);
+}
+
+static void luaPushStateStats(lua_State * L, const char * name, lua_State * state, const LuaStateStats & stats)
+{
+  lua_pushstring(L, name);
+  lua_newtable(L);
+  lua_pushtableinteger(L, "mem", luaGetMemUsed(state));
+  lua_pushtableinteger(L, "memPeak", stats.memPeak);
+  lua_pushtableinteger(L, "gcRuns", stats.gcRuns);
+  lua_pushtableinteger(L, "gcTime", stats.gcTime);
+  lua_pushtableinteger(L, "gcMaxTime", stats.gcMaxTime);
+  lua_pushtableinteger(L, "gcTotalTime", stats.gcTotalTime / 1000);
+  lua_pushstring(L, "gcPauses");
+  lua_newtable(L);
+  for (int i=0; i<LUA_GC_PAUSE_BUCKETS; i++) {
+    lua_pushinteger(L, i+1);
+    lua_pushinteger(L, stats.gcPauses[i]);
+    lua_settable(L, -3);
+  }
+  lua_settable(L, -3);
+  lua_settable(L, -3);
+}
+
+/*luadoc
+@function getScriptStats()
+
+Get the profiler statistics of the running Lua scripts.
+
+@retval table with the following fields:
+ * `scripts` (table) one entry per loaded model/function/telemetry script, each being a table with:
+   * `type` (string) "mix", "function", "gfunction" or "telemetry"
+   * `name` (string) script file name
+   * `runs` (number) number of executions
+   * `instructions` (number) instructions executed during the last run (counted by 100)
+   * `maxInstructions` (number) highest instructions count of a single run
+   * `time` (number) duration of the last run in us
+   * `maxTime` (number) longest run in us
+ * `widgets` (table, color screen radios only) same fields as above, for all widgets together
+ * `memory` (table) with a `scripts` and a `widgets` (color screen radios only) entry, each one having:
+   * `mem` (number) bytes currently used by the Lua state
+   * `memPeak` (number) highest usage seen in bytes
+   * `gcRuns` (number) number of garbage collections
+   * `gcTime` (number) duration of the last garbage collection in us
+   * `gcMaxTime` (number) longest garbage collection in us
+   * `gcTotalTime` (number) time spent in garbage collection in ms
+   * `gcPauses` (table) histogram of the garbage collection pauses: <0.5ms, <1ms, <2ms, <5ms, <10ms, >=10ms
+ * `heap` (number) system heap used in bytes (0 in simulator)
+
+@status current Introduced in 2.3.0
+*/
+static int luaGetScriptStats(lua_State * L)
+{
+  char name[LUA_STATS_NAME_LEN+1];
+
+  lua_newtable(L);
+
+  lua_pushstring(L, "scripts");
+  lua_newtable(L);
+  for (int i=0; i<luaScriptsCount; i++) {
+    const ScriptInternalData & sid = scriptInternalData[i];
+    luaGetScriptName(sid, name);
+    lua_pushinteger(L, i+1);
+    lua_newtable(L);
+    lua_pushtablestring(L, "type", luaGetScriptType(sid));
+    lua_pushtablestring(L, "name", name);
+    luaPushScriptStats(L, sid.stats);
+    lua_settable(L, -3);
+  }
+  lua_settable(L, -3);
+
+#if defined(COLORLCD)
+  lua_pushstring(L, "widgets");
+  lua_newtable(L);
+  luaPushScriptStats(L, luaWidgetsRunStats);
+  lua_settable(L, -3);
+#endif
+
+  lua_pushstring(L, "memory");
+  lua_newtable(L);
+  luaPushStateStats(L, "scripts", lsScripts, luaScriptsStats);
+#if defined(COLORLCD)
+  luaPushStateStats(L, "widgets", lsWidgets, luaWidgetsStats);
+#endif
+  lua_settable(L, -3);
+
+  lua_pushtableinteger(L, "heap", luaGetSystemHeapUsed());
+  return 1;
+}
+
 /*luadoc
 @function resetGlobalTimer()
 
@@ -1299,6 +1395,7 @@ const luaL_Reg opentxLib[] = {
   { "killEvents", luaKillEvents },
   { "loadScript", luaLoadScript },
   { "getUsage", luaGetUsage },
+  { "getScriptStats", luaGetScriptStats },
   { "resetGlobalTimer", luaResetGlobalTimer },
 #if LCD_DEPTH > 1 && !defined(COLORLCD)
   { "GREY", luaGrey },
@@ -24,6 +24,168 @@
 #include "lua_api.h"
 #include "timers.h"
 
+/*
+ * The getters of the model lines (inputs, mixes, outputs, logical switches) share
+ * one list of fields. Their key strings are kept in a table of the registry, so that
+ * they are neither hashed again nor collected and allocated again between calls.
+ * The tables can be filled in place and a range of lines can be filled in one call,
+ * so that a script reading the model on every refresh does not create garbage.
+ */
+
+enum LuaModelField {
+  FIELD_NAME,
+  FIELD_SOURCE,
+  FIELD_WEIGHT,
+  FIELD_OFFSET,
+  FIELD_SWITCH,
+  FIELD_CURVE_TYPE,
+  FIELD_CURVE_VALUE,
+  FIELD_MULTIPLEX,
+  FIELD_FLIGHT_MODES,
+  FIELD_CARRY_TRIM,
+  FIELD_MIX_WARN,
+  FIELD_DELAY_UP,
+  FIELD_DELAY_DOWN,
+  FIELD_SPEED_UP,
+  FIELD_SPEED_DOWN,
+  FIELD_FUNC,
+  FIELD_V1,
+  FIELD_V2,
+  FIELD_V3,
+  FIELD_AND,
+  FIELD_DELAY,
+  FIELD_DURATION,
+  FIELD_MIN,
+  FIELD_MAX,
+  FIELD_PPM_CENTER,
+  FIELD_SYMETRICAL,
+  FIELD_REVERT,
+  FIELD_CURVE,
+  FIELD_COUNT
+};
+
+static const char * const luaModelFieldNames[FIELD_COUNT] = {
+  "name", "source", "weight", "offset", "switch", "curveType", "curveValue",
+  "multiplex", "flightModes", "carryTrim", "mixWarn", "delayUp", "delayDown", "speedUp", "speedDown",
+  "func", "v1", "v2", "v3", "and", "delay", "duration",
+  "min", "max", "ppmCenter", "symetrical", "revert", "curve"
+};
+
+struct LuaModelTable {
+  const uint8_t * fields;
+  uint8_t count;
+  const void * (*address)(unsigned int idx);
+  void (*pushField)(lua_State * L, const void * data, uint8_t field);  // nil when the field is not set
+};
+
+static char luaModelKeys;  // its address is the key of the field names in the registry
+
+// Pushes the table of the field names, returns its index
+static int luaPushModelKeys(lua_State * L)
+{
+  lua_rawgetp(L, LUA_REGISTRYINDEX, &luaModelKeys);
+  if (lua_isnil(L, -1)) {
+    lua_pop(L, 1);
+    lua_createtable(L, FIELD_COUNT, 0);
+    for (int i = 0; i < FIELD_COUNT; i++) {
+      lua_pushstring(L, luaModelFieldNames[i]);
+      lua_rawseti(L, -2, i + 1);
+    }
+    lua_pushvalue(L, -1);
+    lua_rawsetp(L, LUA_REGISTRYINDEX, &luaModelKeys);
+  }
+  return lua_gettop(L);
+}
+
+// Fills the table on top of the stack
+static void luaFillModelTable(lua_State * L, int keys, const LuaModelTable & table, const void * data)
+{
+  for (uint8_t i = 0; i < table.count; i++) {
+    uint8_t field = table.fields[i];
+    lua_rawgeti(L, keys, field + 1);
+    table.pushField(L, data, field);
+    lua_rawset(L, -3);
+  }
+}
+
+// Returns the table of the line idx, the table at index arg is filled if there is one
+static int luaGetModelLine(lua_State * L, const LuaModelTable & table, unsigned int idx, int arg)
+{
+  bool inPlace = lua_istable(L, arg);
+  int keys = luaPushModelKeys(L);
+  if (inPlace)
+    lua_pushvalue(L, arg);
+  else
+    lua_createtable(L, 0, table.count);
+  luaFillModelTable(L, keys, table, table.address(idx));
+  return 1;
+}
+
+// Returns an array of the tables of count lines from first, the array at index arg and its tables are filled if there is one
+static int luaGetModelLines(lua_State * L, const LuaModelTable & table, unsigned int first, unsigned int count, int arg)
+{
+  bool inPlace = lua_istable(L, arg);
+  int keys = luaPushModelKeys(L);
+  if (inPlace)
+    lua_pushvalue(L, arg);
+  else
+    lua_createtable(L, count, 0);
+  int array = lua_gettop(L);
+
+  for (unsigned int i = 0; i < count; i++) {
+    lua_rawgeti(L, array, i + 1);
+    if (!lua_istable(L, -1)) {
+      lua_pop(L, 1);
+      lua_createtable(L, 0, table.count);
+      lua_pushvalue(L, -1);
+      lua_rawseti(L, array, i + 1);
+    }
+    luaFillModelTable(L, keys, table, table.address(first + i));
+    lua_pop(L, 1);
+  }
+
+  // the lines which don't exist anymore
+  for (unsigned int i = count + 1; ; i++) {
+    lua_rawgeti(L, array, i);
+    bool end = lua_isnil(L, -1);
+    lua_pop(L, 1);
+    if (end)
+      break;
+    lua_pushnil(L);
+    lua_rawseti(L, array, i);
+  }
+
+  return 1;
+}
+
+// Returns the values of the fields named by the arguments from arg, for the line idx
+static int luaGetModelFields(lua_State * L, const LuaModelTable & table, unsigned int idx, int arg)
+{
+  int last = lua_gettop(L);
+  int keys = luaPushModelKeys(L);
+  luaL_checkstack(L, last - arg + 1, nullptr);
+  const void * data = table.address(idx);
+  for (int n = arg; n <= last; n++) {
+    luaL_checktype(L, n, LUA_TSTRING);
+    bool found = false;
+    for (uint8_t i = 0; i < table.count && !found; i++) {
+      lua_rawgeti(L, keys, table.fields[i] + 1);
+      if (lua_rawequal(L, -1, n)) {
+        lua_pop(L, 1);
+        table.pushField(L, data, table.fields[i]);
+        found = true;
+      }
+      else {
+        lua_pop(L, 1);
+      }
+    }
+    if (!found) {
+      return luaL_argerror(L, n, "unknown field");
+    }
+  }
+  return last - arg + 1;
+}
+
 /*luadoc
 @function model.getInfo()
 
@@ -316,8 +478,50 @@ static int luaModelGetInputsCount(lua_State *L)
   return 1;
 }
 
+static const uint8_t luaInputFields[] = {
+  FIELD_NAME, FIELD_SOURCE, FIELD_WEIGHT, FIELD_OFFSET, FIELD_SWITCH, FIELD_CURVE_TYPE, FIELD_CURVE_VALUE
+};
+
+static const void * luaInputAddress(unsigned int idx)
+{
+  return expoAddress(idx);
+}
+
+static void luaPushInputField(lua_State * L, const void * data, uint8_t field)
+{
+  const ExpoData * expo = (const ExpoData *)data;
+  switch (field) {
+    case FIELD_NAME:
+      lua_pushzstring(L, expo->name);
+      break;
+    case FIELD_SOURCE:
+      lua_pushinteger(L, expo->srcRaw);
+      break;
+    case FIELD_WEIGHT:
+      lua_pushinteger(L, expo->weight);
+      break;
+    case FIELD_OFFSET:
+      lua_pushinteger(L, expo->offset);
+      break;
+    case FIELD_SWITCH:
+      lua_pushinteger(L, expo->swtch);
+      break;
+    case FIELD_CURVE_TYPE:
+      lua_pushinteger(L, expo->curve.type);
+      break;
+    case FIELD_CURVE_VALUE:
+      lua_pushinteger(L, expo->curve.value);
+      break;
+    default:
+      lua_pushnil(L);
+      break;
+  }
+}
+
+static const LuaModelTable luaInputTable = { luaInputFields, DIM(luaInputFields), luaInputAddress, luaPushInputField };
+
 /*luadoc
-@function model.getInput(input, line)
+@function model.getInput(input, line [, table])
 
 Return input data for given input and line number
 
@@ -325,6 +529,9 @@ Return input data for given input and line number
 
 @param line  (unsigned number) input line (use 0 for first line)
 
+@param table (optional) a table returned by a previous call, it is filled
+in place instead of creating a new table
+
 @retval nil requested input or line does not exist
 
 @retval table input data:
@@ -336,7 +543,7 @@ Return input data for given input and line number
  * `curveType` (number) curve type (function, expo, custom curve)
  * `curveValue` (number) curve index
 
-@status current Introduced in 2.0.0, curveType/curveValue added in 2.3
+@status current Introduced in 2.0.0, curveType/curveValue added in 2.3, table parameter added in 2.3.0
 */
 static int luaModelGetInput(lua_State *L)
 {
@@ -345,15 +552,68 @@ static int luaModelGetInput(lua_State *L)
   unsigned int first = getFirstInput(chn);
   unsigned int count = getInputsCountFromFirst(chn, first);
   if (idx < count) {
-    ExpoData * expo = expoAddress(first+idx);
-    lua_newtable(L);
-    lua_pushtablezstring(L, "name", expo->name);
-    lua_pushtableinteger(L, "source", expo->srcRaw);
-    lua_pushtableinteger(L, "weight", expo->weight);
-    lua_pushtableinteger(L, "offset", expo->offset);
-    lua_pushtableinteger(L, "switch", expo->swtch);
-    lua_pushtableinteger(L, "curveType", expo->curve.type);
-    lua_pushtableinteger(L, "curveValue", expo->curve.value);
+    return luaGetModelLine(L, luaInputTable, first+idx, 3);
+  }
+  else {
+    lua_pushnil(L);
+  }
+  return 1;
+}
+
+/*luadoc
+@function model.getInputs(input [, array])
+
+Return the data of all the lines of an input
+
+@param input (unsigned number) input number (use 0 for Input1)
+
+@param array (optional) an array returned by a previous call, it is filled
+in place, with its tables, instead of creating new tables
+
+@retval table array of the lines (1 for the first line), see model.getInput()
+for the format of the lines
+
+@status current Introduced in 2.3.0
+*/
+static int luaModelGetInputs(lua_State *L)
+{
+  unsigned int chn = luaL_checkunsigned(L, 1);
+  unsigned int first = getFirstInput(chn);
+  unsigned int count = getInputsCountFromFirst(chn, first);
+  return luaGetModelLines(L, luaInputTable, first, count, 2);
+}
+
+/*luadoc
+@function model.getInputFields(input, line, field [, field...])
+
+Return some fields of an input line, without creating a table
+
+@param input (unsigned number) input number (use 0 for Input1)
+
+@param line  (unsigned number) input line (use 0 for first line)
+
+@param field (string) field name, see model.getInput()
+
+@retval nil requested input or line does not exist
+
+@retval multiple values the values of the fields, in the same order
+
+Example:
+
+```lua
+local weight, offset = model.getInputFields(0, 0, "weight", "offset")
+```
+
+@status current Introduced in 2.3.0
+*/
+static int luaModelGetInputFields(lua_State *L)
+{
+  unsigned int chn = luaL_checkunsigned(L, 1);
+  unsigned int idx = luaL_checkunsigned(L, 2);
+  unsigned int first = getFirstInput(chn);
+  unsigned int count = getInputsCountFromFirst(chn, first);
+  if (idx < count) {
+    return luaGetModelFields(L, luaInputTable, first+idx, 3);
   }
   else {
     lua_pushnil(L);
@@ -382,7 +642,7 @@ static int luaModelInsertInput(lua_State *L)
   unsigned int first = getFirstInput(chn);
   unsigned int count = getInputsCountFromFirst(chn, first);
 
-  if (chn<MAX_INPUTS && getExposCount()<MAX_EXPOS && idx<=count) {
+  if (chn<MAX_INPUTS && hasFreeExpo() && idx<=count) {
     idx = first + idx;
     s_currCh = chn + 1;
     insertExpo(idx);
@@ -517,8 +777,76 @@ static int luaModelGetMixesCount(lua_State *L)
   return 1;
 }
 
+static const uint8_t luaMixFields[] = {
+  FIELD_NAME, FIELD_SOURCE, FIELD_WEIGHT, FIELD_OFFSET, FIELD_SWITCH, FIELD_CURVE_TYPE, FIELD_CURVE_VALUE,
+  FIELD_MULTIPLEX, FIELD_FLIGHT_MODES, FIELD_CARRY_TRIM, FIELD_MIX_WARN, FIELD_DELAY_UP, FIELD_DELAY_DOWN,
+  FIELD_SPEED_UP, FIELD_SPEED_DOWN
+};
+
+static const void * luaMixAddress(unsigned int idx)
+{
+  return mixAddress(idx);
+}
+
+static void luaPushMixField(lua_State * L, const void * data, uint8_t field)
+{
+  const MixData * mix = (const MixData *)data;
+  switch (field) {
+    case FIELD_NAME:
+      lua_pushzstring(L, mix->name);
+      break;
+    case FIELD_SOURCE:
+      lua_pushinteger(L, mix->srcRaw);
+      break;
+    case FIELD_WEIGHT:
+      lua_pushinteger(L, mix->weight);
+      break;
+    case FIELD_OFFSET:
+      lua_pushinteger(L, mix->offset);
+      break;
+    case FIELD_SWITCH:
+      lua_pushinteger(L, mix->swtch);
+      break;
+    case FIELD_CURVE_TYPE:
+      lua_pushinteger(L, mix->curve.type);
+      break;
+    case FIELD_CURVE_VALUE:
+      lua_pushinteger(L, mix->curve.value);
+      break;
+    case FIELD_MULTIPLEX:
+      lua_pushinteger(L, mix->mltpx);
+      break;
+    case FIELD_FLIGHT_MODES:
+      lua_pushinteger(L, mix->flightModes);
+      break;
+    case FIELD_CARRY_TRIM:
+      lua_pushboolean(L, mix->carryTrim);
+      break;
+    case FIELD_MIX_WARN:
+      lua_pushinteger(L, mix->mixWarn);
+      break;
+    case FIELD_DELAY_UP:
+      lua_pushinteger(L, mix->delayUp);
+      break;
+    case FIELD_DELAY_DOWN:
+      lua_pushinteger(L, mix->delayDown);
+      break;
+    case FIELD_SPEED_UP:
+      lua_pushinteger(L, mix->speedUp);
+      break;
+    case FIELD_SPEED_DOWN:
+      lua_pushinteger(L, mix->speedDown);
+      break;
+    default:
+      lua_pushnil(L);
+      break;
+  }
+}
+
+static const LuaModelTable luaMixTable = { luaMixFields, DIM(luaMixFields), luaMixAddress, luaPushMixField };
+
 /*luadoc
-@function model.getMix(channel, line)
+@function model.getMix(channel, line [, table])
 
 Get configuration for specified Mix
 
@@ -526,6 +854,9 @@ Get configuration for specified Mix
 
 @param line (unsigned number) mix number (use 0 for first line(mix))
 
+@param table (optional) a table returned by a previous call, it is filled
+in place instead of creating a new table
+
 @retval nil requested channel or line does not exist
 
 @retval table mix data:
@@ -545,7 +876,7 @@ Get configuration for specified Mix
  * `speedUp` (number) speed up
  * `speedDown` (number) speed down
 
-@status current Introduced in 2.0.0, parameters below `multiplex` added in 2.0.13
+@status current Introduced in 2.0.0, parameters below `multiplex` added in 2.0.13, table parameter added in 2.3.0
 */
 static int luaModelGetMix(lua_State *L)
 {
@@ -554,23 +885,62 @@ static int luaModelGetMix(lua_State *L)
   unsigned int first = getFirstMix(chn);
   unsigned int count = getMixesCountFromFirst(chn, first);
   if (idx < count) {
-    MixData * mix = mixAddress(first+idx);
-    lua_newtable(L);
-    lua_pushtablezstring(L, "name", mix->name);
-    lua_pushtableinteger(L, "source", mix->srcRaw);
-    lua_pushtableinteger(L, "weight", mix->weight);
-    lua_pushtableinteger(L, "offset", mix->offset);
-    lua_pushtableinteger(L, "switch", mix->swtch);
-    lua_pushtableinteger(L, "curveType", mix->curve.type);
-    lua_pushtableinteger(L, "curveValue", mix->curve.value);
-    lua_pushtableinteger(L, "multiplex", mix->mltpx);
-    lua_pushtableinteger(L, "flightModes", mix->flightModes);
-    lua_pushtableboolean(L, "carryTrim", mix->carryTrim);
-    lua_pushtableinteger(L, "mixWarn", mix->mixWarn);
-    lua_pushtableinteger(L, "delayUp", mix->delayUp);
-    lua_pushtableinteger(L, "delayDown", mix->delayDown);
-    lua_pushtableinteger(L, "speedUp", mix->speedUp);
-    lua_pushtableinteger(L, "speedDown", mix->speedDown);
+    return luaGetModelLine(L, luaMixTable, first+idx, 3);
+  }
+  else {
+    lua_pushnil(L);
+  }
+  return 1;
+}
+
+/*luadoc
+@function model.getMixes(channel [, array])
+
+Get the configuration of all the Mixes of a Channel
+
+@param channel (unsigned number) channel number (use 0 for CH1)
+
+@param array (optional) an array returned by a previous call, it is filled
+in place, with its tables, instead of creating new tables
+
+@retval table array of the mixes (1 for the first line), see model.getMix()
+for the format of the mixes
+
+@status current Introduced in 2.3.0
+*/
+static int luaModelGetMixes(lua_State *L)
+{
+  unsigned int chn = luaL_checkunsigned(L, 1);
+  unsigned int first = getFirstMix(chn);
+  unsigned int count = getMixesCountFromFirst(chn, first);
+  return luaGetModelLines(L, luaMixTable, first, count, 2);
+}
+
+/*luadoc
+@function model.getMixFields(channel, line, field [, field...])
+
+Get some fields of a Mix, without creating a table
+
+@param channel (unsigned number) channel number (use 0 for CH1)
+
+@param line (unsigned number) mix number (use 0 for first line(mix))
+
+@param field (string) field name, see model.getMix()
+
+@retval nil requested channel or line does not exist
+
+@retval multiple values the values of the fields, in the same order
+
+@status current Introduced in 2.3.0
+*/
+static int luaModelGetMixFields(lua_State *L)
+{
+  unsigned int chn = luaL_checkunsigned(L, 1);
+  unsigned int idx = luaL_checkunsigned(L, 2);
+  unsigned int first = getFirstMix(chn);
+  unsigned int count = getMixesCountFromFirst(chn, first);
+  if (idx < count) {
+    return luaGetModelFields(L, luaMixTable, first+idx, 3);
   }
   else {
     lua_pushnil(L);
@@ -599,7 +969,7 @@ static int luaModelInsertMix(lua_State *L)
   unsigned int first = getFirstMix(chn);
   unsigned int count = getMixesCountFromFirst(chn, first);
 
-  if (chn<MAX_OUTPUT_CHANNELS && getMixesCount()<MAX_MIXERS && idx<=count) {
+  if (chn<MAX_OUTPUT_CHANNELS && hasFreeMix() && idx<=count) {
     idx += first;
     s_currCh = chn+1;
     insertMix(idx);
@@ -695,17 +1065,62 @@ Remove all mixers
 */
 static int luaModelDeleteMixes(lua_State *L)
 {
-  memset(g_model.mixData, 0, sizeof(g_model.mixData));
+  clearMixData();
   return 0;
 }
 
+static const uint8_t luaLogicalSwitchFields[] = {
+  FIELD_FUNC, FIELD_V1, FIELD_V2, FIELD_V3, FIELD_AND, FIELD_DELAY, FIELD_DURATION
+};
+
+static const void * luaLogicalSwitchAddress(unsigned int idx)
+{
+  return lswAddress(idx);
+}
+
+static void luaPushLogicalSwitchField(lua_State * L, const void * data, uint8_t field)
+{
+  const LogicalSwitchData * sw = (const LogicalSwitchData *)data;
+  switch (field) {
+    case FIELD_FUNC:
+      lua_pushinteger(L, sw->func);
+      break;
+    case FIELD_V1:
+      lua_pushinteger(L, sw->v1);
+      break;
+    case FIELD_V2:
+      lua_pushinteger(L, sw->v2);
+      break;
+    case FIELD_V3:
+      lua_pushinteger(L, sw->v3);
+      break;
+    case FIELD_AND:
+      lua_pushinteger(L, sw->andsw);
+      break;
+    case FIELD_DELAY:
+      lua_pushinteger(L, sw->delay);
+      break;
+    case FIELD_DURATION:
+      lua_pushinteger(L, sw->duration);
+      break;
+    default:
+      lua_pushnil(L);
+      break;
+  }
+}
+
+static const LuaModelTable luaLogicalSwitchTable = { luaLogicalSwitchFields, DIM(luaLogicalSwitchFields), luaLogicalSwitchAddress, luaPushLogicalSwitchField };
+
 /*luadoc
-@function model.getLogicalSwitch(switch)
+@function model.getLogicalSwitch(switch [, table])
 
 Get Logical Switch parameters
 
 @param switch (unsigned number) logical switch number (use 0 for LS1)
 
+@param table (optional) a table returned by a previous call, it is filled
+in place instead of creating a new table
+
 @retval nil requested logical switch does not exist
 
 @retval table logical switch data:
@@ -717,21 +1132,69 @@ Get Logical Switch parameters
  * `delay` (number) delay (time in 1/10 s)
  * `duration` (number) duration (time in 1/10 s)
 
-@status current Introduced in 2.0.0
+@status current Introduced in 2.0.0, table parameter added in 2.3.0
 */
 static int luaModelGetLogicalSwitch(lua_State *L)
 {
   unsigned int idx = luaL_checkunsigned(L, 1);
   if (idx < MAX_LOGICAL_SWITCHES) {
-    LogicalSwitchData * sw = lswAddress(idx);
-    lua_newtable(L);
-    lua_pushtableinteger(L, "func", sw->func);
-    lua_pushtableinteger(L, "v1", sw->v1);
-    lua_pushtableinteger(L, "v2", sw->v2);
-    lua_pushtableinteger(L, "v3", sw->v3);
-    lua_pushtableinteger(L, "and", sw->andsw);
-    lua_pushtableinteger(L, "delay", sw->delay);
-    lua_pushtableinteger(L, "duration", sw->duration);
+    return luaGetModelLine(L, luaLogicalSwitchTable, idx, 2);
+  }
+  else {
+    lua_pushnil(L);
+  }
+  return 1;
+}
+
+/*luadoc
+@function model.getLogicalSwitches(first, count [, array])
+
+Get the parameters of several Logical Switches
+
+@param first (unsigned number) first logical switch number (use 0 for LS1)
+
+@param count (unsigned number) number of logical switches, the array is shorter
+when the last ones don't exist
+
+@param array (optional) an array returned by a previous call, it is filled
+in place, with its tables, instead of creating new tables
+
+@retval table array of the logical switches (1 for the first one), see
+model.getLogicalSwitch() for the format of the logical switches
+
+@status current Introduced in 2.3.0
+*/
+static int luaModelGetLogicalSwitches(lua_State *L)
+{
+  unsigned int first = luaL_checkunsigned(L, 1);
+  unsigned int count = luaL_checkunsigned(L, 2);
+  if (first >= MAX_LOGICAL_SWITCHES)
+    count = 0;
+  else if (count > MAX_LOGICAL_SWITCHES - first)
+    count = MAX_LOGICAL_SWITCHES - first;
+  return luaGetModelLines(L, luaLogicalSwitchTable, first, count, 3);
+}
+
+/*luadoc
+@function model.getLogicalSwitchFields(switch, field [, field...])
+
+Get some parameters of a Logical Switch, without creating a table
+
+@param switch (unsigned number) logical switch number (use 0 for LS1)
+
+@param field (string) field name, see model.getLogicalSwitch()
+
+@retval nil requested logical switch does not exist
+
+@retval multiple values the values of the fields, in the same order
+
+@status current Introduced in 2.3.0
+*/
+static int luaModelGetLogicalSwitchFields(lua_State *L)
+{
+  unsigned int idx = luaL_checkunsigned(L, 1);
+  if (idx < MAX_LOGICAL_SWITCHES) {
+    return luaGetModelFields(L, luaLogicalSwitchTable, idx, 2);
   }
   else {
     lua_pushnil(L);
@@ -1152,13 +1615,64 @@ static int luaModelSetCustomFunction(lua_State *L)
   return 0;
 }
 
+static const uint8_t luaOutputFields[] = {
+  FIELD_NAME, FIELD_MIN, FIELD_MAX, FIELD_OFFSET, FIELD_PPM_CENTER, FIELD_SYMETRICAL, FIELD_REVERT, FIELD_CURVE
+};
+
+static const void * luaOutputAddress(unsigned int idx)
+{
+  return limitAddress(idx);
+}
+
+static void luaPushOutputField(lua_State * L, const void * data, uint8_t field)
+{
+  const LimitData * limit = (const LimitData *)data;
+  switch (field) {
+    case FIELD_NAME:
+      lua_pushzstring(L, limit->name);
+      break;
+    case FIELD_MIN:
+      lua_pushinteger(L, limit->min-1000);
+      break;
+    case FIELD_MAX:
+      lua_pushinteger(L, limit->max+1000);
+      break;
+    case FIELD_OFFSET:
+      lua_pushinteger(L, limit->offset);
+      break;
+    case FIELD_PPM_CENTER:
+      lua_pushinteger(L, limit->ppmCenter);
+      break;
+    case FIELD_SYMETRICAL:
+      lua_pushinteger(L, limit->symetrical);
+      break;
+    case FIELD_REVERT:
+      lua_pushinteger(L, limit->revert);
+      break;
+    case FIELD_CURVE:
+      if (limit->curve)
+        lua_pushinteger(L, limit->curve-1);
+      else
+        lua_pushnil(L);
+      break;
+    default:
+      lua_pushnil(L);
+      break;
+  }
+}
+
+static const LuaModelTable luaOutputTable = { luaOutputFields, DIM(luaOutputFields), luaOutputAddress, luaPushOutputField };
+
 /*luadoc
-@function model.getOutput(index)
+@function model.getOutput(index [, table])
 
 Get servo parameters
 
 @param index (unsigned number) output number (use 0 for CH1)
 
+@param table (optional) a table returned by a previous call, it is filled
+in place instead of creating a new table
+
 @retval nil requested output does not exist
 
 @retval table output parameters:
@@ -1173,23 +1687,70 @@ Get servo parameters
    * (number) Curve number (0 for Curve1)
    * or `nil` if no curve set
 
-@status current Introduced in 2.0.0
+@status current Introduced in 2.0.0, table parameter added in 2.3.0
 */
 static int luaModelGetOutput(lua_State *L)
 {
   unsigned int idx = luaL_checkunsigned(L, 1);
   if (idx < MAX_OUTPUT_CHANNELS) {
-    LimitData * limit = limitAddress(idx);
-    lua_newtable(L);
-    lua_pushtablezstring(L, "name", limit->name);
-    lua_pushtableinteger(L, "min", limit->min-1000);
-    lua_pushtableinteger(L, "max", limit->max+1000);
-    lua_pushtableinteger(L, "offset", limit->offset);
-    lua_pushtableinteger(L, "ppmCenter", limit->ppmCenter);
-    lua_pushtableinteger(L, "symetrical", limit->symetrical);
-    lua_pushtableinteger(L, "revert", limit->revert);
-    if (limit->curve)
-      lua_pushtableinteger(L, "curve", limit->curve-1);
+    return luaGetModelLine(L, luaOutputTable, idx, 2);
+  }
+  else {
+    lua_pushnil(L);
+  }
+  return 1;
+}
+
+/*luadoc
+@function model.getOutputs(first, count [, array])
+
+Get the parameters of several servos
+
+@param first (unsigned number) first output number (use 0 for CH1)
+
+@param count (unsigned number) number of outputs, the array is shorter when
+the last ones don't exist
+
+@param array (optional) an array returned by a previous call, it is filled
+in place, with its tables, instead of creating new tables
+
+@retval table array of the outputs (1 for the first one), see model.getOutput()
+for the format of the outputs
+
+@status current Introduced in 2.3.0
+*/
+static int luaModelGetOutputs(lua_State *L)
+{
+  unsigned int first = luaL_checkunsigned(L, 1);
+  unsigned int count = luaL_checkunsigned(L, 2);
+  if (first >= MAX_OUTPUT_CHANNELS)
+    count = 0;
+  else if (count > MAX_OUTPUT_CHANNELS - first)
+    count = MAX_OUTPUT_CHANNELS - first;
+  return luaGetModelLines(L, luaOutputTable, first, count, 3);
+}
+
+/*luadoc
+@function model.getOutputFields(index, field [, field...])
+
+Get some servo parameters, without creating a table
+
+@param index (unsigned number) output number (use 0 for CH1)
+
+@param field (string) field name, see model.getOutput()
+
+@retval nil requested output does not exist
+
+@retval multiple values the values of the fields, in the same order (`curve`
+is nil when no curve is set)
+
+@status current Introduced in 2.3.0
+*/
+static int luaModelGetOutputFields(lua_State *L)
+{
+  unsigned int idx = luaL_checkunsigned(L, 1);
+  if (idx < MAX_OUTPUT_CHANNELS) {
+    return luaGetModelFields(L, luaOutputTable, idx, 2);
   }
   else {
     lua_pushnil(L);
@@ -1324,22 +1885,30 @@ const luaL_Reg modelLib[] = {
   { "resetTimer", luaModelResetTimer },
   { "getInputsCount", luaModelGetInputsCount },
   { "getInput", luaModelGetInput },
+  { "getInputs", luaModelGetInputs },
+  { "getInputFields", luaModelGetInputFields },
   { "insertInput", luaModelInsertInput },
   { "deleteInput", luaModelDeleteInput },
   { "deleteInputs", luaModelDeleteInputs },
   { "defaultInputs", luaModelDefaultInputs },
   { "getMixesCount", luaModelGetMixesCount },
   { "getMix", luaModelGetMix },
+  { "getMixes", luaModelGetMixes },
+  { "getMixFields", luaModelGetMixFields },
   { "insertMix", luaModelInsertMix },
   { "deleteMix", luaModelDeleteMix },
   { "deleteMixes", luaModelDeleteMixes },
   { "getLogicalSwitch", luaModelGetLogicalSwitch },
+  { "getLogicalSwitches", luaModelGetLogicalSwitches },
+  { "getLogicalSwitchFields", luaModelGetLogicalSwitchFields },
   { "setLogicalSwitch", luaModelSetLogicalSwitch },
   { "getCustomFunction", luaModelGetCustomFunction },
   { "setCustomFunction", luaModelSetCustomFunction },
   { "getCurve", luaModelGetCurve },
   { "setCurve", luaModelSetCurve },
   { "getOutput", luaModelGetOutput },
+  { "getOutputs", luaModelGetOutputs },
+  { "getOutputFields", luaModelGetOutputFields },
   { "setOutput", luaModelSetOutput },
   { "getGlobalVariable", luaModelGetGlobalVariable },
   { "setGlobalVariable", luaModelSetGlobalVariable },
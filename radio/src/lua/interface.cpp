@@ -45,6 +45,8 @@ uint16_t maxLuaInterval = 0;
 uint16_t maxLuaDuration = 0;
 bool luaLcdAllowed;
 uint8_t instructionsPercent = 0;
+static uint16_t instructionsStep = 0;
+LuaStateStats luaScriptsStats;
 char lua_warning_info[LUA_WARNING_INFO_LEN+1];
 struct our_longjmp * global_lj = 0;
 #if defined(COLORLCD)
@@ -139,6 +141,7 @@ void luaHook(lua_State * L, lua_Debug *ar)
 void luaSetInstructionsLimit(lua_State * L, int count)
 {
   instructionsPercent = 0;
+  instructionsStep = count;
 #if defined(LUA_ALLOCATOR_TRACER)
   lua_sethook(L, luaHook, LUA_MASKCOUNT|LUA_MASKLINE, count);
 #else
@@ -146,6 +149,117 @@ void luaSetInstructionsLimit(lua_State * L, int count)
 #endif
 }
 
+LuaStateStats * luaGetStateStats(lua_State * L)
+{
+#if defined(COLORLCD)
+  if (L == lsWidgets) return &luaWidgetsStats;
+#endif
+  return &luaScriptsStats;
+}
+
+LuaTimer luaStartTimer()
+{
+  LuaTimer timer;
+  timer.tmr10ms = get_tmr10ms();
+  timer.tmr2MHz = getTmr2MHz();
+  return timer;
+}
+
+#define LUA_TIMER_MAX_TMR10MS  100000  // the durations saturate at 1000s
+
+uint32_t luaGetElapsedTime(const LuaTimer & start)
+{
+  uint16_t ticks = getTmr2MHz() - start.tmr2MHz;
+  tmr10ms_t tmr10ms = get_tmr10ms() - start.tmr10ms;
+  if (tmr10ms >= LUA_TIMER_MAX_TMR10MS) {
+    return LUA_TIMER_MAX_TMR10MS * 10000;
+  }
+  // the 10ms tick gives the duration within +/-20000 ticks, less than half a wrap of getTmr2MHz()
+  int32_t wrapped = (int32_t)(tmr10ms * 20000) - ticks + 32768;
+  uint32_t wraps = (wrapped > 0 ? wrapped / 65536 : 0);
+  return (wraps * 65536 + ticks) / 2;
+}
+
+void luaUpdateScriptStats(LuaScriptStats & stats, const LuaTimer & start)
+{
+  uint32_t duration = luaGetElapsedTime(start);
+  // the count hook fires every instructionsStep instructions
+  uint32_t instructions = (uint32_t)instructionsPercent * instructionsStep;
+
+  stats.runs++;
+  stats.time = duration;
+  if (duration > stats.maxTime)
+    stats.maxTime = duration;
+  stats.instructions = instructions;
+  if (instructions > stats.maxInstructions)
+    stats.maxInstructions = instructions;
+}
+
+void luaResetStats()
+{
+  for (int i=0; i<luaScriptsCount; i++) {
+    memclear(&scriptInternalData[i].stats, sizeof(LuaScriptStats));
+  }
+  memclear(&standaloneScript.stats, sizeof(LuaScriptStats));
+  memclear(&luaScriptsStats, sizeof(luaScriptsStats));
+#if defined(COLORLCD)
+  memclear(&luaWidgetsStats, sizeof(luaWidgetsStats));
+  memclear(&luaWidgetsRunStats, sizeof(luaWidgetsRunStats));
+#endif
+#if defined(USE_BIN_ALLOCATOR)
+  slots1.resetPeak();
+  slots2.resetPeak();
+#endif
+}
+
+const char * luaGetScriptType(const ScriptInternalData & sid)
+{
+  if (sid.reference <= SCRIPT_MIX_LAST)
+    return "mix";
+  else if (sid.reference <= SCRIPT_FUNC_LAST)
+    return "function";
+  else if (sid.reference <= SCRIPT_GFUNC_LAST)
+    return "gfunction";
+  else
+    return "telemetry";
+}
+
+void luaGetScriptName(const ScriptInternalData & sid, char * name)
+{
+  const char * src = "";
+  uint8_t len = 0;
+
+  if (sid.reference <= SCRIPT_MIX_LAST) {
+    src = g_model.scriptsData[sid.reference-SCRIPT_MIX_FIRST].file;
+    len = LEN_SCRIPT_FILENAME;
+  }
+  else if (sid.reference <= SCRIPT_GFUNC_LAST) {
+    CustomFunctionData & fn = (sid.reference < SCRIPT_GFUNC_FIRST ? g_model.customFn[sid.reference-SCRIPT_FUNC_FIRST] : g_eeGeneral.customFn[sid.reference-SCRIPT_GFUNC_FIRST]);
+    src = fn.play.name;
+    len = LEN_FUNCTION_NAME;
+  }
+#if defined(PCBTARANIS)
+  else {
+    src = g_model.frsky.screens[sid.reference-SCRIPT_TELEMETRY_FIRST].script.file;
+    len = LEN_SCRIPT_FILENAME;
+  }
+#endif
+
+  strncpy(name, src, len);
+  name[len] = '\0';
+}
+
+uint32_t luaGetSystemHeapUsed()
+{
+#if defined(SIMU)
+  return 0;
+#else
+  extern int _end;
+  extern unsigned char * heap;
+  return heap - (unsigned char *)&_end;
+#endif
+}
+
 int luaGetInputs(lua_State * L, ScriptInputsOutputs & sid)
 {
   if (!lua_istable(L, -1))
@@ -255,6 +369,7 @@ void luaClose(lua_State ** L)
       if (*L == lsScripts) luaDisable();
     }
     UNPROTECT_LUA();
+    luaGcReset(*L);
     *L = nullptr;
   }
 }
@@ -269,16 +384,84 @@ void luaRegisterLibraries(lua_State * L)
 
 #define GC_REPORT_TRESHOLD    (2*1024)
 
+#define LUA_GC_STEP_MIN              1          // LUA_GCSTEP size, in KB
+#define LUA_GC_STEP_MAX              32         // LUA_GCSTEP size, in KB
+#define LUA_GC_MAX_STEPS             8          // max steps in one slice
+#define LUA_GC_MAX_BUDGET            20000      // max time spent in GC per menus period, in us
+#define LUA_GC_FULL_MIN_GROWTH       (8*1024)   // memory growth (in bytes) since the last full collection before another one is worth it
+
+// upper limits of the GC pauses histogram buckets, in us
+const uint16_t luaGcPauseLimits[LUA_GC_PAUSE_BUCKETS-1] = { 500, 1000, 2000, 5000, 10000 };
+
+struct LuaGcScheduler {
+  uint32_t memUsed;       // memory used after the previous slice, in bytes
+  uint32_t allocRate;     // smoothed allocations per menus period, in bytes
+  uint32_t fullMemUsed;   // memory used after the last full collection, in bytes
+  uint32_t fullTime;      // duration of the last full collection, in us
+  uint8_t stepSize;       // current LUA_GCSTEP size, in KB
+};
+
+static LuaGcScheduler luaScriptsGc;
+#if defined(COLORLCD)
+static LuaGcScheduler luaWidgetsGc;
+#endif
+
+static LuaGcScheduler * luaGetGcScheduler(lua_State * L)
+{
+#if defined(COLORLCD)
+  if (L == lsWidgets) return &luaWidgetsGc;
+#endif
+  return &luaScriptsGc;
+}
+
+// the scheduler state belongs to the Lua state, it is cleared when the state is created or closed
+void luaGcReset(lua_State * L)
+{
+  if (L) {
+    memclear(luaGetGcScheduler(L), sizeof(LuaGcScheduler));
+  }
+}
+
+static void luaRecordGc(LuaStateStats * stats, uint32_t duration)
+{
+  stats->gcRuns++;
+  stats->gcTime = duration;
+  stats->gcTotalTime += duration;
+  if (duration > stats->gcMaxTime) {
+    stats->gcMaxTime = duration;
+  }
+  uint8_t bucket = 0;
+  while (bucket < LUA_GC_PAUSE_BUCKETS-1 && duration >= luaGcPauseLimits[bucket]) {
+    bucket++;
+  }
+  stats->gcPauses[bucket]++;
+}
+
 void luaDoGc(lua_State * L, bool full)
 {
   if (L) {
+    LuaStateStats * stats = luaGetStateStats(L);
     PROTECT_LUA() {
+      uint32_t used = luaGetMemUsed(L);
+      if (used > stats->memPeak) {
+        stats->memPeak = used;
+      }
+      LuaTimer timer = luaStartTimer();
       if (full) {
         lua_gc(L, LUA_GCCOLLECT, 0);
       }
       else {
         lua_gc(L, LUA_GCSTEP, 10);
       }
+      uint32_t duration = luaGetElapsedTime(timer);
+      luaRecordGc(stats, duration);
+      stats->memUsed = luaGetMemUsed(L);
+      if (full) {
+        LuaGcScheduler * gc = luaGetGcScheduler(L);
+        gc->fullTime = duration;
+        gc->fullMemUsed = stats->memUsed;
+        gc->memUsed = stats->memUsed;
+      }
 #if defined(DEBUG)
       if (L == lsScripts) {
         static uint32_t lastgcSctipts = 0;
@@ -311,6 +494,106 @@ void luaDoGc(lua_State * L, bool full)
   }
 }
 
+static bool luaIsUnderMemoryPressure()
+{
+#if (LUA_MEM_MAX > 0)
+  uint32_t totalMemUsed = luaGetMemUsed(lsScripts);
+#if defined(COLORLCD)
+  totalMemUsed += luaGetMemUsed(lsWidgets);
+  totalMemUsed += luaExtraMemoryUsage;
+#endif
+  return totalMemUsed > LUA_MEM_MAX / 4 * 3;
+#else
+  return false;
+#endif
+}
+
+/*
+  Runs incremental GC steps on one Lua state, within the given budget (in us).
+  At least one step is always done, so that the collector keeps up even when the menus
+  period is overrun. The step size follows the allocation rate of the scripts, and more
+  steps are done while the memory keeps growing. A full collection is only done when
+  the remaining budget is large enough to hold it.
+  Returns the time used.
+*/
+static uint32_t luaGcSlice(lua_State * L, uint32_t budget)
+{
+  LuaGcScheduler * gc = luaGetGcScheduler(L);
+  LuaStateStats * stats = luaGetStateStats(L);
+  LuaTimer start = luaStartTimer();
+  uint32_t elapsed = 0;
+  bool ok;
+
+  PROTECT_LUA() {
+    uint32_t used = luaGetMemUsed(L);
+    if (used > stats->memPeak) {
+      stats->memPeak = used;
+    }
+
+    uint32_t allocated = (used > gc->memUsed ? used - gc->memUsed : 0);
+    gc->allocRate = (gc->allocRate * 3 + allocated) / 4;
+    gc->stepSize = limit<uint32_t>(LUA_GC_STEP_MIN, (gc->allocRate >> 10) + 1, LUA_GC_STEP_MAX);
+
+    uint8_t steps = (used > gc->memUsed ? LUA_GC_MAX_STEPS : 1);
+    do {
+      if (lua_gc(L, LUA_GCSTEP, gc->stepSize)) {
+        // end of cycle
+        break;
+      }
+      elapsed = luaGetElapsedTime(start);
+    } while (--steps && elapsed < budget);
+    elapsed = luaGetElapsedTime(start);
+    luaRecordGc(stats, elapsed);
+
+    gc->memUsed = luaGetMemUsed(L);
+    stats->memUsed = gc->memUsed;
+    ok = true;
+  }
+  else {
+    ok = false;
+    // we disable Lua for the rest of the session
+    if (L == lsScripts) luaDisable();
+#if defined(COLORLCD)
+    if (L == lsWidgets) lsWidgets = 0;
+#endif
+  }
+  UNPROTECT_LUA();
+
+  if (ok && elapsed < budget) {
+    // full collection only when idle: the time left must hold twice its last duration
+    uint32_t remaining = budget - elapsed;
+    bool fits = (gc->fullTime ? gc->fullTime < remaining / 2 : remaining >= LUA_GC_MAX_BUDGET / 2);
+    if (fits && (gc->memUsed >= gc->fullMemUsed + LUA_GC_FULL_MIN_GROWTH || luaIsUnderMemoryPressure())) {
+      luaDoGc(L, true);
+      elapsed = luaGetElapsedTime(start);
+    }
+  }
+
+  return elapsed;
+}
+
+/*
+  GC scheduler, called once per menus period with the time left in it (in us)
+*/
+void luaGcTask(uint32_t budget)
+{
+  budget = min<uint32_t>(budget, LUA_GC_MAX_BUDGET);
+
+#if defined(COLORLCD)
+  uint32_t used = 0;
+  if (lsScripts) {
+    used = luaGcSlice(lsScripts, budget / 2);
+  }
+  if (lsWidgets) {
+    luaGcSlice(lsWidgets, used < budget ? budget - used : 0);
+  }
+#else
+  if (lsScripts) {
+    luaGcSlice(lsScripts, budget);
+  }
+#endif
+}
+
 void luaFree(lua_State * L, ScriptInternalData & sid)
 {
   PROTECT_LUA() {
@@ -549,6 +832,7 @@ static int luaLoad(lua_State * L, const char * filename, ScriptInternalData & si
 
   sid.instructions = 0;
   sid.state = SCRIPT_OK;
+  memclear(&sid.stats, sizeof(sid.stats));
 
   if (luaState == INTERPRETER_PANIC) {
     return SCRIPT_PANIC;
@@ -820,10 +1104,13 @@ void luaDoOneRunStandalone(event_t evt)
   static uint8_t luaDisplayStatistics = false;
 
   if (standaloneScript.state == SCRIPT_OK && standaloneScript.run) {
+    LuaTimer t0 = luaStartTimer();
     luaSetInstructionsLimit(lsScripts, MANUAL_SCRIPTS_MAX_INSTRUCTIONS);
     lua_rawgeti(lsScripts, LUA_REGISTRYINDEX, standaloneScript.run);
     lua_pushunsigned(lsScripts, evt);
-    if (lua_pcall(lsScripts, 1, 1, 0) == 0) {
+    int status = lua_pcall(lsScripts, 1, 1, 0);
+    luaUpdateScriptStats(standaloneScript.stats, t0);
+    if (status == 0) {
       if (!lua_isnumber(lsScripts, -1)) {
         if (instructionsPercent > 100) {
           TRACE("Script killed");
@@ -901,6 +1188,7 @@ bool luaDoOneRunPermanentScript(event_t evt, int i, uint32_t scriptType)
   ScriptInternalData & sid = scriptInternalData[i];
   if (sid.state != SCRIPT_OK) return false;
 
+  LuaTimer t0 = luaStartTimer();
   luaSetInstructionsLimit(lsScripts, PERMANENT_SCRIPTS_MAX_INSTRUCTIONS);
   int inputsCount = 0;
 #if defined(SIMU) || defined(DEBUG)
@@ -960,7 +1248,9 @@ bool luaDoOneRunPermanentScript(event_t evt, int i, uint32_t scriptType)
 #endif
   }
 
-  if (lua_pcall(lsScripts, inputsCount, sio ? sio->outputsCount : 0, 0) == 0) {
+  int status = lua_pcall(lsScripts, inputsCount, sio ? sio->outputsCount : 0, 0);
+  luaUpdateScriptStats(sid.stats, t0);
+  if (status == 0) {
     if (sio) {
       for (int j=sio->outputsCount-1; j>=0; j--) {
         if (!lua_isnumber(lsScripts, -1)) {
@@ -1034,13 +1324,9 @@ bool luaTask(event_t evt, uint8_t scriptType, bool allowLcdUsage)
         break;
       }
       UNPROTECT_LUA();
-      //todo gc step between scripts
     }
   }
-  luaDoGc(lsScripts, false);
-#if defined(COLORLCD)
-  luaDoGc(lsWidgets, false);
-#endif
+  // garbage collection is done by luaGcTask() with the time left in the menus period
   return scriptWasRun;
 }
 
@@ -1052,6 +1338,16 @@ void checkLuaMemoryUsage()
   totalMemUsed += luaGetMemUsed(lsWidgets);
   totalMemUsed += luaExtraMemoryUsage;
 #endif
+  if (totalMemUsed > LUA_MEM_MAX) {
+    // try a full collection before giving up
+    luaDoGc(lsScripts, true);
+    totalMemUsed = luaGetMemUsed(lsScripts);
+#if defined(COLORLCD)
+    luaDoGc(lsWidgets, true);
+    totalMemUsed += luaGetMemUsed(lsWidgets);
+    totalMemUsed += luaExtraMemoryUsage;
+#endif
+  }
   if (totalMemUsed > LUA_MEM_MAX) {
     TRACE("checkLuaMemoryUsage(): max limit reached (%u), killing Lua", totalMemUsed);
     // disable Lua scripts
@@ -1087,6 +1383,7 @@ void luaInit()
 #else
     lsScripts = lua_newstate(l_alloc, nullptr);   //we use Lua default allocator
 #endif
+    luaGcReset(lsScripts);
     if (lsScripts) {
       // install our panic handler
       lua_atpanic(lsScripts, &custom_lua_atpanic);
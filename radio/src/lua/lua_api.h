@@ -61,6 +61,7 @@ void luaInitThemesAndWidgets();
 #define lua_pushtablestring(L, k, v)   (lua_pushstring(L, (k)), lua_pushstring(L, (v)), lua_settable(L, -3))
 #define lua_pushtablenzstring(L, k, v) { char tmp[sizeof(v)+1]; strncpy(tmp, (v), sizeof(tmp)-1); tmp[sizeof(v)] = '\0'; lua_pushstring(L, (k)); lua_pushstring(L, tmp); lua_settable(L, -3); }
 #define lua_pushtablezstring(L, k, v)  { char tmp[sizeof(v)+1]; zchar2str(tmp, (v), sizeof(tmp)-1); lua_pushstring(L, (k)); lua_pushstring(L, tmp); lua_settable(L, -3); }
+#define lua_pushzstring(L, v)          { char tmp[sizeof(v)+1]; zchar2str(tmp, (v), sizeof(tmp)-1); lua_pushstring(L, tmp); }
 #define lua_registerlib(L, name, tab)  (luaL_newmetatable(L, name), luaL_setfuncs(L, tab, 0), lua_setglobal(L, name))
 
 #define RUN_MIX_SCRIPT        (1 << 0)
@@ -104,12 +105,35 @@ enum ScriptReference {
   SCRIPT_TELEMETRY_FIRST,
   SCRIPT_TELEMETRY_LAST=SCRIPT_TELEMETRY_FIRST+MAX_SCRIPTS, // telem0 and telem1 .. telem7
 };
+// Start of a duration measure, getTmr2MHz() wraps after 32ms, the 10ms tick counts the wraps
+struct LuaTimer {
+  tmr10ms_t tmr10ms;
+  uint16_t tmr2MHz;
+};
+struct LuaScriptStats {
+  uint32_t runs;
+  uint32_t instructions;     // instructions executed during the last run
+  uint32_t maxInstructions;
+  uint32_t time;             // duration of the last run, in us
+  uint32_t maxTime;
+};
+#define LUA_GC_PAUSE_BUCKETS 6
+struct LuaStateStats {
+  uint32_t gcRuns;
+  uint32_t gcTime;           // duration of the last GC, in us
+  uint32_t gcMaxTime;
+  uint32_t gcTotalTime;      // in us
+  uint32_t memUsed;          // bytes used after the last GC
+  uint32_t memPeak;          // highest usage seen before a GC
+  uint32_t gcPauses[LUA_GC_PAUSE_BUCKETS];  // GC pauses histogram, see luaGcPauseLimits
+};
 struct ScriptInternalData {
   uint8_t reference;
   uint8_t state;
   int run;
   int background;
   uint8_t instructions;
+  LuaScriptStats stats;
 };
 struct ScriptInputsOutputs {
   uint8_t inputsCount;
@@ -130,6 +154,8 @@ bool luaTask(event_t evt, uint8_t scriptType, bool allowLcdUsage);
 void checkLuaMemoryUsage();
 void luaExec(const char * filename);
 void luaDoGc(lua_State * L, bool full);
+void luaGcTask(uint32_t budget);
+void luaGcReset(lua_State * L);
 void luaError(lua_State * L, uint8_t error, bool acknowledge=true);
 uint32_t luaGetMemUsed(lua_State * L);
 void luaGetValueAndPush(lua_State * L, int src);
@@ -155,6 +181,23 @@ extern uint16_t maxLuaInterval;
 extern uint16_t maxLuaDuration;
 extern uint8_t instructionsPercent;
 
+// Lua profiler
+#define LUA_STATS_NAME_LEN (LEN_FUNCTION_NAME > LEN_SCRIPT_FILENAME ? LEN_FUNCTION_NAME : LEN_SCRIPT_FILENAME)
+extern LuaStateStats luaScriptsStats;
+#if defined(COLORLCD)
+extern LuaStateStats luaWidgetsStats;
+extern LuaScriptStats luaWidgetsRunStats;
+#endif
+extern const uint16_t luaGcPauseLimits[LUA_GC_PAUSE_BUCKETS-1];
+LuaStateStats * luaGetStateStats(lua_State * L);
+LuaTimer luaStartTimer();
+uint32_t luaGetElapsedTime(const LuaTimer & start);  // in us
+void luaUpdateScriptStats(LuaScriptStats & stats, const LuaTimer & start);
+void luaResetStats();
+const char * luaGetScriptType(const ScriptInternalData & sid);
+void luaGetScriptName(const ScriptInternalData & sid, char * name);  // name must hold LUA_STATS_NAME_LEN+1 chars
+uint32_t luaGetSystemHeapUsed();
+
 #if defined(PCBXLITE)
   #define IS_MASKABLE(key) ((key) != KEY_EXIT && (key) != KEY_ENTER)
 #elif defined(PCBTARANIS)
@@ -29,6 +29,8 @@
 #define LUA_WARNING_INFO_LEN               64
 
 lua_State *lsWidgets = NULL;
+LuaStateStats luaWidgetsStats;
+LuaScriptStats luaWidgetsRunStats;
 extern int custom_lua_atpanic(lua_State *L);
 
 #define LUA_WIDGET_FILENAME                "/main.lua"
@@ -341,6 +343,7 @@ void LuaWidget::update()
 {
   if (lsWidgets == 0 || errorMessage) return;
 
+  LuaTimer t0 = luaStartTimer();
   luaSetInstructionsLimit(lsWidgets, WIDGET_SCRIPTS_MAX_INSTRUCTIONS);
   LuaWidgetFactory * factory = (LuaWidgetFactory *)this->factory;
   lua_rawgeti(lsWidgets, LUA_REGISTRYINDEX, factory->updateFunction);
@@ -352,7 +355,9 @@ void LuaWidget::update()
     l_pushtableint(option->name, persistentData->options[i].signedValue);
   }
 
-  if (lua_pcall(lsWidgets, 2, 0, 0) != 0) {
+  int status = lua_pcall(lsWidgets, 2, 0, 0);
+  luaUpdateScriptStats(luaWidgetsRunStats, t0);
+  if (status != 0) {
     setErrorMessage("update()");
   }
 }
@@ -383,11 +388,14 @@ void LuaWidget::refresh()
     return;
   }
 
+  LuaTimer t0 = luaStartTimer();
   luaSetInstructionsLimit(lsWidgets, WIDGET_SCRIPTS_MAX_INSTRUCTIONS);
   LuaWidgetFactory * factory = (LuaWidgetFactory *)this->factory;
   lua_rawgeti(lsWidgets, LUA_REGISTRYINDEX, factory->refreshFunction);
   lua_rawgeti(lsWidgets, LUA_REGISTRYINDEX, widgetData);
-  if (lua_pcall(lsWidgets, 1, 0, 0) != 0) {
+  int status = lua_pcall(lsWidgets, 1, 0, 0);
+  luaUpdateScriptStats(luaWidgetsRunStats, t0);
+  if (status != 0) {
     setErrorMessage("refresh()");
   }
 }
@@ -399,9 +407,12 @@ void LuaWidget::background()
   luaSetInstructionsLimit(lsWidgets, WIDGET_SCRIPTS_MAX_INSTRUCTIONS);
   LuaWidgetFactory * factory = (LuaWidgetFactory *)this->factory;
   if (factory->backgroundFunction) {
+    LuaTimer t0 = luaStartTimer();
     lua_rawgeti(lsWidgets, LUA_REGISTRYINDEX, factory->backgroundFunction);
     lua_rawgeti(lsWidgets, LUA_REGISTRYINDEX, widgetData);
-    if (lua_pcall(lsWidgets, 1, 0, 0) != 0) {
+    int status = lua_pcall(lsWidgets, 1, 0, 0);
+    luaUpdateScriptStats(luaWidgetsRunStats, t0);
+    if (status != 0) {
       setErrorMessage("background()");
     }
   }
@@ -534,6 +545,7 @@ void luaInitThemesAndWidgets()
   lsWidgets = lua_newstate(l_alloc, NULL);   //we use Lua default allocator
 #endif
   if (lsWidgets) {
+    luaGcReset(lsWidgets);
     // install our panic handler
     lua_atpanic(lsWidgets, &custom_lua_atpanic);
 
@@ -122,9 +122,10 @@ void checkEeprom()
     rambackupDirtyMsk = 0;
   }
 #endif
-  if (TIME_TO_WRITE()) {
+  if (storageIsWriting())
+    storageWriteProcess();
+  else if (TIME_TO_WRITE())
     storageCheck(false);
-  }
 }
 #endif
 
@@ -428,6 +429,9 @@ void perMain()
 {
   DEBUG_TIMER_START(debugTimerPerMain1);
 
+  // the edits of the previous loop are written now
+  checkStorageChanges();
+
 #if defined(PCBSKY9X) && !defined(REVA)
   calcConsumption();
 #endif
@@ -468,6 +472,7 @@ void perMain()
 #if defined(STM32) && defined(SDCARD)
   if (!usbPlugged() && SD_CARD_PRESENT() && !sdMounted()) {
     sdMount();
+    invalidateModelAudioFiles();
   }
 #endif
 
@@ -143,6 +143,111 @@ int expo(int x, int k)
   return neg ? -y : y;
 }
 
+/*
+ expo() and the expo weight split in a part which only depends on the parameter, computed
+ once per expo line by applyExpos(), and a part per value made of multiplications and shifts.
+ The F0 has no divide instruction, the divisions by 100 and 1000 were the most expensive part.
+ */
+
+#define EXPO_COEF_EXTENDED             0x200
+
+// k -100 to 100, same as expo()
+int expoCoef(int k)
+{
+  int coef;
+  unsigned int absk = abs(k);
+
+#if defined(EXTENDED_EXPO)
+  if (absk > 80)
+    coef = calc100to256(absk) | EXPO_COEF_EXTENDED;
+  else
+    coef = calc100to256(absk + (absk >> 2));
+#else
+  coef = calc100to256(absk);
+#endif
+
+  return k < 0 ? -coef : coef;
+}
+
+// same as expou() with the coefficient of k
+static inline unsigned int expouCoef(unsigned int x, unsigned int coef)
+{
+  uint32_t k = coef & ~EXPO_COEF_EXTENDED;
+
+  uint32_t value = (uint32_t) x*x;
+  value *= k;
+  value >>= 8;
+  value *= (uint32_t)x;
+
+#if defined(EXTENDED_EXPO)
+  if (coef & EXPO_COEF_EXTENDED) {
+    value >>= 16;
+    value *= (uint32_t)x;
+    value >>= 4;
+    value *= (uint32_t)x;
+  }
+#endif
+
+  value >>= 12;
+  value += (256-k) * x + 128;
+
+  return value >> 8;
+}
+
+int expoWithCoef(int x, int coef)
+{
+  if (coef == 0) {
+    return x;
+  }
+
+  int y;
+  bool neg = (x < 0);
+
+  if (neg) {
+    x = -x;
+  }
+  if (x > (int)RESXu) {
+    x = RESXu;
+  }
+  if (coef < 0) {
+    y = RESXu - expouCoef(RESXu-x, -coef);
+  }
+  else {
+    y = expouCoef(x, coef);
+  }
+  return neg ? -y : y;
+}
+
+// weight -1000 to 1000 (PREC1 percents) => abs(weight) / 1000 in Q20, rounded up
+uint32_t weightCoef(int weight)
+{
+  return (((uint32_t)abs(weight) << 20) + 999) / 1000;
+}
+
+// div_and_round(value * weight, 1000) for abs(value) <= RESX: the coefficient is rounded up by
+// less than RESX / 2^20 < 0.001, which never changes the rounded result of a multiple of 0.001
+int applyWeightCoef(int value, int weight, uint32_t coef)
+{
+  int result = ((uint32_t)abs(value) * coef + (1 << 19)) >> 20;
+  return ((value < 0) != (weight < 0)) ? -result : result;
+}
+
+// The coefficients of each expo line, they are computed again when the parameters
+// (which can be GVARs) change. Zero is valid for zero parameters.
+// Only the normal pass of the mixer task keeps them: the menus and the passes of the
+// inactive flight modes (with their own GVARs values) compute them on the stack.
+struct ExpoCoefs
+{
+  uint32_t weightCoef:21;
+  int32_t expoCoef:11;
+  int16_t weight;
+  int16_t offset;
+  int16_t offsetValue;
+  int8_t expo;
+};
+
+static ExpoCoefs expoCoefs[MAX_EXPOS];
+
 void applyExpos(int16_t * anas, uint8_t mode, uint8_t ovwrIdx, int16_t ovwrValue)
 {
   int8_t cur_chn = -1;
@@ -175,18 +280,39 @@ void applyExpos(int16_t * anas, uint8_t mode, uint8_t ovwrIdx, int16_t ovwrValue
 #endif
         cur_chn = ed->chn;
 
+        ExpoCoefs localCoefs = {};
+        ExpoCoefs & coefs = (mode == e_perout_mode_normal ? expoCoefs[i] : localCoefs);
+
         //========== CURVE=================
         if (ed->curve.value) {
-          v = applyCurve(v, ed->curve);
+          if (ed->curve.type == CURVE_REF_EXPO) {
+            int8_t expo = GET_GVAR_PREC1(ed->curve.value, -100, 100, mixerCurrentFlightMode) / 10;
+            if (expo != coefs.expo) {
+              coefs.expo = expo;
+              coefs.expoCoef = expoCoef(expo);
+            }
+            v = expoWithCoef(v, coefs.expoCoef);
+          }
+          else {
+            v = applyCurve(v, ed->curve);
+          }
         }
 
         //========== WEIGHT ===============
-        int32_t weight = GET_GVAR_PREC1(ed->weight, MIN_EXPO_WEIGHT, 100, mixerCurrentFlightMode);
-        v = div_and_round((int32_t)v * weight, 1000);
+        int16_t weight = GET_GVAR_PREC1(ed->weight, MIN_EXPO_WEIGHT, 100, mixerCurrentFlightMode);
+        if (weight != coefs.weight) {
+          coefs.weight = weight;
+          coefs.weightCoef = weightCoef(weight);
+        }
+        v = applyWeightCoef(v, weight, coefs.weightCoef);
 
         //========== OFFSET ===============
-        int32_t offset = GET_GVAR_PREC1(ed->offset, -100, 100, mixerCurrentFlightMode);
-        if (offset) v += div_and_round(calc100toRESX(offset), 10);
+        int16_t offset = GET_GVAR_PREC1(ed->offset, -100, 100, mixerCurrentFlightMode);
+        if (offset != coefs.offset) {
+          coefs.offset = offset;
+          coefs.offsetValue = div_and_round(calc100toRESX(offset), 10);
+        }
+        v += coefs.offsetValue;
 
         //========== TRIMS ================
         if (ed->carryTrim < TRIM_ON)
@@ -282,6 +408,95 @@ int16_t applyLimits(uint8_t channel, int32_t value)
   return ofs;
 }
 
+/*
+ The limits of the channels compiled in arrays when they change (model load, edit), so that
+ applyLimitsAll() runs one short loop over all the channels, which the compiler can unroll.
+ The channels which can't be compiled (curve, GVARs, symetrical) and the overridden ones
+ go through applyLimits().
+ limitsChanged() must be called once an edit is written (see checkStorageChanges()), the
+ mixer may have compiled the limits between storageDirty() and the write.
+ */
+
+static int16_t limitsMin[MAX_OUTPUT_CHANNELS];
+static int16_t limitsMax[MAX_OUTPUT_CHANNELS];
+static int16_t limitsOfs[MAX_OUTPUT_CHANNELS];  // within min and max
+static int8_t limitsSign[MAX_OUTPUT_CHANNELS];  // -1 when inverted
+static uint32_t limitsSlowChannels;
+static bool limitsLoaded;
+
+static_assert(MAX_OUTPUT_CHANNELS <= 32, "The slow channels don't fit in a 32 bits mask");
+
+void limitsChanged()
+{
+  limitsLoaded = false;
+}
+
+static void loadLimits()
+{
+  limitsSlowChannels = 0;
+
+  for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++) {
+    LimitData * lim = limitAddress(i);
+
+    if (lim->curve ||
+#if defined(PPM_LIMITS_SYMETRICAL)
+        lim->symetrical ||
+#endif
+        GV_IS_GV_VALUE(lim->min, -GV_RANGELARGE, GV_RANGELARGE) ||
+        GV_IS_GV_VALUE(lim->max, -GV_RANGELARGE, GV_RANGELARGE) ||
+        GV_IS_GV_VALUE(lim->offset, -1000, 1000)) {
+      limitsSlowChannels |= (1u << i);
+      limitsMin[i] = limitsMax[i] = limitsOfs[i] = 0;
+      limitsSign[i] = 1;
+      continue;
+    }
+
+    int16_t lim_p = LIMIT_MAX_RESX(lim);
+    int16_t lim_n = LIMIT_MIN_RESX(lim);
+    limitsMin[i] = lim_n;
+    limitsMax[i] = lim_p;
+    int16_t ofs = LIMIT_OFS_RESX(lim);
+    if (ofs > lim_p) ofs = lim_p;
+    if (ofs < lim_n) ofs = lim_n;
+    limitsOfs[i] = ofs;
+    limitsSign[i] = lim->revert ? -1 : 1;
+  }
+
+  limitsLoaded = true;
+}
+
+// same as applyLimits() on all channels
+// outputs (channelOutputs) is read by the pulses interrupt, each channel is written once
+void applyLimitsAll(const int32_t * values, int16_t * outputs)
+{
+  if (!limitsLoaded) {
+    loadLimits();
+  }
+
+  uint32_t slowChannels = limitsSlowChannels;
+#if defined(OVERRIDE_CHANNEL_FUNCTION)
+  for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++) {
+    if (safetyCh[i] != OVERRIDE_CHANNEL_UNDEFINED) {
+      slowChannels |= (1u << i);
+    }
+  }
+#endif
+
+  for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++) {
+    int32_t value = limit(int32_t(-RESXl*256), values[i], int32_t(RESXl*256));
+    int32_t ofs = limitsOfs[i];
+    int32_t lim_p = limitsMax[i];
+    int32_t lim_n = limitsMin[i];
+    value *= (value > 0) ? (lim_p - ofs) : (-lim_n + ofs);  //  div by 1024*256 -> output = -1024..1024
+    // Round away from 0 (0 stays 0)
+    ofs += (value + (value < 0 ? (1<<17)-1 : (1<<17))) >> 18;
+    // same order as applyLimits() in case min > max
+    ofs = (ofs > lim_p) ? lim_p : ofs;
+    ofs = (ofs < lim_n) ? lim_n : ofs;
+    outputs[i] = (slowChannels & (1u << i)) ? applyLimits(i, values[i]) : ofs * limitsSign[i];
+  }
+}
+
 // TODO same naming convention than the drawSource
 
 getvalue_t getValue(mixsrc_t i)
@@ -972,21 +1187,27 @@ void evalMixes(uint8_t tick10ms)
   }
 
   //========== LIMITS ===============
+  int32_t * values = chans;
+  int32_t fadedChans[MAX_OUTPUT_CHANNELS];
+  if (flightModesFade) {
+    for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++) {
+      fadedChans[i] = (sum_chans512[i] / weight) << 4;
+    }
+    values = fadedChans;
+  }
+
   for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++) {
     // chans[i] holds data from mixer.   chans[i] = v*weight => 1024*256
     // later we multiply by the limit (up to 100) and then we need to normalize
     // at the end chans[i] = chans[i]/256 =>  -1024..1024
     // interpolate value with min/max so we get smooth motion from center to stop
     // this limits based on v original values and min=-1024, max=1024  RESX=1024
-    int32_t q = (flightModesFade ? (sum_chans512[i] / weight) << 4 : chans[i]);
-
-    ex_chans[i] = q / 256;
-
-    int16_t value = applyLimits(i, q);  // applyLimits will remove the 256 100% basis
-
-    channelOutputs[i] = value;  // copy consistent word to int-level
+    ex_chans[i] = values[i] / 256;
   }
 
+  // applyLimits will remove the 256 100% basis
+  applyLimitsAll(values, channelOutputs);
+
   if (tick10ms && flightModesFade) {
     uint16_t tick_delta = delta * tick10ms;
     for (uint8_t p=0; p<MAX_FLIGHT_MODES; p++) {
@@ -552,7 +552,7 @@ enum DisplayTrims {
   DISPLAY_TRIMS_ALWAYS
 };
 
-#define TOTAL_EEPROM_USAGE (sizeof(ModelData) * MAX_MODELS + sizeof(RadioData))
+#define TOTAL_EEPROM_USAGE (MODEL_DATA_SIZE * MAX_MODELS + sizeof(RadioData))
 
 extern RadioData g_eeGeneral;
 extern ModelData g_model;
@@ -19,6 +19,7 @@
  */
 
 #include "opentx.h"
+#include "analogs_filter.h"
 
 RadioData g_eeGeneral;
 ModelData g_model;
@@ -200,14 +201,158 @@ FlightModeData *flightModeAddress(uint8_t idx) {
   return &g_model.flightModeData[idx];
 }
 
+#if defined(MODEL_ARENA)
+// the lines after the end of a list read as an empty line
+static union {
+  ExpoData expo;
+  MixData mix;
+} emptyLine;
+
+static inline uint16_t arenaMixesSize() {
+  return g_model.arena.mixesCount * sizeof(MixData);
+}
+
+static inline uint16_t arenaUsedSize() {
+  return arenaMixesSize() + g_model.arena.exposCount * sizeof(ExpoData);
+}
+
+// the bytes after the lines in use are kept cleared
+static uint8_t *arenaInsert(uint16_t offset, uint16_t size) {
+  uint16_t used = arenaUsedSize();
+  if (used + size > MODEL_ARENA_SIZE)
+    return nullptr;
+  uint8_t *line = &g_model.arena.data[offset];
+  memmove(line + size, line, used - offset);
+  memclear(line, size);
+  return line;
+}
+
+static void arenaDelete(uint16_t offset, uint16_t size) {
+  uint16_t used = arenaUsedSize();
+  uint8_t *line = &g_model.arena.data[offset];
+  memmove(line, line + size, used - offset - size);
+  memclear(&g_model.arena.data[used - size], size);
+}
+
+ExpoData *expoAddress(uint8_t idx) {
+  if (idx < g_model.arena.exposCount)
+    return (ExpoData *)&g_model.arena.data[arenaMixesSize() + idx * sizeof(ExpoData)];
+  memclear(&emptyLine, sizeof(emptyLine));
+  return &emptyLine.expo;
+}
+
+bool hasFreeExpo() {
+  return g_model.arena.exposCount < MAX_EXPOS && arenaUsedSize() + sizeof(ExpoData) <= MODEL_ARENA_SIZE;
+}
+
+ExpoData *insertExpoData(uint8_t idx) {
+  if (idx > g_model.arena.exposCount || !hasFreeExpo())
+    return nullptr;
+  ExpoData *expo = (ExpoData *)arenaInsert(arenaMixesSize() + idx * sizeof(ExpoData), sizeof(ExpoData));
+  g_model.arena.exposCount++;
+  return expo;
+}
+
+void deleteExpoData(uint8_t idx) {
+  if (idx < g_model.arena.exposCount) {
+    arenaDelete(arenaMixesSize() + idx * sizeof(ExpoData), sizeof(ExpoData));
+    g_model.arena.exposCount--;
+  }
+}
+
+void clearExpoData() {
+  memclear(&g_model.arena.data[arenaMixesSize()], g_model.arena.exposCount * sizeof(ExpoData));
+  g_model.arena.exposCount = 0;
+}
+
+MixData *mixAddress(uint8_t idx) {
+  if (idx < g_model.arena.mixesCount)
+    return (MixData *)&g_model.arena.data[idx * sizeof(MixData)];
+  memclear(&emptyLine, sizeof(emptyLine));
+  return &emptyLine.mix;
+}
+
+bool hasFreeMix() {
+  return g_model.arena.mixesCount < MAX_MIXERS && arenaUsedSize() + sizeof(MixData) <= MODEL_ARENA_SIZE;
+}
+
+MixData *insertMixData(uint8_t idx) {
+  if (idx > g_model.arena.mixesCount || !hasFreeMix())
+    return nullptr;
+  MixData *mix = (MixData *)arenaInsert(idx * sizeof(MixData), sizeof(MixData));
+  g_model.arena.mixesCount++;
+  return mix;
+}
+
+void deleteMixData(uint8_t idx) {
+  if (idx < g_model.arena.mixesCount) {
+    arenaDelete(idx * sizeof(MixData), sizeof(MixData));
+    g_model.arena.mixesCount--;
+  }
+}
+
+void clearMixData() {
+  if (g_model.arena.mixesCount > 0) {
+    arenaDelete(0, arenaMixesSize());
+    g_model.arena.mixesCount = 0;
+  }
+}
+#else
 ExpoData *expoAddress(uint8_t idx) {
   return &g_model.expoData[idx];
 }
 
+bool hasFreeExpo() {
+  return !EXPO_VALID(&g_model.expoData[MAX_EXPOS - 1]);
+}
+
+ExpoData *insertExpoData(uint8_t idx) {
+  if (idx >= MAX_EXPOS)
+    return nullptr;
+  ExpoData *expo = expoAddress(idx);
+  memmove(expo + 1, expo, (MAX_EXPOS - (idx + 1)) * sizeof(ExpoData));
+  memclear(expo, sizeof(ExpoData));
+  return expo;
+}
+
+void deleteExpoData(uint8_t idx) {
+  ExpoData *expo = expoAddress(idx);
+  memmove(expo, expo + 1, (MAX_EXPOS - (idx + 1)) * sizeof(ExpoData));
+  memclear(&g_model.expoData[MAX_EXPOS - 1], sizeof(ExpoData));
+}
+
+void clearExpoData() {
+  memclear(g_model.expoData, sizeof(g_model.expoData));
+}
+
 MixData *mixAddress(uint8_t idx) {
   return &g_model.mixData[idx];
 }
 
+bool hasFreeMix() {
+  return g_model.mixData[MAX_MIXERS - 1].srcRaw == 0;
+}
+
+MixData *insertMixData(uint8_t idx) {
+  if (idx >= MAX_MIXERS)
+    return nullptr;
+  MixData *mix = mixAddress(idx);
+  memmove(mix + 1, mix, (MAX_MIXERS - (idx + 1)) * sizeof(MixData));
+  memclear(mix, sizeof(MixData));
+  return mix;
+}
+
+void deleteMixData(uint8_t idx) {
+  MixData *mix = mixAddress(idx);
+  memmove(mix, mix + 1, (MAX_MIXERS - (idx + 1)) * sizeof(MixData));
+  memclear(&g_model.mixData[MAX_MIXERS - 1], sizeof(MixData));
+}
+
+void clearMixData() {
+  memclear(g_model.mixData, sizeof(g_model.mixData));
+}
+#endif
+
 LimitData *limitAddress(uint8_t idx) {
   return &g_model.limitData[idx];
 }
@@ -318,7 +463,7 @@ uint16_t evalChkSum() {
 }
 
 void clearInputs() {
-  memset(g_model.expoData, 0, sizeof(g_model.expoData));  // clear all expos
+  clearExpoData();  // clear all expos
 }
 
 void defaultInputs() {
@@ -326,7 +471,9 @@ void defaultInputs() {
 
   for (int i = 0; i < NUM_STICKS; i++) {
     uint8_t stick_index = channelOrder(i + 1);
-    ExpoData *expo = expoAddress(i);
+    ExpoData *expo = insertExpoData(i);
+    if (!expo)
+      break;  // no room left in the model arena
     expo->srcRaw = MIXSRC_Rud - 1 + stick_index;
     expo->curve.type = CURVE_REF_EXPO;
     expo->chn = i;
@@ -353,7 +500,9 @@ void applyDefaultTemplate() {
   defaultInputs();  // calls storageDirty internally
 
   for (int i = 0; i < NUM_STICKS; i++) {
-    MixData *mix = mixAddress(i);
+    MixData *mix = insertMixData(i);
+    if (!mix)
+      break;
     mix->destCh = i;
     mix->weight = 100;
     mix->srcRaw = i + 1;
@@ -512,8 +661,8 @@ void modelDefault(uint8_t id) {
 }
 
 bool isInputRecursive(int index) {
-  ExpoData *line = expoAddress(0);
-  for (int i = 0; i < MAX_EXPOS; i++, line++) {
+  for (int i = 0; i < MAX_EXPOS; i++) {
+    ExpoData *line = expoAddress(i);
     if (line->chn > index)
       break;
     else if (line->chn < index)
@@ -1006,6 +1155,11 @@ void alert(const char *title, const char *msg, uint8_t sound) {
   while (1) {
     RTOS_WAIT_MS(10);
 
+#if defined(SIMU)
+    if (simuIsVirtualClock())  // nobody to press a key in the headless simulator
+      break;
+#endif
+
     if (keyDown())  // wait for key release
       break;
 
@@ -1218,11 +1372,8 @@ void getADC() {
     // Variables mapping:
     //   * <in> = v
     //   * <out> = s_anaFilt[x]
-    uint16_t previous = s_anaFilt[x] / JITTER_ALPHA;
-    uint16_t diff = (v > previous) ? (v - previous) : (previous - v);
-    if (!g_eeGeneral.jitterFilter && diff < (10 * ANALOG_MULTIPLIER)) {  // g_eeGeneral.jitterFilter is inverted, 0 - active
-      // apply jitter filter
-      s_anaFilt[x] = (s_anaFilt[x] - previous) + v;
+    if (!g_eeGeneral.jitterFilter) {  // g_eeGeneral.jitterFilter is inverted, 0 - active
+      s_anaFilt[x] = jitterFilter(s_anaFilt[x], v, JITTER_ALPHA, 10 * ANALOG_MULTIPLIER);
     } else {
       // use unfiltered value
       s_anaFilt[x] = v * JITTER_ALPHA;
@@ -1595,6 +1746,10 @@ void opentxResume() {
   menuHandlers[0] = menuMainView;
 
   sdMount();
+#if defined(SDCARD)
+  // the sounds may have changed during the USB session
+  invalidateModelAudioFiles();
+#endif
   storageReadAll();
 #if defined(PCBHORUS)
   loadTheme();
@@ -323,6 +323,14 @@ typedef struct {
   MASK_CFN_TYPE  activeSwitches;
   tmr10ms_t lastFunctionTime[MAX_SPECIAL_FUNCTIONS];
 
+  // functions indexed by their trigger switch, built by evalFunctions()
+  bool indexValid;
+  uint8_t switchesCount;
+  MASK_CFN_TYPE configuredFunctions;                // the functions with a switch
+  MASK_CFN_TYPE midposDelaySwitches;                // the switches read with GETSWITCH_MIDPOS_DELAY
+  uint8_t switchFunction[MAX_SPECIAL_FUNCTIONS];    // the first function of each distinct trigger switch
+  uint8_t functionSwitch[MAX_SPECIAL_FUNCTIONS];    // the index in switchFunction[] of each function trigger
+
   inline bool isFunctionActive(uint8_t func)
   {
     return activeFunctions & ((MASK_FUNC_TYPE)1 << func);
@@ -639,6 +647,10 @@ void checkThrottleStick();
 void checkSwitches();
 void checkAlarm();
 void checkAll();
+void checkRSSIAlarmsDisabled();
+#if defined(PCBTARANIS) || defined(PCBHORUS) || defined(PCBI6X)
+void checkFailsafe();
+#endif
 
 void getADC();
 static inline void GET_ADC_IF_MIXER_NOT_RUNNING()
@@ -766,6 +778,10 @@ extern int16_t            channelOutputs[MAX_OUTPUT_CHANNELS];
 #define NUM_INPUTS      (MAX_INPUTS)
 
 int expo(int x, int k);
+int expoCoef(int k);
+int expoWithCoef(int x, int coef);
+uint32_t weightCoef(int weight);
+int applyWeightCoef(int value, int weight, uint32_t coef);
 
 inline void getMixSrcRange(const int source, int16_t & valMin, int16_t & valMax, LcdFlags * flags = 0)
 {
@@ -859,6 +875,8 @@ void defaultInputs();
 
 void applyExpos(int16_t * anas, uint8_t mode, uint8_t ovwrIdx=0, int16_t ovwrValue=0);
 int16_t applyLimits(uint8_t channel, int32_t value);
+void applyLimitsAll(const int32_t * values, int16_t * outputs);
+void limitsChanged();
 
 void evalInputs(uint8_t mode);
 uint16_t anaIn(uint8_t chan);
@@ -878,6 +896,17 @@ MixData * mixAddress(uint8_t idx);
 LimitData * limitAddress(uint8_t idx);
 LogicalSwitchData * lswAddress(uint8_t idx);
 
+// The expos and the mixes are lists: a line is inserted / deleted with these functions
+// (the lines after it are moved), nullptr is returned when there is no room for a new line
+bool hasFreeExpo();
+ExpoData * insertExpoData(uint8_t idx);
+void deleteExpoData(uint8_t idx);
+void clearExpoData();
+bool hasFreeMix();
+MixData * insertMixData(uint8_t idx);
+void deleteMixData(uint8_t idx);
+void clearMixData();
+
 // static variables used in evalFlightModeMixes - moved here so they don't interfere with the stack
 // It's also easier to initialize them here.
 extern int8_t  virtualInputsTrims[NUM_INPUTS];
@@ -968,6 +997,12 @@ inline void customFunctionsReset()
   globalFunctionsContext.reset();
   modelFunctionsContext.reset();
 }
+// to be called when the switch or the type of a function changes
+inline void customFunctionsChanged()
+{
+  globalFunctionsContext.indexValid = false;
+  modelFunctionsContext.indexValid = false;
+}
 
 #include "telemetry/telemetry.h"
 #if defined(PCBI6X)
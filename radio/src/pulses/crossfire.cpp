@@ -19,9 +19,10 @@
  */
 
 #include "opentx.h"
+#include "channels_packing.h"
 
-#define CROSSFIRE_CH_BITS 11
 #define CROSSFIRE_CENTER            0x3E0
+#define CROSSFIRE_INPUT_MAX         4096   // any input beyond this saturates the output anyway
 
 #if defined(PPM_CENTER_ADJUSTABLE)
 #define CROSSFIRE_CENTER_CH_OFFSET(ch) ((2 * limitAddress(ch)->ppmCenter) + 1)  // + 1 is for rouding
@@ -56,18 +57,13 @@ uint8_t createCrossfireChannelsFrame(uint8_t* frame, int16_t* pulses) {
   *buf++ = 24;  // 1(ID) + 22 + 1(CRC)
   uint8_t* crc_start = buf;
   *buf++ = CHANNELS_ID;
-  uint32_t bits = 0;
-  uint8_t bitsavailable = 0;
+  uint16_t values[CROSSFIRE_CHANNELS_COUNT];
   for (int i = 0; i < CROSSFIRE_CHANNELS_COUNT; i++) {
-    uint32_t val = limit(0, CROSSFIRE_CENTER + (CROSSFIRE_CENTER_CH_OFFSET(i) * 4) / 5 + (pulses[i] * 4) / 5, 2 * CROSSFIRE_CENTER);
-    bits |= val << bitsavailable;
-    bitsavailable += CROSSFIRE_CH_BITS;
-    while (bitsavailable >= 8) {
-      *buf++ = bits;
-      bits >>= 8;
-      bitsavailable -= 8;
-    }
+    int32_t pulse = limit<int32_t>(-CROSSFIRE_INPUT_MAX, pulses[i], CROSSFIRE_INPUT_MAX);
+    values[i] = limit<int32_t>(0, CROSSFIRE_CENTER + channelScale4div5(CROSSFIRE_CENTER_CH_OFFSET(i)) + channelScale4div5(pulse), 2 * CROSSFIRE_CENTER);
   }
+  packChannels(buf, values);
+  buf += PACKED_CHANNELS_SIZE;
 #if defined(PCBI6X)
   *buf++ = crc8_hw(crc_start, 23);
 #else
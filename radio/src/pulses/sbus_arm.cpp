@@ -19,6 +19,7 @@
  */
 
 #include "opentx.h"
+#include "channels_packing.h"
 
 
 #define BITLEN_SBUS          (10*2) // 100000 Baud => 10uS per bit
@@ -85,7 +86,7 @@ void sendByteSbus(uint8_t b) //max 11 changes 0 10 10 10 10 P 1
 
 
 #define SBUS_NORMAL_CHANS           16
-#define SBUS_CHAN_BITS       11
+#define SBUS_INPUT_MAX              4096   // any input beyond this saturates the output anyway
 
 
 /* Definitions from CleanFlight/BetaFlight */
@@ -122,21 +123,17 @@ void setupPulsesSbus(uint8_t port)
   // Sync Byte
   sendByteSbus(SBUS_FRAME_BEGIN_BYTE);
 
-  uint32_t bits = 0;
-  uint8_t bitsavailable = 0;
-
   // byte 1-22, channels 0..2047, limits not really clear (B
+  uint16_t values[SBUS_NORMAL_CHANS];
   for (int i=0; i<SBUS_NORMAL_CHANS; i++) {
-    int value = getChannelValue(port, i);
-
-    value =  value*8/10 + SBUS_CHAN_CENTER;
-    bits |= limit(0, value, 2047) << bitsavailable;
-    bitsavailable += SBUS_CHAN_BITS;
-    while (bitsavailable >= 8) {
-      sendByteSbus((uint8_t) (bits & 0xff));
-      bits >>= 8;
-      bitsavailable -= 8;
-    }
+    int32_t value = limit<int32_t>(-SBUS_INPUT_MAX, getChannelValue(port, i), SBUS_INPUT_MAX);
+    values[i] = limit<int32_t>(0, channelScale4div5(value) + SBUS_CHAN_CENTER, PACKED_CHANNEL_MASK);
+  }
+
+  uint8_t frame[PACKED_CHANNELS_SIZE];
+  packChannels(frame, values);
+  for (int i=0; i<PACKED_CHANNELS_SIZE; i++) {
+    sendByteSbus(frame[i]);
   }
 
   // flags
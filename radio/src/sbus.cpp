@@ -20,6 +20,7 @@
 
 #include "opentx.h"
 #include "sbus.h"
+#include "channels_packing.h"
 
 #define SBUS_FRAME_GAP_DELAY   1000 // 500uS
 
@@ -29,9 +30,6 @@
 #define SBUS_FRAMELOST_BIT     2
 #define SBUS_FAILSAFE_BIT      3
 
-#define SBUS_CH_BITS           11
-#define SBUS_CH_MASK           ((1<<SBUS_CH_BITS)-1)
-
 #define SBUS_CH_CENTER         0x3E0
 
 
@@ -45,18 +43,10 @@ void processSbusFrame(uint8_t * sbus, int16_t * pulses, uint32_t size)
     return; // SBUS invalid frame or failsafe mode
   }
 
-  sbus++; // skip start byte
-
-  uint32_t inputbitsavailable = 0;
-  uint32_t inputbits = 0;
+  uint16_t values[PACKED_CHANNELS_COUNT];
+  unpackChannels(values, sbus + 1); // skip start byte
   for (uint32_t i=0; i<MAX_TRAINER_CHANNELS; i++) {
-    while (inputbitsavailable < SBUS_CH_BITS) {
-      inputbits |= *sbus++ << inputbitsavailable;
-      inputbitsavailable += 8;
-    }
-    *pulses++ = ((int32_t) (inputbits & SBUS_CH_MASK) - SBUS_CH_CENTER) * 5 / 8;
-    inputbitsavailable -= SBUS_CH_BITS;
-    inputbits >>= SBUS_CH_BITS;
+    pulses[i] = ((int32_t) values[i] - SBUS_CH_CENTER) * 5 / 8;
   }
 
   ppmInputValidityTimer = PPM_IN_VALID_TIMEOUT;
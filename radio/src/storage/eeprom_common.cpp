@@ -33,14 +33,14 @@ void eeLoadModel(uint8_t index)
     uint16_t size = eeLoadModelData(index);
 
 #if defined(SIMU) && defined(EEPROM_ZONE_SIZE)
-    if (sizeof(uint16_t) + sizeof(g_model) > EEPROM_ZONE_SIZE) {
-      TRACE("Model data size can't exceed %d bytes (%d bytes)", int(EEPROM_ZONE_SIZE-sizeof(uint16_t)), (int)sizeof(g_model));
+    if (sizeof(uint16_t) + MODEL_DATA_SIZE > EEPROM_ZONE_SIZE) {
+      TRACE("Model data size can't exceed %d bytes (%d bytes)", int(EEPROM_ZONE_SIZE-sizeof(uint16_t)), (int)MODEL_DATA_SIZE);
     }
 #endif
 
 #if defined(SIMU)
-    if (size > 0 && size != sizeof(g_model)) {
-      TRACE("Model data read=%d bytes vs %d bytes\n", size, (int)sizeof(ModelData));
+    if (size > 0 && size != MODEL_DATA_SIZE) {
+      TRACE("Model data read=%d bytes vs %d bytes\n", size, (int)MODEL_DATA_SIZE);
     }
 #endif
 
@@ -50,6 +50,14 @@ void eeLoadModel(uint8_t index)
       storageCheck(true);
       alarms = false;
     }
+#if defined(MODEL_ARENA)
+    else if (eeModelArenaOverflow()) {
+      // the model stored is kept, the default model in RAM is not written over it
+      ALERT(STR_STORAGE_WARNING, STR_NOFREEMIXER, AU_ERROR);
+      modelDefault(index);
+      alarms = false;
+    }
+#endif
 
     postModelLoad(alarms);
   }
@@ -608,12 +608,20 @@ const char * eeRestoreModel(uint8_t i_fileDst, char *model_name)
 #endif
 
 void RlcFile::writeRlc(uint8_t i_fileId, uint8_t typ, uint8_t *buf, uint16_t i_len, uint8_t sync_write)
+{
+  m_rlc_segment.buf = buf;
+  m_rlc_segment.len = i_len;
+  writeRlc(i_fileId, typ, &m_rlc_segment, 1, sync_write);
+}
+
+void RlcFile::writeRlc(uint8_t i_fileId, uint8_t typ, const RlcSegment * segments, uint8_t count, uint8_t sync_write)
 {
   create(i_fileId, typ, sync_write);
 
   m_write_step = WRITE_START_STEP;
-  m_rlc_buf = buf;
-  m_rlc_len = i_len;
+  m_rlc_segments = segments;
+  m_rlc_segments_count = count;
+  m_rlc_len = 0;
   m_cur_rlc_len = 0;
 #if defined (EEPROM_PROGRESS_BAR)
   m_ratio = (typ == FILE_TYP_MODEL ? 100 : 10);
@@ -639,19 +647,26 @@ void RlcFile::nextRlcWriteStep()
     return;
   }
 
+  while (m_rlc_len == 0 && m_rlc_segments_count > 0) {
+    m_rlc_buf = m_rlc_segments->buf;
+    m_rlc_len = m_rlc_segments->len;
+    m_rlc_segments++;
+    m_rlc_segments_count--;
+  }
+
   if (m_rlc_len>0) {
 
-    bool run0 = (m_rlc_buf[0] == 0);
+    bool run0 = (!m_rlc_buf || m_rlc_buf[0] == 0);
 
     for (i=1; 1; i++) {
-      bool cur0 = (i<m_rlc_len) ? (m_rlc_buf[i] == 0) : false;
+      bool cur0 = (i<m_rlc_len) ? (!m_rlc_buf || m_rlc_buf[i] == 0) : false;
       if (cur0 != run0 || cnt==0x3f || (cnt0 && cnt==0x0f) || i==m_rlc_len) {
         if (run0) {
           assert(cnt0==0);
           if (cnt<8 && i!=m_rlc_len)
             cnt0 = cnt; //aufbew fuer spaeter
           else {
-            m_rlc_buf+=cnt;
+            if (m_rlc_buf) m_rlc_buf+=cnt;
             m_rlc_len-=cnt;
             write1(cnt|0x40);
             return;
@@ -761,11 +776,89 @@ uint16_t eeLoadGeneralSettingsData()
   return theFile.readRlc((uint8_t*)&g_eeGeneral, sizeof(g_eeGeneral));
 }
 
+#if defined(MODEL_ARENA)
+static_assert(offsetof(ModelData, limitData) == offsetof(ModelData, arena) + sizeof(ModelArena), "ModelArena must be followed by limitData");
+static_assert(offsetof(ModelData, curves) == offsetof(ModelData, limitData) + sizeof(g_model.limitData), "limitData must be followed by curves");
+
+// Set when the lines of the model read do not fit in the arena, the model is then not written
+static bool modelArenaOverflow;
+
+bool eeModelArenaOverflow()
+{
+  return modelArenaOverflow;
+}
+
+// Reads a table of the model file into the arena, the empty lines at the end are not kept
+static uint16_t readArenaTableRlc(uint16_t & used, uint8_t & count, uint8_t lines, uint8_t size)
+{
+  uint8_t line[sizeof(MixData) > sizeof(ExpoData) ? sizeof(MixData) : sizeof(ExpoData)];
+  uint16_t result = 0;
+  count = 0;
+  for (uint8_t i = 0; i < lines; i++) {
+    result += theFile.readRlc(line, size);
+    bool empty = true;
+    for (uint8_t j = 0; j < size; j++) {
+      if (line[j]) {
+        empty = false;
+        break;
+      }
+    }
+    if (!empty) {
+      // the empty lines before this one are already cleared in the arena
+      uint16_t end = used + (i + 1) * size;
+      if (end <= MODEL_ARENA_SIZE) {
+        memcpy(&g_model.arena.data[used + i * size], line, size);
+        count = i + 1;
+      }
+      else {
+        TRACE("Model arena full, line %d dropped", i);
+        modelArenaOverflow = true;
+      }
+    }
+  }
+  used += count * size;
+  return result;
+}
+
+static uint16_t readModelRlc()
+{
+  uint16_t used = 0;
+  uint16_t size = theFile.readRlc((uint8_t *)&g_model, offsetof(ModelData, arena));
+  size += readArenaTableRlc(used, g_model.arena.mixesCount, MAX_MIXERS, sizeof(MixData));
+  size += theFile.readRlc((uint8_t *)g_model.limitData, sizeof(g_model.limitData));
+  size += readArenaTableRlc(used, g_model.arena.exposCount, MAX_EXPOS, sizeof(ExpoData));
+  size += theFile.readRlc((uint8_t *)&g_model + offsetof(ModelData, curves), sizeof(ModelData) - offsetof(ModelData, curves));
+  return size;
+}
+
+// The file is written from the model in RAM, the unused lines of the tables are written as zeroes
+static RlcSegment modelSegments[7];
+
+static void writeModelRlc(uint8_t sync_write)
+{
+  uint16_t mixesSize = g_model.arena.mixesCount * sizeof(MixData);
+  uint16_t exposSize = g_model.arena.exposCount * sizeof(ExpoData);
+  modelSegments[0] = { (uint8_t *)&g_model, offsetof(ModelData, arena) };
+  modelSegments[1] = { g_model.arena.data, mixesSize };
+  modelSegments[2] = { nullptr, uint16_t(MAX_MIXERS * sizeof(MixData) - mixesSize) };
+  modelSegments[3] = { (uint8_t *)g_model.limitData, sizeof(g_model.limitData) };
+  modelSegments[4] = { &g_model.arena.data[mixesSize], exposSize };
+  modelSegments[5] = { nullptr, uint16_t(MAX_EXPOS * sizeof(ExpoData) - exposSize) };
+  modelSegments[6] = { (uint8_t *)&g_model + offsetof(ModelData, curves), sizeof(ModelData) - offsetof(ModelData, curves) };
+  theFile.writeRlc(FILE_MODEL(g_eeGeneral.currModel), FILE_TYP_MODEL, modelSegments, DIM(modelSegments), sync_write);
+}
+#endif
+
 uint16_t eeLoadModelData(uint8_t index)
 {
   memset(&g_model, 0, sizeof(g_model));
   theFile.openRlc(FILE_MODEL(index));
+#if defined(MODEL_ARENA)
+  modelArenaOverflow = false;
+  return readModelRlc();
+#else
   return theFile.readRlc((uint8_t*)&g_model, sizeof(g_model));
+#endif
 }
 
 bool eeLoadGeneral()
@@ -837,7 +930,15 @@ void storageCheck(bool immediately)
   if (storageDirtyMsk & EE_MODEL) {
     TRACE("eeprom write model");
     storageDirtyMsk = 0;
+#if defined(MODEL_ARENA)
+    if (modelArenaOverflow) {
+      TRACE("eeprom model not written, it does not fit in the arena");
+      return;
+    }
+    writeModelRlc(immediately);
+#else
     theFile.writeRlc(FILE_MODEL(g_eeGeneral.currModel), FILE_TYP_MODEL, (uint8_t*)&g_model, sizeof(g_model), immediately);
+#endif
   }
 }
 
@@ -102,6 +102,13 @@ extern uint8_t s_sync_write;
 #define ENABLE_SYNC_WRITE(val)         s_sync_write = val;
 #define IS_SYNC_WRITE_ENABLE()         s_sync_write
 
+// A part of the data written by RlcFile::writeRlc(), buf == nullptr for len zeroes
+struct RlcSegment
+{
+  uint8_t * buf;
+  uint16_t len;
+};
+
 class RlcFile: public EFile
 {
     uint8_t  m_bRlc;      // control byte for run length decoder
@@ -118,6 +125,9 @@ class RlcFile: public EFile
     uint8_t m_write_step;
     uint16_t m_rlc_len;
     uint8_t * m_rlc_buf;
+    const RlcSegment * m_rlc_segments;
+    uint8_t m_rlc_segments_count;
+    RlcSegment m_rlc_segment;
     uint8_t m_cur_rlc_len;
     uint8_t m_write1_byte;
     uint8_t m_write_len;
@@ -141,6 +151,8 @@ class RlcFile: public EFile
     void nextWriteStep();
     void nextRlcWriteStep();
     void writeRlc(uint8_t i_fileId, uint8_t typ, uint8_t *buf, uint16_t i_len, uint8_t sync_write);
+    // the segments are written one after the other, they must stay valid until the write is finished
+    void writeRlc(uint8_t i_fileId, uint8_t typ, const RlcSegment * segments, uint8_t count, uint8_t sync_write);
 
     // flush the current write operation if any
     void flush();
@@ -194,6 +206,9 @@ void loadModel(int index, bool alarms=true);
 bool eepromOpen();
 void eeLoadModelName(uint8_t id, char *name);
 bool eeLoadGeneral();
+#if defined(MODEL_ARENA)
+bool eeModelArenaOverflow();
+#endif
 
 // For EEPROM backup/restore
 inline bool isEepromStart(const void * buffer)
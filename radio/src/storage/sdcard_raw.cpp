@@ -28,50 +28,193 @@ void getModelPath(char * path, const char * filename)
   strcpy(&path[sizeof(MODELS_PATH)], filename);
 }
 
-const char * writeFile(const char * filename, const uint8_t * data, uint16_t size)
-{
-  TRACE("writeFile(%s)", filename);
-  
+/*
+ The model and the radio settings are written asynchronously: storageCheck() takes a
+ snapshot of the data in storageBuffer, then checkEeprom() calls storageWriteProcess()
+ at each menus period to write it by chunks into a temporary file, which replaces the
+ file once complete. A power loss leaves the old file or the new one, never a truncated
+ one. The data is followed by its hash, a write is skipped if the hash did not change.
+ */
+
+#define STORAGE_HEADER_SIZE      8
+#define STORAGE_HASH_SIZE        4
+#define STORAGE_WRITE_CHUNK      1024
+#define STORAGE_DATA_MAX_SIZE    (sizeof(ModelData) > sizeof(RadioData) ? sizeof(ModelData) : sizeof(RadioData))
+
+enum StorageWriteState {
+  STORAGE_WRITE_IDLE,
+  STORAGE_WRITE_DATA,
+  STORAGE_WRITE_COMMIT,
+};
+
+static uint8_t storageBuffer[STORAGE_HEADER_SIZE + STORAGE_DATA_MAX_SIZE + STORAGE_HASH_SIZE];
+
+static struct {
+  uint8_t state;
+  uint8_t msk;
+  uint32_t size;
+  uint32_t written;
+  uint32_t hash;
+  tmr10ms_t start;
   FIL file;
-  unsigned char buf[8];
-  UINT written;
+  char path[256];
+} storageWrite;
 
-  FRESULT result = f_open(&file, filename, FA_CREATE_ALWAYS | FA_WRITE);
-  if (result != FR_OK) {
-    return SDCARD_ERROR(result);
+// hash of the data in the files, to skip the writes which would not change them
+static uint32_t generalHash;
+static uint32_t modelHash;
+static char modelHashFilename[LEN_MODEL_FILENAME + 1];
+
+uint32_t storageWriteCount;
+uint32_t storageSkipCount;
+tmr10ms_t storageMaxWriteDuration;
+
+// 2 CRC16 with different polynomials, for a 32 bits hash
+static uint32_t storageHash(const uint8_t * data, uint32_t size)
+{
+  return (crc16(CRC_1021, data, size) << 16) | crc16(CRC_1189, data, size);
+}
+
+static void getTempPath(char * tmpPath, const char * path)
+{
+  strcpy(tmpPath, path);
+  strcat(tmpPath, ".tmp");
+}
+
+static const char * storageWriteAbort(FRESULT result)
+{
+  TRACE("storageWrite(%s) error=%d", storageWrite.path, result);
+  f_close(&storageWrite.file);
+  storageWrite.state = STORAGE_WRITE_IDLE;
+  // written again at the next check
+  storageDirty(storageWrite.msk);
+  return SDCARD_ERROR(result);
+}
+
+bool storageIsWriting()
+{
+  return storageWrite.state != STORAGE_WRITE_IDLE;
+}
+
+// the next step of the write started by writeFile(), returns an error or NULL
+const char * storageWriteProcess()
+{
+  FRESULT result;
+
+  if (storageWrite.state == STORAGE_WRITE_DATA) {
+    uint32_t size = min<uint32_t>(STORAGE_WRITE_CHUNK, storageWrite.size - storageWrite.written);
+    UINT written;
+    result = f_write(&storageWrite.file, &storageBuffer[storageWrite.written], size, &written);
+    if (result != FR_OK || written != size) {
+      return storageWriteAbort(result);
+    }
+    storageWrite.written += size;
+    if (storageWrite.written == storageWrite.size) {
+      storageWrite.state = STORAGE_WRITE_COMMIT;
+    }
   }
+  else if (storageWrite.state == STORAGE_WRITE_COMMIT) {
+    result = f_close(&storageWrite.file);
+    if (result != FR_OK) {
+      return storageWriteAbort(result);
+    }
+    char tmpPath[256];
+    getTempPath(tmpPath, storageWrite.path);
+    f_unlink(storageWrite.path);
+    result = f_rename(tmpPath, storageWrite.path);
+    if (result != FR_OK) {
+      return storageWriteAbort(result);
+    }
+    storageWrite.state = STORAGE_WRITE_IDLE;
 
-  *(uint32_t*)&buf[0] = OTX_FOURCC;
-  buf[4] = EEPROM_VER;
-  buf[5] = 'M';
-  *(uint16_t*)&buf[6] = size;
+    if (storageWrite.msk & EE_GENERAL) {
+      generalHash = storageWrite.hash;
+    }
+    else {
+      modelHash = storageWrite.hash;
+    }
 
-  result = f_write(&file, buf, 8, &written);
-  if (result != FR_OK || written != 8) {
-    f_close(&file);
-    return SDCARD_ERROR(result);
+    tmr10ms_t duration = get_tmr10ms() - storageWrite.start;
+    if (duration > storageMaxWriteDuration) {
+      storageMaxWriteDuration = duration;
+    }
+    storageWriteCount++;
   }
 
-  result = f_write(&file, data, size, &written);
-  if (result != FR_OK || written != size) {
-    f_close(&file);
+  return NULL;
+}
+
+// starts the write of the data snapshot (or skips it if the file already holds it)
+static const char * writeFile(const char * filename, const uint8_t * data, uint16_t size, uint8_t msk)
+{
+  uint32_t hash = storageHash(data, size);
+  if (hash == (msk & EE_GENERAL ? generalHash : modelHash)) {
+    TRACE("writeFile(%s) skipped", filename);
+    storageSkipCount++;
+    return NULL;
+  }
+
+  TRACE("writeFile(%s)", filename);
+
+  *(uint32_t*)&storageBuffer[0] = OTX_FOURCC;
+  storageBuffer[4] = EEPROM_VER;
+  storageBuffer[5] = 'M';
+  *(uint16_t*)&storageBuffer[6] = size;
+  memcpy(&storageBuffer[STORAGE_HEADER_SIZE], data, size);
+  memcpy(&storageBuffer[STORAGE_HEADER_SIZE + size], &hash, STORAGE_HASH_SIZE);
+
+  char tmpPath[256];
+  getTempPath(tmpPath, filename);
+  FRESULT result = f_open(&storageWrite.file, tmpPath, FA_CREATE_ALWAYS | FA_WRITE);
+  if (result != FR_OK) {
+    storageDirty(msk);
     return SDCARD_ERROR(result);
   }
 
-  f_close(&file);
+  strcpy(storageWrite.path, filename);
+  storageWrite.msk = msk;
+  storageWrite.size = STORAGE_HEADER_SIZE + size + STORAGE_HASH_SIZE;
+  storageWrite.written = 0;
+  storageWrite.hash = hash;
+  storageWrite.start = get_tmr10ms();
+  storageWrite.state = STORAGE_WRITE_DATA;
   return NULL;
 }
 
+// finishes the write in progress
+static const char * storageFlush()
+{
+  const char * error = NULL;
+  while (storageIsWriting()) {
+    error = storageWriteProcess();
+  }
+  return error;
+}
+
 const char * writeModel()
 {
   char path[256];
   getModelPath(path, g_eeGeneral.currModelFilename);
-  return writeFile(path, (uint8_t *)&g_model, sizeof(g_model));
+  if (strncmp(modelHashFilename, g_eeGeneral.currModelFilename, LEN_MODEL_FILENAME)) {
+    // another model file, the hash is not its hash
+    strncpy(modelHashFilename, g_eeGeneral.currModelFilename, LEN_MODEL_FILENAME);
+    modelHash = 0;
+  }
+  return writeFile(path, (uint8_t *)&g_model, sizeof(g_model), EE_MODEL);
 }
 
 const char * openFile(const char * fullpath, FIL* file, uint16_t* size)
 {
   FRESULT result = f_open(file, fullpath, FA_OPEN_EXISTING | FA_READ);
+  if (result == FR_NO_FILE) {
+    // the power was lost between the removal of the file and the rename of the new one
+    char tmpPath[256];
+    getTempPath(tmpPath, fullpath);
+    if (f_rename(tmpPath, fullpath) == FR_OK) {
+      TRACE("openFile(%s) recovered", fullpath);
+      result = f_open(file, fullpath, FA_OPEN_EXISTING | FA_READ);
+    }
+  }
   if (result != FR_OK) {
     return SDCARD_ERROR(result);
   }
@@ -100,17 +243,23 @@ const char * openFile(const char * fullpath, FIL* file, uint16_t* size)
   return NULL;
 }
 
-const char * loadFile(const char * fullpath, uint8_t * data, uint16_t maxsize)
+// hash is set to the hash of the data, 0 if it is not the data of the whole file
+const char * loadFile(const char * fullpath, uint8_t * data, uint16_t maxsize, uint32_t * hash = NULL)
 {
   FIL      file;
   UINT     read;
   uint16_t size;
 
   TRACE("loadFile(%s)", fullpath);
-  
+
+  if (hash) {
+    *hash = 0;
+  }
+
   const char* err = openFile(fullpath, &file, &size);
   if (err) return err;
 
+  bool complete = (size <= maxsize);
   size = min<uint16_t>(maxsize, size);
   FRESULT result = f_read(&file, data, size, &read);
   if (result != FR_OK || read != size) {
@@ -118,6 +267,18 @@ const char * loadFile(const char * fullpath, uint8_t * data, uint16_t maxsize)
     return SDCARD_ERROR(result);
   }
 
+  // the files written before the hash was added don't have it
+  uint32_t fileHash;
+  if (complete && f_read(&file, &fileHash, STORAGE_HASH_SIZE, &read) == FR_OK && read == STORAGE_HASH_SIZE) {
+    if (fileHash != storageHash(data, size)) {
+      f_close(&file);
+      return SDCARD_ERROR(FR_INT_ERR);
+    }
+    if (hash) {
+      *hash = fileHash;
+    }
+  }
+
   f_close(&file);
   return NULL;
 }
@@ -129,11 +290,19 @@ const char * readModel(const char * filename, uint8_t * buffer, uint32_t size)
   return loadFile(path, buffer, size);
 }
 
+static const char * loadCurrentModel(const char * filename)
+{
+  char path[256];
+  getModelPath(path, filename);
+  strncpy(modelHashFilename, filename, LEN_MODEL_FILENAME);
+  return loadFile(path, (uint8_t *)&g_model, sizeof(g_model), &modelHash);
+}
+
 const char * loadModel(const char * filename, bool alarms)
 {
   preModelLoad();
 
-  const char * error = readModel(filename, (uint8_t *)&g_model, sizeof(g_model));
+  const char * error = loadCurrentModel(filename);
   if (error) {
     TRACE("loadModel error=%s", error);
   }
@@ -151,7 +320,7 @@ const char * loadModel(const char * filename, bool alarms)
 
 const char * loadRadioSettingsSettings()
 {
-  const char * error = loadFile(RADIO_SETTINGS_PATH, (uint8_t *)&g_eeGeneral, sizeof(g_eeGeneral));
+  const char * error = loadFile(RADIO_SETTINGS_PATH, (uint8_t *)&g_eeGeneral, sizeof(g_eeGeneral), &generalHash);
   if (error) {
     TRACE("loadRadioSettingsSettings error=%s", error);
   }
@@ -161,11 +330,19 @@ const char * loadRadioSettingsSettings()
 
 const char * writeGeneralSettings()
 {
-  return writeFile(RADIO_SETTINGS_PATH, (uint8_t *)&g_eeGeneral, sizeof(g_eeGeneral));
+  return writeFile(RADIO_SETTINGS_PATH, (uint8_t *)&g_eeGeneral, sizeof(g_eeGeneral), EE_GENERAL);
 }
 
+// starts the next write, immediately = all the writes are done before returning
 void storageCheck(bool immediately)
 {
+  if (immediately) {
+    storageFlush();
+  }
+  else if (storageIsWriting()) {
+    return;
+  }
+
   if (storageDirtyMsk & EE_GENERAL) {
     TRACE("eeprom write general");
     storageDirtyMsk -= EE_GENERAL;
@@ -173,6 +350,13 @@ void storageCheck(bool immediately)
     if (error) {
       TRACE("writeGeneralSettings error=%s", error);
     }
+    if (!immediately) {
+      return;
+    }
+    error = storageFlush();
+    if (error) {
+      TRACE("writeGeneralSettings error=%s", error);
+    }
   }
 
   if (storageDirtyMsk & EE_MODEL) {
@@ -182,6 +366,12 @@ void storageCheck(bool immediately)
     if (error) {
       TRACE("writeModel error=%s", error);
     }
+    if (immediately) {
+      error = storageFlush();
+      if (error) {
+        TRACE("writeModel error=%s", error);
+      }
+    }
   }
 }
 
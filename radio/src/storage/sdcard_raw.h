@@ -35,6 +35,13 @@ const char * readModel(const char * filename, uint8_t * buffer, uint32_t size);
 const char * loadModel(const char * filename, bool alarms=true);
 const char * createModel();
 
+bool storageIsWriting();
+const char * storageWriteProcess();
+
+extern uint32_t storageWriteCount;
+extern uint32_t storageSkipCount;
+extern tmr10ms_t storageMaxWriteDuration;
+
 PACK(struct RamBackup {
   uint16_t size;
   uint8_t data[4094];
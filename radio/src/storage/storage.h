@@ -47,12 +47,17 @@ void storageEraseAll(bool warn);
 void storageFormat();
 void storageReadAll();
 void storageDirty(uint8_t msk);
+void checkStorageChanges();
 void storageCheck(bool immediately);
 void storageFlushCurrentModel();
 
 void preModelLoad();
 void postModelLoad(bool alarms);
 
+#if defined(MODEL_ARENA) && (!defined(EEPROM_RLC) || defined(EEPROM_CONVERSIONS) || defined(RAMBACKUP))
+  #error "MODEL_ARENA is only supported with the EEPROM_RLC storage, without conversions and RAM backup"
+#endif
+
 #if defined(EEPROM_RLC)
 #include "eeprom_common.h"
 #include "eeprom_rlc.h"
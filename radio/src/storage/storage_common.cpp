@@ -22,6 +22,7 @@
 
 uint8_t storageDirtyMsk;
 tmr10ms_t storageDirtyTime10ms;
+static uint8_t storageChangedMsk;  // edits not yet seen by checkStorageChanges()
 
 #if defined(RAMBACKUP)
 uint8_t rambackupDirtyMsk;
@@ -32,12 +33,35 @@ void storageDirty(uint8_t msk) {
   storageDirtyMsk |= msk;
   storageDirtyTime10ms = get_tmr10ms();
 
+  // the model or the radio settings may have been edited
+  customFunctionsChanged();
+  if (msk & EE_MODEL) {
+    calculatedSensorsChanged();
+    limitsChanged();
+  }
+  storageChangedMsk |= msk;
+
 #if defined(RAMBACKUP)
   rambackupDirtyMsk = storageDirtyMsk;
   rambackupDirtyTime10ms = storageDirtyTime10ms;
 #endif
 }
 
+// The menus call storageDirty() before they write the new value, the caches built in between
+// from the old one by the mixer are invalidated again here, in the next menus loop
+void checkStorageChanges()
+{
+  __disable_irq();
+  uint8_t msk = storageChangedMsk;
+  storageChangedMsk = 0;
+  __enable_irq();
+
+  if (msk & EE_MODEL) {
+    calculatedSensorsChanged();
+    limitsChanged();
+  }
+}
+
 void preModelLoad() {
   watchdogSuspend(500 /*5s*/);
 
@@ -79,6 +103,8 @@ void postModelLoad(bool alarms) {
       telemetryItems[i].timeout = TELEMETRY_SENSOR_TIMEOUT_UNAVAILABLE;
     }
   }
+  calculatedSensorsChanged();
+  limitsChanged();
 
   LOAD_MODEL_CURVES();
 
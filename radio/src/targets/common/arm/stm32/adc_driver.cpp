@@ -19,6 +19,7 @@
  */
 
 #include "opentx.h"
+#include "analogs_filter.h"
 
 #if defined(SIMU)
   // not needed
@@ -60,20 +61,20 @@
   #define NUM_ANALOGS_ADC              NUM_ANALOGS
 #endif
 
-uint16_t adcValues[NUM_ANALOGS] __DMA;
+uint16_t adcValues[NUM_ANALOGS];
+static uint16_t adcSamples[ADC_FILTER_DEPTH * NUM_ANALOGS] __DMA;  // ring filled continuously by DMA
+#if defined(PCBX9E)
+static uint16_t adcExtSamples[ADC_FILTER_DEPTH * NUM_ANALOGS_ADC_EXT] __DMA;
+#endif
 
 #if defined(STM32F0)
 void adcInit()
 {
 
-}
-
-void adcSingleRead()
-{
-
-
 }
 #else
+static void adcStart();
+
 void adcInit()
 {
   GPIO_InitTypeDef GPIO_InitStructure;
@@ -103,7 +104,7 @@ void adcInit()
 #endif
 
   ADC_MAIN->CR1 = ADC_CR1_SCAN;
-  ADC_MAIN->CR2 = ADC_CR2_ADON | ADC_CR2_DMA | ADC_CR2_DDS;
+  ADC_MAIN->CR2 = ADC_CR2_ADON | ADC_CR2_DMA | ADC_CR2_DDS | ADC_CR2_CONT;
   ADC_MAIN->SQR1 = (NUM_ANALOGS_ADC-1) << 20; // bits 23:20 = number of conversions
 
 #if defined(PCBX10)
@@ -141,25 +142,25 @@ void adcInit()
 
   ADC->CCR = 0;
 
-  ADC_DMA_Stream->CR = DMA_SxCR_PL | ADC_DMA_SxCR_CHSEL | DMA_SxCR_MSIZE_0 | DMA_SxCR_PSIZE_0 | DMA_SxCR_MINC;
+  ADC_DMA_Stream->CR = DMA_SxCR_PL | ADC_DMA_SxCR_CHSEL | DMA_SxCR_MSIZE_0 | DMA_SxCR_PSIZE_0 | DMA_SxCR_MINC | DMA_SxCR_CIRC;
   ADC_DMA_Stream->PAR = CONVERT_PTR_UINT(&ADC_MAIN->DR);
-  ADC_DMA_Stream->M0AR = CONVERT_PTR_UINT(&adcValues[FIRST_ANALOG_ADC]);
-  ADC_DMA_Stream->NDTR = NUM_ANALOGS_ADC;
+  ADC_DMA_Stream->M0AR = CONVERT_PTR_UINT(adcSamples);
+  ADC_DMA_Stream->NDTR = ADC_FILTER_DEPTH * NUM_ANALOGS_ADC;
   ADC_DMA_Stream->FCR = DMA_SxFCR_DMDIS | DMA_SxFCR_FTH_0;
 
 #if defined(PCBX9E)
   ADC_EXT->CR1 = ADC_CR1_SCAN;
-  ADC_EXT->CR2 = ADC_CR2_ADON | ADC_CR2_DMA | ADC_CR2_DDS;
+  ADC_EXT->CR2 = ADC_CR2_ADON | ADC_CR2_DMA | ADC_CR2_DDS | ADC_CR2_CONT;
   ADC_EXT->SQR1 = (NUM_ANALOGS_ADC_EXT-1) << 20;
   ADC_EXT->SQR2 = 0;
   ADC_EXT->SQR3 = (ADC_CHANNEL_POT1<<0) + (ADC_CHANNEL_SLIDER1<<5) + (ADC_CHANNEL_SLIDER2<<10); // conversions 1 to 3
   ADC_EXT->SMPR1 = 0;
   ADC_EXT->SMPR2 = (ADC_EXT_SAMPTIME<<(3*ADC_CHANNEL_POT1)) + (ADC_EXT_SAMPTIME<<(3*ADC_CHANNEL_SLIDER1)) + (ADC_EXT_SAMPTIME<<(3*ADC_CHANNEL_SLIDER2));
 
-  ADC_EXT_DMA_Stream->CR = DMA_SxCR_PL | DMA_SxCR_CHSEL_1 | DMA_SxCR_MSIZE_0 | DMA_SxCR_PSIZE_0 | DMA_SxCR_MINC;
+  ADC_EXT_DMA_Stream->CR = DMA_SxCR_PL | DMA_SxCR_CHSEL_1 | DMA_SxCR_MSIZE_0 | DMA_SxCR_PSIZE_0 | DMA_SxCR_MINC | DMA_SxCR_CIRC;
   ADC_EXT_DMA_Stream->PAR = CONVERT_PTR_UINT(&ADC_EXT->DR);
-  ADC_EXT_DMA_Stream->M0AR = CONVERT_PTR_UINT(adcValues + NUM_ANALOGS_ADC);
-  ADC_EXT_DMA_Stream->NDTR = NUM_ANALOGS_ADC_EXT;
+  ADC_EXT_DMA_Stream->M0AR = CONVERT_PTR_UINT(adcExtSamples);
+  ADC_EXT_DMA_Stream->NDTR = ADC_FILTER_DEPTH * NUM_ANALOGS_ADC_EXT;
   ADC_EXT_DMA_Stream->FCR = DMA_SxFCR_DMDIS | DMA_SxFCR_FTH_0;
 #endif
 
@@ -168,9 +169,12 @@ void adcInit()
     sticksPwmInit();
   }
 #endif
+
+  adcStart();
 }
 
-void adcSingleRead()
+// The conversions run continuously (ADC_CR2_CONT), DMA writes them in the samples ring forever (DMA_SxCR_CIRC)
+static void adcStart()
 {
   ADC_DMA_Stream->CR &= ~DMA_SxCR_EN; // Disable DMA
   ADC_MAIN->SR &= ~(uint32_t)(ADC_SR_EOC | ADC_SR_STRT | ADC_SR_OVR);
@@ -185,45 +189,28 @@ void adcSingleRead()
   ADC_EXT_DMA_Stream->CR |= DMA_SxCR_EN; // Enable DMA
   ADC_EXT->CR2 |= (uint32_t)ADC_CR2_SWSTART;
 #endif
-
-#if defined(PCBX9E)
-  for (unsigned int i=0; i<10000; i++) {
-    if (ADC_TRANSFER_COMPLETE() && ADC_EXT_TRANSFER_COMPLETE()) {
-      break;
-    }
-  }
-  ADC_DMA_Stream->CR &= ~DMA_SxCR_EN; // Disable DMA
-  ADC_EXT_DMA_Stream->CR &= ~DMA_SxCR_EN; // Disable DMA
-#else
-  for (unsigned int i = 0; i < 10000; i++) {
-    if (ADC_TRANSFER_COMPLETE()) {
-      break;
-    }
-  }
-  ADC_DMA_Stream->CR &= ~DMA_SxCR_EN; // Disable DMA
-#endif
 }
 #endif
+
+// Never waits for a conversion, only the ring is filtered
 void adcRead()
 {
-  uint16_t temp[NUM_ANALOGS] = { 0 };
-
-  for (int i=0; i<4; i++) {
-    adcSingleRead();
-    for (uint8_t x=FIRST_ANALOG_ADC; x<NUM_ANALOGS; x++) {
-      uint16_t val = adcValues[x];
+  for (uint8_t x=0; x<NUM_ANALOGS_ADC; x++) {
 #if defined(JITTER_MEASURE)
-      if (JITTER_MEASURE_ACTIVE()) {
-        rawJitter[x].measure(val);
+    if (JITTER_MEASURE_ACTIVE()) {
+      for (uint8_t i=0; i<ADC_FILTER_DEPTH; i++) {
+        rawJitter[FIRST_ANALOG_ADC + x].measure(adcSamples[i * NUM_ANALOGS_ADC + x]);
       }
-#endif
-      temp[x] += val;
     }
+#endif
+    adcValues[FIRST_ANALOG_ADC + x] = adcFilterChannel(&adcSamples[x], NUM_ANALOGS_ADC, ADC_FILTER_MEDIAN, ADC_FILTER_OVERSAMPLING);
   }
 
-  for (uint8_t x=FIRST_ANALOG_ADC; x<NUM_ANALOGS; x++) {
-    adcValues[x] = temp[x] >> 2;
+#if defined(PCBX9E)
+  for (uint8_t x=0; x<NUM_ANALOGS_ADC_EXT; x++) {
+    adcValues[NUM_ANALOGS_ADC + x] = adcFilterChannel(&adcExtSamples[x], NUM_ANALOGS_ADC_EXT, ADC_FILTER_MEDIAN, ADC_FILTER_OVERSAMPLING);
   }
+#endif
 
 #if NUM_PWMSTICKS > 0
   if (STICKS_PWM_ENABLED()) {
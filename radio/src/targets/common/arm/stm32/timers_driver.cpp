@@ -76,7 +76,10 @@ void interrupt5ms()
 
 extern "C" void INTERRUPT_xMS_IRQHandler()
 {
+  DEBUG_LOAD_INT_START();
   INTERRUPT_xMS_TIMER->SR &= ~TIM_SR_UIF;
   interrupt5ms();
   DEBUG_INTERRUPT(INT_1MS);
+  DEBUG_LOAD_INT_STOP(LOAD_INT_TICK);
+  DEBUG_LOAD_SAMPLE();
 }
@@ -19,6 +19,7 @@
  */
 
 #include "opentx.h"
+#include "analogs_filter.h"
 
 #if defined(SIMU)
 // not needed
@@ -40,13 +41,24 @@ const uint8_t ana_mapping[NUM_ANALOGS] =  {3, 2, 1, 0, 6, 7, 4, 5, 8, 9, 10};
 #define NUM_ANALOGS_ADC NUM_ANALOGS
 #endif
 
-uint16_t adcValues[NUM_ANALOGS] __DMA;
+uint16_t adcValues[NUM_ANALOGS];
+static uint16_t adcSamples[ADC_FILTER_DEPTH * NUM_ANALOGS] __DMA;  // ring filled continuously by DMA
 
 #define ADC_DMA_CHANNEL DMA1_Channel1
-#define ADC_DMA_TC_FLAG DMA1_FLAG_TC1
 
+// (Re)starts the conversions with the ring at its first sample, in step with the first channel of the scan
 static void adc_dma_arm(void)
 {
+  if (ADC_GetFlagStatus(ADC1, ADC_FLAG_ADSTART)) {
+    ADC_StopOfConversion(ADC1);
+    while (ADC_GetFlagStatus(ADC1, ADC_FLAG_ADSTP));
+  }
+  ADC_ClearFlag(ADC1, ADC_FLAG_OVR);
+
+  DMA_Cmd(ADC_DMA_CHANNEL, DISABLE);
+  DMA_SetCurrDataCounter(ADC_DMA_CHANNEL, ADC_FILTER_DEPTH * NUM_ANALOGS);
+  DMA_Cmd(ADC_DMA_CHANNEL, ENABLE);
+
   ADC_StartOfConversion(ADC1);
 }
 
@@ -106,7 +118,8 @@ void adcInit()
   // enable ADC
   ADC_Cmd(ADC1, ENABLE);
 
-  // enable DMA for ADC
+  // enable DMA for ADC, in circular mode: the DMA requests go on after the end of the ring
+  ADC_DMARequestModeConfig(ADC1, ADC_DMAMode_Circular);
   ADC_DMACmd(ADC1, ENABLE);
 
   // -- init dma --
@@ -117,10 +130,9 @@ void adcInit()
   // reset DMA1 channe1 to default values
   DMA_DeInit(ADC_DMA_CHANNEL);
 
-  // set up dma to convert 2 adc channels to two mem locations:
-  // channel will be used for memory to memory transfer
+  // set up dma to write the conversions of all channels in the samples ring, forever
   dma_init.DMA_M2M = DMA_M2M_Disable;
-  // setting normal mode(non circular)
+  // circular mode, the ring is never re-armed
   dma_init.DMA_Mode = DMA_Mode_Circular;
   // medium priority
   dma_init.DMA_Priority = DMA_Priority_High;
@@ -134,10 +146,10 @@ void adcInit()
   // Location assigned to peripheral register will be source
   dma_init.DMA_DIR = DMA_DIR_PeripheralSRC;
   // chunk of data to be transfered
-  dma_init.DMA_BufferSize = NUM_ANALOGS;
+  dma_init.DMA_BufferSize = ADC_FILTER_DEPTH * NUM_ANALOGS;
   // source and destination start addresses
   dma_init.DMA_PeripheralBaseAddr = (uint32_t)&ADC1->DR;
-  dma_init.DMA_MemoryBaseAddr = (uint32_t)adcValues;
+  dma_init.DMA_MemoryBaseAddr = (uint32_t)adcSamples;
   // send values to DMA registers
   DMA_Init(ADC_DMA_CHANNEL, &dma_init);
 
@@ -148,21 +160,25 @@ void adcInit()
   adc_dma_arm();
 }
 
+// Never waits: the conversions keep running, only the ring is filtered
 void adcRead()
 {
-  // adc dma finished?
-  if (DMA_GetITStatus(ADC_DMA_TC_FLAG))
-  {
+  // the ring stops advancing when a conversion is lost (overrun) or the conversions stopped, restart it
+  if (ADC_GetFlagStatus(ADC1, ADC_FLAG_OVR) || !ADC_GetFlagStatus(ADC1, ADC_FLAG_ADSTART)) {
+    TRACE("ADC restarted");
+    adc_dma_arm();
+  }
+
+  for (uint8_t x = 0; x < NUM_ANALOGS; x++) {
+    adcValues[x] = adcFilterChannel(&adcSamples[x], NUM_ANALOGS, ADC_FILTER_MEDIAN, ADC_FILTER_OVERSAMPLING);
+  }
 
 #if NUM_PWMANALOGS > 0
-    if (ANALOGS_PWM_ENABLED())
-    {
-      analogPwmRead(adcValues);
-    }
-#endif
-    // fine, arm DMA again:
-    adc_dma_arm();
+  if (ANALOGS_PWM_ENABLED())
+  {
+    analogPwmRead(adcValues);
   }
+#endif
 }
 
 // TODO
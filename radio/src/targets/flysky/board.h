@@ -424,7 +424,7 @@ void telemetryPortInit(uint32_t baudrate, uint8_t mode);
 void telemetryPortSetDirectionOutput(void);
 //void sportSendBuffer(uint8_t * buffer, uint32_t count);
 void sportSendBuffer(const uint8_t* buffer, unsigned long count);
-uint8_t telemetryGetByte(uint8_t * byte);
+void telemetryReleaseFrame();
 extern uint32_t telemetryErrors;
 
 #define HAS_SPORT_UPDATE_CONNECTOR()  false
@@ -496,13 +496,11 @@ void checkTrainerSettings(void);
 #include "dmafifo.h"
 #endif // AUX_SERIAL_DMA_Channel_RX
 
-#if defined(CROSSFIRE)
-#define TELEMETRY_FIFO_SIZE             128
-#else
-#define TELEMETRY_FIFO_SIZE             64
-#endif
+// Telemetry is received by DMA in chunks ended by the line going idle (one CRSF frame max each)
+#define TELEMETRY_RX_FRAMES             4
+#define TELEMETRY_RX_FRAME_SIZE         64
+bool telemetryGetFrame(const uint8_t * & frame, uint32_t & len);
 
-// extern Fifo<uint8_t, TELEMETRY_FIFO_SIZE> telemetryFifo;
 #if defined(AUX_SERIAL_DMA_Channel_RX)
 extern DMAFifo<32> auxSerialRxFifo;
 #endif // AUX_SERIAL_DMA_Channel_RX
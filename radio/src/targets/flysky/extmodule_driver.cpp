@@ -165,6 +165,7 @@ inline void extmoduleSendNextFrame() {
 }
 
 extern "C" void EXTMODULE_TIMER_IRQHandler() {
+  DEBUG_LOAD_INT_START();
   if (EXTMODULE_TIMER->SR & TIM_SR_CC2IF) {  // Compare PPM-OUT
     EXTMODULE_TIMER->SR &= ~TIM_SR_CC2IF;    // Clears interrupt on ch2
     if ((moduleState[EXTERNAL_MODULE].protocol == PROTOCOL_CHANNELS_CROSSFIRE && g_model.moduleData[EXTERNAL_MODULE].type != MODULE_TYPE_CROSSFIRE) ||
@@ -184,4 +185,5 @@ extern "C" void EXTMODULE_TIMER_IRQHandler() {
       captureTrainerPulses(EXTMODULE_TIMER->CCR1);
     }
   }
+  DEBUG_LOAD_INT_STOP(LOAD_INT_PULSES);
 }
@@ -154,19 +154,23 @@ void intmoduleAfhds2aStart() {
 
 /*-------------handler for RADIO GIO2 (FALLING AGE)---------------------------*/
 void EXTI2_3_IRQHandler(void) {
+  DEBUG_LOAD_INT_START();
   if (EXTI->PR & RF_GIO2_PIN) {
     WRITE_REG(EXTI->PR, RF_GIO2_PIN);
     DisableGIO();
     SETBIT(RadioState, CALLER, GPIO_CALL);
     ActionAFHDS2A();
   }
+  DEBUG_LOAD_INT_STOP(LOAD_INT_PULSES);
 }
 /*------------handler for Radio_Protocol_Timer 3860 uS------------------------*/
 void TIM16_IRQHandler(void) {
+  DEBUG_LOAD_INT_START();
   WRITE_REG(TIM16->SR, ~(TIM_SR_UIF));  // Clear the update interrupt flag (UIF)
   setupPulses(INTERNAL_MODULE);
   if (ahfds2aEnabled) {
     SETBIT(RadioState, CALLER, TIM_CALL);
     ActionAFHDS2A();
   }
+  DEBUG_LOAD_INT_STOP(LOAD_INT_PULSES);
 }
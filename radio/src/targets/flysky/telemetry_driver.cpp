@@ -19,16 +19,34 @@
  */
 
 #include "opentx.h"
+#include "framefifo.h"
 
-Fifo<uint8_t, TELEMETRY_FIFO_SIZE> telemetryFifo;
+FrameFifo<TELEMETRY_RX_FRAMES, TELEMETRY_RX_FRAME_SIZE> telemetryFrames;
 uint32_t telemetryErrors = 0;
 static USART_InitTypeDef USART_InitStructure;
 void uartSetDirection(bool tx);
 
+// Stops the RX DMA and returns the number of bytes it wrote in the current buffer
+static uint32_t telemetryRxDmaStop()
+{
+  TELEMETRY_DMA_Channel_RX->CCR &= ~DMA_CCR_EN;
+  return TELEMETRY_RX_FRAME_SIZE - TELEMETRY_DMA_Channel_RX->CNDTR;
+}
+
+static void telemetryRxDmaStart(uint8_t * buffer)
+{
+  // a buffer full at the same time as the line went idle was committed by the caller
+  DMA_ClearITPendingBit(TELEMETRY_DMA_RX_FLAG_TC);
+  TELEMETRY_DMA_Channel_RX->CMAR = CONVERT_PTR_UINT(buffer);
+  TELEMETRY_DMA_Channel_RX->CNDTR = TELEMETRY_RX_FRAME_SIZE;
+  TELEMETRY_DMA_Channel_RX->CCR |= DMA_CCR_EN;
+}
+
 void telemetryPortInit(uint32_t baudrate, uint8_t mode) {
   TRACE("telemetryPortInit %d", baudrate);
 
   if (baudrate == 0) {
+    DMA_DeInit(TELEMETRY_DMA_Channel_RX);
     USART_DeInit(TELEMETRY_USART);
     return;
   }
@@ -93,8 +111,32 @@ void telemetryPortInit(uint32_t baudrate, uint8_t mode) {
   // Level inversion
   USART_InvPinCmd(TELEMETRY_USART, USART_InvPin_Tx | USART_InvPin_Rx, ENABLE);
 
+  // Reception: the DMA fills the current buffer of telemetryFrames, the idle line interrupt
+  // commits it and restarts the DMA on the next one (no interrupt per byte). A longer burst
+  // fills the buffer before the line is idle, the transfer complete interrupt does the same
+  DMA_DeInit(TELEMETRY_DMA_Channel_RX);
+  telemetryFrames.clear();
+  DMA_InitTypeDef DMA_InitStructure;
+  DMA_StructInit(&DMA_InitStructure);
+  DMA_InitStructure.DMA_PeripheralBaseAddr = CONVERT_PTR_UINT(&TELEMETRY_USART->RDR);
+  DMA_InitStructure.DMA_MemoryBaseAddr = CONVERT_PTR_UINT(telemetryFrames.writeBuffer());
+  DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralSRC;
+  DMA_InitStructure.DMA_BufferSize = TELEMETRY_RX_FRAME_SIZE;
+  DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+  DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+  DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+  DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+  DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+  DMA_InitStructure.DMA_Priority = DMA_Priority_High;
+  DMA_InitStructure.DMA_M2M = DMA_M2M_Disable;
+  DMA_Init(TELEMETRY_DMA_Channel_RX, &DMA_InitStructure);
+  DMA_ITConfig(TELEMETRY_DMA_Channel_RX, DMA_IT_TC, ENABLE);
+  DMA_Cmd(TELEMETRY_DMA_Channel_RX, ENABLE);
+  USART_DMACmd(TELEMETRY_USART, USART_DMAReq_Rx, ENABLE);
+
   USART_Cmd(TELEMETRY_USART, ENABLE);
-  USART_ITConfig(TELEMETRY_USART, USART_IT_RXNE, ENABLE);
+  USART_ITConfig(TELEMETRY_USART, USART_IT_IDLE, ENABLE);
+  USART_ITConfig(TELEMETRY_USART, USART_IT_ERR, ENABLE);
   NVIC_SetPriority(TELEMETRY_USART_IRQn, 6);
   NVIC_EnableIRQ(TELEMETRY_USART_IRQn);
 
@@ -175,6 +217,7 @@ void sportSendBuffer(const uint8_t* buffer, unsigned long count) {
 
 extern "C" void TELEMETRY_DMA_TX_IRQHandler(void) {
   DEBUG_INTERRUPT(INT_TELEM_DMA);
+  DEBUG_LOAD_INT_START();
   if (DMA_GetITStatus(TELEMETRY_DMA_TX_FLAG_TC)) {
     DMA_ClearITPendingBit(TELEMETRY_DMA_TX_FLAG_TC);
 
@@ -186,63 +229,48 @@ extern "C" void TELEMETRY_DMA_TX_IRQHandler(void) {
       outputTelemetryBufferTrigger = 0x7E;
     }
   }
+
+  // RX buffer full, the USART interrupt (higher priority) also commits the buffers
+  __disable_irq();
+  if (DMA_GetITStatus(TELEMETRY_DMA_RX_FLAG_TC)) {
+    telemetryRxDmaStart(telemetryFrames.commit(telemetryRxDmaStop()));
+  }
+  __enable_irq();
+  DEBUG_LOAD_INT_STOP(LOAD_INT_TELEMETRY);
 }
 
 extern "C" void TELEMETRY_USART_IRQHandler(void) {
   DEBUG_INTERRUPT(INT_TELEM_USART);
+  DEBUG_LOAD_INT_START();
   uint32_t status = TELEMETRY_USART->ISR;
   if ((status & USART_FLAG_TC) && (TELEMETRY_USART->CR1 & USART_CR1_TCIE)) {
     TELEMETRY_USART->CR1 &= ~USART_CR1_TCIE;
     telemetryPortSetDirectionInput();
-    while (status & (USART_FLAG_RXNE)) {
-      status = TELEMETRY_USART->RDR;
-      status = TELEMETRY_USART->ISR;
-    }
+    // drop what was received before the switch
+    telemetryRxDmaStop();
+    telemetryRxDmaStart(telemetryFrames.writeBuffer());
   }
-  while (status & (USART_FLAG_RXNE | USART_FLAG_ERRORS)) {
-    uint8_t data = TELEMETRY_USART->RDR;
+
+  if (status & (USART_FLAG_ORE | USART_FLAG_NE | USART_FLAG_FE | USART_FLAG_PE)) {
     if (status & USART_FLAG_ERRORS) {
       telemetryErrors++;
-      if (status & USART_FLAG_ORE) {
-        USART_ClearITPendingBit(TELEMETRY_USART, USART_IT_ORE);
-      }
-//      if (status & USART_FLAG_NE) {
-//        USART_ClearITPendingBit(TELEMETRY_USART, USART_FLAG_NE);
-//      }
-//       if (status & USART_FLAG_FE) {
-//         USART_ClearITPendingBit(TELEMETRY_USART, USART_FLAG_FE);
-//       }
-      if (status & USART_FLAG_PE) {
-        USART_ClearITPendingBit(TELEMETRY_USART, USART_FLAG_PE);
-      }
-    } else {
-      telemetryFifo.push(data);
-#if defined(LUA)
-    if (telemetryProtocol == PROTOCOL_FRSKY_SPORT) {
-      static uint8_t prevdata;
-      if (prevdata == 0x7E && outputTelemetryBufferSize > 0 && data == outputTelemetryBufferTrigger) {
-        sportSendBuffer(outputTelemetryBuffer, outputTelemetryBufferSize);
-      }
-      prevdata = data;
-    }
-#endif
     }
-    status = TELEMETRY_USART->ISR;
+    // the parsers check the frames, the bytes received with errors are kept
+    TELEMETRY_USART->ICR = USART_ICR_ORECF | USART_ICR_NCF | USART_ICR_FECF | USART_ICR_PECF;
   }
+
+  if (status & USART_FLAG_IDLE) {
+    TELEMETRY_USART->ICR = USART_ICR_IDLECF;
+    telemetryRxDmaStart(telemetryFrames.commit(telemetryRxDmaStop()));
+  }
+  DEBUG_LOAD_INT_STOP(LOAD_INT_TELEMETRY);
 }
 
 // TODO we should have telemetry in an higher layer, functions above should move to a sport_driver.cpp
-uint8_t telemetryGetByte(uint8_t* byte) {
-#if defined(AUX_SERIAL) && !defined(PCBI6X)
-  if (telemetryProtocol == PROTOCOL_FRSKY_D_SECONDARY) {
-    if (auxSerialMode == UART_MODE_TELEMETRY)
-      return auxSerialRxFifo.pop(*byte);
-    else
-      return false;
-  } else {
-    return telemetryFifo.pop(*byte);
-  }
-#else
-  return telemetryFifo.pop(*byte);
-#endif
+bool telemetryGetFrame(const uint8_t * & frame, uint32_t & len) {
+  return telemetryFrames.peek(frame, len);
+}
+
+void telemetryReleaseFrame() {
+  telemetryFrames.pop();
 }
@@ -149,9 +149,9 @@ static void addBackButton();
 static void reloadAllField();
 static FieldProps * getField(uint8_t line);
 static void UIbackExec(FieldProps * field);
-static void parseDeviceInfoMessage(uint8_t* data);
-static void parseParameterInfoMessage(uint8_t* data, uint8_t length);
-static void parseElrsInfoMessage(uint8_t* data);
+static void parseDeviceInfoMessage(const uint8_t* data);
+static void parseParameterInfoMessage(const uint8_t* data, uint8_t length);
+static void parseElrsInfoMessage(const uint8_t* data);
 static void runPopupPage(event_t event);
 static void runDevicePage(event_t event);
 static void lcd_title();
@@ -164,7 +164,7 @@ static void luaLcdDrawGauge(coord_t x, coord_t y, coord_t w, coord_t h, int32_t
   lcdDrawSolidFilledRect(x+len, y, w - len, h-2);
 }
 
-static void bufferPush(char * data, uint8_t len) {
+static void bufferPush(const char * data, uint8_t len) {
   memcpy(&buffer[bufferOffset], data, len);
   bufferOffset += len;
 }
@@ -458,11 +458,11 @@ static void fieldDeviceIdSelect(FieldProps * field) {
  crossfireTelemetryPing();
 }
 
-static void parseDeviceInfoMessage(uint8_t* data) {
+static void parseDeviceInfoMessage(const uint8_t* data) {
   uint8_t offset;
   uint8_t id = data[2];
 // TRACE("parseDevInfoMsg %x folderAcs %d, expect %d, devsLen %d", id, folderAccess, expectedFieldsCount, devicesLen);
-  offset = strlen((char*)&data[3]) + 1 + 3;
+  offset = strlen((const char*)&data[3]) + 1 + 3;
   uint8_t devId = getDevice(id);
   if (!devId) {
     deviceIds[devicesLen] = id;
@@ -473,7 +473,7 @@ static void parseDeviceInfoMessage(uint8_t* data) {
       deviceField.nameLength = offset - 4;
       deviceField.offset = bufferOffset;
 
-      bufferPush((char *)&data[3], deviceField.nameLength);
+      bufferPush((const char *)&data[3], deviceField.nameLength);
       storeField(&deviceField);
       if (devicesLen == expectedFieldsCount - 1) {
         allParamsLoaded = 1;
@@ -485,7 +485,7 @@ static void parseDeviceInfoMessage(uint8_t* data) {
   }
 
   if (deviceId == id && folderAccess != otherDevicesId) {
-    memcpy(&deviceName[0], (char *)&data[3], DEVICE_NAME_MAX_LEN);
+    memcpy(&deviceName[0], (const char *)&data[3], DEVICE_NAME_MAX_LEN);
     deviceIsELRS_TX = ((memcmp(&data[offset], "ELRS", 4) == 0) && (deviceId == 0xEE)) ? 1 : 0; // SerialNumber = 'E L R S' and ID is TX module
     uint8_t newFieldCount = data[offset+12];
 //    TRACE("deviceId match %x, newFieldCount %d", deviceId, newFieldCount);
@@ -533,7 +533,7 @@ static FieldFunctions getFunctions(uint32_t i) {
   return functions[i];
 }
 
-static void parseParameterInfoMessage(uint8_t* data, uint8_t length) {
+static void parseParameterInfoMessage(const uint8_t* data, uint8_t length) {
   if (data[2] != deviceId || data[3] != fieldId) {
     fieldDataLen = 0;
     fieldChunk = 0;
@@ -628,7 +628,7 @@ static void parseParameterInfoMessage(uint8_t* data, uint8_t length) {
   }
 }
 
-static void parseElrsInfoMessage(uint8_t* data) {
+static void parseElrsInfoMessage(const uint8_t* data) {
   if (data[2] != deviceId) {
     fieldDataLen = 0;
     fieldChunk = 0;
@@ -643,13 +643,13 @@ static void parseElrsInfoMessage(uint8_t* data) {
     elrsFlags = newFlags;
     titleShowWarnTimeout = 0;
   }
-  strncpy(elrsFlagsInfo, (char*)&data[7], ELRS_FLAGS_INFO_MAX_LEN);
+  strncpy(elrsFlagsInfo, (const char*)&data[7], ELRS_FLAGS_INFO_MAX_LEN);
 
   char state = (elrsFlags & 1) ? 'C' : '-';
   tiny_sprintf(goodBadPkt, "%u/%u   %c", 3, badPkt, goodPkt, state);
 }
 
-static void refreshNextCallback(uint8_t command, uint8_t* data, uint8_t length) {
+static void refreshNextCallback(uint8_t command, const uint8_t* data, uint8_t length) {
   if (command == CRSF_FRAMETYPE_DEVICE_INFO) {
     parseDeviceInfoMessage(data);
   } else if (command == CRSF_FRAMETYPE_PARAMETER_SETTINGS_ENTRY && folderAccess != otherDevicesId /* !devicesFolderOpened */) {
@@ -7,12 +7,10 @@
 const uint8_t __bmp_plug_usb_rle[] {
 #include "bmp_plug_usb.lbm"
 };
-RLEBitmap BMP_PLUG_USB(BMP_RGB565, __bmp_plug_usb_rle);
 
 const uint8_t __bmp_usb_plugged_rle[] {
 #include "bmp_usb_plugged.lbm"
 };
-RLEBitmap BMP_USB_PLUGGED(BMP_RGB565, __bmp_usb_plugged_rle);
 
 const uint8_t LBM_FLASH[] = {
 #include "icon_flash.lbm"
@@ -80,7 +78,7 @@ void bootloaderDrawScreen(BootloaderState st, int opt, const char* str)
 
         lcdDrawSolidRect(119, (opt == 0) ? 72 : 107, 270, 26, 2, LINE_COLOR);
         
-        lcd->drawBitmap(60, 166, &BMP_PLUG_USB);
+        lcd->drawRleBitmap(60, 166, __bmp_plug_usb_rle);
         lcdDrawText(195, 175, "Or plug in a USB cable");
         lcdDrawText(195, 200, "for mass storage");
 
@@ -90,7 +88,7 @@ void bootloaderDrawScreen(BootloaderState st, int opt, const char* str)
     }
     else if (st == ST_USB) {
 
-        lcd->drawBitmap(136, 98, &BMP_USB_PLUGGED);
+        lcd->drawRleBitmap(136, 98, __bmp_usb_plugged_rle);
         lcdDrawText(195, 128, "USB Connected");
     }
     else if (st == ST_FILE_LIST || st == ST_DIR_CHECK || st == ST_FLASH_CHECK ||
@@ -0,0 +1,684 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+/*
+  Headless simulator: runs a model on the virtual clock, as fast as the CPU allows.
+
+  The mixer and menus tasks are not started as threads, their periodic work is stepped
+  from a single loop, one millisecond at a time, so that two runs with the same inputs
+  give the same traces.
+
+  Input script, one event per line ('#' starts a comment):
+    <time_ms> analog <index> <value> [<ramp_ms>]   raw ADC value (0..4095), optionally reached linearly in ramp_ms
+    <time_ms> switch <index> <-1|0|1>
+    <time_ms> key <index> <0|1>
+    <time_ms> trim <index> <0|1>
+
+  Trace output is CSV: time, channels outputs, timers, logical switches and telemetry sensors values.
+
+  Batch mode (EEPROM images given as arguments): every model of every image is simulated in its
+  own process, since the firmware state is global, with a standard sweep of all sticks, pots and
+  switches. One JSON object per model is written: channels ranges, failsafe settings, alerts
+  raised and mixer CPU time.
+*/
+
+#include "opentx.h"
+#include "tasks.h"
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <unistd.h>
+#if !defined(_WIN32)
+  #include <fcntl.h>
+  #include <signal.h>
+  #include <sys/wait.h>
+#endif
+
+#define HEADLESS_MIXER_PERIOD_MS       5   // as the simulator mixer task (MIXER_FREQUENT_ACTIONS_PERIOD)
+#define HEADLESS_MENUS_PERIOD_MS       50  // MENU_TASK_PERIOD_TICKS
+#define HEADLESS_DEFAULT_DURATION_MS   60000
+#define HEADLESS_DEFAULT_TRACE_MS      100
+#define HEADLESS_DEFAULT_TIMEOUT_S     60   // batch mode, real time allowed for one model
+
+enum HeadlessEventType {
+  HEADLESS_EVENT_ANALOG,
+  HEADLESS_EVENT_SWITCH,
+  HEADLESS_EVENT_KEY,
+  HEADLESS_EVENT_TRIM
+};
+
+struct HeadlessEvent {
+  uint32_t time;
+  uint8_t type;
+  uint8_t index;
+  int32_t value;
+  uint32_t ramp;
+};
+
+struct HeadlessRamp {
+  uint8_t index;
+  uint32_t start;
+  uint32_t end;
+  int32_t from;
+  int32_t to;
+};
+
+struct HeadlessStats {
+  uint32_t mixerRuns;
+  uint64_t mixerTotalTime;   // CPU time, in ns
+  uint32_t mixerMaxTime;
+  int16_t channelMin[MAX_OUTPUT_CHANNELS];
+  int16_t channelMax[MAX_OUTPUT_CHANNELS];
+  std::vector<std::string> alerts;
+};
+
+static HeadlessStats headlessStats;
+
+extern bool simu_shutdown;
+extern bool simu_running;
+
+uint16_t g_anas[NUM_STICKS+NUM_POTS+NUM_SLIDERS];
+
+uint16_t anaIn(uint8_t chan)
+{
+  if (chan < DIM(g_anas))
+    return g_anas[chan];
+#if defined(PCBHORUS)
+  else if (chan == TX_VOLTAGE)
+    return 1737;      //~10.6V
+#elif defined(PCBX9E)
+  else if (chan == TX_VOLTAGE)
+    return 1420;      //~10.6V
+#elif defined(PCBXLITE)
+  else if (chan == TX_VOLTAGE)
+    return 1100;
+#elif defined(PCBTARANIS)
+  else if (chan == TX_VOLTAGE)
+    return 1000;      //~7.4V
+#elif defined(PCBSKY9X)
+  else if (chan == TX_VOLTAGE)
+    return 5.1*1500/11.3;
+  else if (chan == TX_CURRENT)
+    return 100;
+#else
+  else if (chan == TX_VOLTAGE)
+    return 1500;
+#endif
+  else
+    return 0;
+}
+
+uint16_t getAnalogValue(uint8_t index)
+{
+  return anaIn(index);
+}
+
+static bool loadScript(const char * filename, std::vector<HeadlessEvent> & events)
+{
+  FILE * f = fopen(filename, "r");
+  if (!f) {
+    perror(filename);
+    return false;
+  }
+
+  char line[128];
+  int lineno = 0;
+  while (fgets(line, sizeof(line), f)) {
+    lineno++;
+    char * comment = strchr(line, '#');
+    if (comment)
+      *comment = '\0';
+
+    char type[16];
+    unsigned int time, index, ramp = 0;
+    int value;
+    int count = sscanf(line, "%u %15s %u %d %u", &time, type, &index, &value, &ramp);
+    if (count <= 0)
+      continue;  // empty line
+
+    HeadlessEvent event = { time, 0, (uint8_t)index, value, ramp };
+    if (count >= 4 && !strcmp(type, "analog") && index < DIM(g_anas))
+      event.type = HEADLESS_EVENT_ANALOG;
+    else if (count == 4 && !strcmp(type, "switch"))
+      event.type = HEADLESS_EVENT_SWITCH;
+    else if (count == 4 && !strcmp(type, "key"))
+      event.type = HEADLESS_EVENT_KEY;
+    else if (count == 4 && !strcmp(type, "trim"))
+      event.type = HEADLESS_EVENT_TRIM;
+    else {
+      fprintf(stderr, "%s:%d: invalid event\n", filename, lineno);
+      fclose(f);
+      return false;
+    }
+    events.push_back(event);
+  }
+
+  fclose(f);
+  std::stable_sort(events.begin(), events.end(), [](const HeadlessEvent & a, const HeadlessEvent & b) { return a.time < b.time; });
+  return true;
+}
+
+static void applyEvent(const HeadlessEvent & event, uint32_t now, std::vector<HeadlessRamp> & ramps)
+{
+  switch (event.type) {
+    case HEADLESS_EVENT_ANALOG:
+      ramps.erase(std::remove_if(ramps.begin(), ramps.end(), [&](const HeadlessRamp & r) { return r.index == event.index; }), ramps.end());
+      if (event.ramp > 0)
+        ramps.push_back({ event.index, now, now + event.ramp, g_anas[event.index], event.value });
+      else
+        g_anas[event.index] = limit<int32_t>(0, event.value, 4095);
+      break;
+    case HEADLESS_EVENT_SWITCH:
+      simuSetSwitch(event.index, event.value);
+      break;
+    case HEADLESS_EVENT_KEY:
+      simuSetKey(event.index, event.value);
+      break;
+    case HEADLESS_EVENT_TRIM:
+      simuSetTrim(event.index, event.value);
+      break;
+  }
+}
+
+static void updateRamps(uint32_t now, std::vector<HeadlessRamp> & ramps)
+{
+  for (auto it = ramps.begin(); it != ramps.end(); ) {
+    int32_t value = it->from + (int32_t)((int64_t)(it->to - it->from) * (int32_t)(now - it->start) / (int32_t)(it->end - it->start));
+    g_anas[it->index] = limit<int32_t>(0, value, 4095);
+    if (now >= it->end)
+      it = ramps.erase(it);
+    else
+      ++it;
+  }
+}
+
+static bool loadEeprom(const char * filename)
+{
+#if defined(EEPROM_SIZE)
+  // the image is copied in memory, the file itself is never written
+  memset(eeprom, 0xFF, EEPROM_SIZE);
+  if (filename) {
+    FILE * f = fopen(filename, "rb");
+    if (!f) {
+      perror(filename);
+      return false;
+    }
+    size_t size = fread(eeprom, 1, EEPROM_SIZE, f);
+    fclose(f);
+    if (size == 0) {
+      fprintf(stderr, "%s: empty EEPROM image\n", filename);
+      return false;
+    }
+  }
+  StartEepromThread(nullptr);
+#elif defined(EEPROM)
+  StartEepromThread(filename);
+#else
+  UNUSED(filename);
+#endif
+  return true;
+}
+
+static void headlessTraceCallback(const char * text)
+{
+  if (!strncmp(text, "ALERT ", 6)) {
+    std::string alert(text + 6);
+    alert.erase(alert.find_last_not_of("\r\n") + 1);
+    headlessStats.alerts.push_back(alert);
+  }
+}
+
+static bool headlessStart(const char * eepromFile, const char * sdPath)
+{
+  // sticks and pots centered
+  for (unsigned i=0; i<DIM(g_anas); i++)
+    g_anas[i] = 2048;
+
+  headlessStats = HeadlessStats();
+  for (int i=0; i<MAX_OUTPUT_CHANNELS; i++) {
+    headlessStats.channelMin[i] = INT16_MAX;
+    headlessStats.channelMax[i] = INT16_MIN;
+  }
+  traceCallback = headlessTraceCallback;
+
+  simuSetVirtualClock(true);
+  simuInit();
+  if (!loadEeprom(eepromFile))
+    return false;
+  simuFatfsSetPaths(sdPath, nullptr);
+  simu_start_mode = OPENTX_START_NO_SPLASH | OPENTX_START_NO_CALIBRATION | OPENTX_START_NO_CHECKS;
+  g_tmr10ms = 1;  // see StartSimu()
+
+  // as simuMain() and the beginning of menusTask(), without starting the tasks
+  boardInit();
+  simu_running = true;
+  opentxInit();
+  return true;
+}
+
+static void headlessStop()
+{
+  simu_shutdown = true;
+  simu_running = false;
+#if defined(EEPROM)
+  StopEepromThread();
+#endif
+  traceCallback = nullptr;
+}
+
+static uint64_t cpuTime()
+{
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+  struct timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#else
+  return simuTimerMicros() * 1000;
+#endif
+}
+
+// One millisecond of the radio life, the tasks periodic work at their usual rates
+static void headlessStep(uint32_t now)
+{
+  if (now % 10 == 0) {
+    per10ms();
+  }
+
+  if (now % HEADLESS_MIXER_PERIOD_MS == 0) {
+    execMixerFrequentActions();
+    if (!s_pulses_paused) {
+      uint64_t start = cpuTime();
+      doMixerCalculations();
+      uint32_t duration = cpuTime() - start;
+      doMixerPeriodicUpdates();
+
+      headlessStats.mixerRuns++;
+      headlessStats.mixerTotalTime += duration;
+      headlessStats.mixerMaxTime = std::max(headlessStats.mixerMaxTime, duration);
+      for (int i=0; i<MAX_OUTPUT_CHANNELS; i++) {
+        headlessStats.channelMin[i] = std::min(headlessStats.channelMin[i], channelOutputs[i]);
+        headlessStats.channelMax[i] = std::max(headlessStats.channelMax[i], channelOutputs[i]);
+      }
+    }
+  }
+
+  if (now % HEADLESS_MENUS_PERIOD_MS == 0) {
+    perMain();
+  }
+}
+
+static void traceHeader(FILE * out)
+{
+  fprintf(out, "time");
+  for (int i=0; i<MAX_OUTPUT_CHANNELS; i++)
+    fprintf(out, ",ch%d", i+1);
+  for (int i=0; i<TIMERS; i++)
+    fprintf(out, ",timer%d", i+1);
+  for (int i=0; i<MAX_LOGICAL_SWITCHES; i++)
+    fprintf(out, ",ls%d", i+1);
+#if MAX_TELEMETRY_SENSORS > 0
+  for (int i=0; i<MAX_TELEMETRY_SENSORS; i++)
+    fprintf(out, ",sensor%d", i+1);
+#endif
+  fprintf(out, "\n");
+}
+
+static void traceLine(FILE * out, uint32_t now)
+{
+  fprintf(out, "%u.%03u", now / 1000, now % 1000);
+  for (int i=0; i<MAX_OUTPUT_CHANNELS; i++)
+    fprintf(out, ",%d", channelOutputs[i]);
+  for (int i=0; i<TIMERS; i++)
+    fprintf(out, ",%d", (int)timersStates[i].val);
+  for (int i=0; i<MAX_LOGICAL_SWITCHES; i++)
+    fprintf(out, ",%d", getSwitch(SWSRC_FIRST_LOGICAL_SWITCH+i) ? 1 : 0);
+#if MAX_TELEMETRY_SENSORS > 0
+  for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
+    if (g_model.telemetrySensors[i].isAvailable() && telemetryItems[i].isAvailable())
+      fprintf(out, ",%d", telemetryItems[i].value);
+    else
+      fprintf(out, ",");
+  }
+#endif
+  fprintf(out, "\n");
+}
+
+static void simulate(const std::vector<HeadlessEvent> & events, uint32_t duration, uint32_t tracePeriod, FILE * out)
+{
+  if (tracePeriod)
+    traceHeader(out);
+
+  std::vector<HeadlessRamp> ramps;
+  auto nextEvent = events.begin();
+  for (uint32_t now=0; now<=duration; now++) {
+    while (nextEvent != events.end() && nextEvent->time <= now) {
+      applyEvent(*nextEvent, now, ramps);
+      ++nextEvent;
+    }
+    updateRamps(now, ramps);
+    headlessStep(now);
+    if (tracePeriod && now % tracePeriod == 0) {
+      traceLine(out, now);
+    }
+    simuAdvanceTime(1000);
+  }
+}
+
+#if !defined(_WIN32)
+// The same inputs for every model: each stick and pot from one end to the other, then each switch in all positions
+static uint32_t standardSweep(std::vector<HeadlessEvent> & events)
+{
+  uint32_t time = 1000;  // let the filters and the timers settle
+
+  for (unsigned i=0; i<DIM(g_anas); i++) {
+    events.push_back({ time, HEADLESS_EVENT_ANALOG, (uint8_t)i, 0, 500 });
+    events.push_back({ time + 500, HEADLESS_EVENT_ANALOG, (uint8_t)i, 4095, 1000 });
+    events.push_back({ time + 1500, HEADLESS_EVENT_ANALOG, (uint8_t)i, 2048, 500 });
+    time += 2000;
+  }
+
+  for (unsigned i=0; i<NUM_SWITCHES; i++) {
+    events.push_back({ time, HEADLESS_EVENT_SWITCH, (uint8_t)i, 0, 0 });
+    events.push_back({ time + 300, HEADLESS_EVENT_SWITCH, (uint8_t)i, 1, 0 });
+    events.push_back({ time + 600, HEADLESS_EVENT_SWITCH, (uint8_t)i, -1, 0 });
+    time += 900;
+  }
+
+  return time + 1000;
+}
+
+static void jsonString(FILE * out, const char * str)
+{
+  fputc('"', out);
+  for (; *str; str++) {
+    if (*str == '"' || *str == '\\')
+      fprintf(out, "\\%c", *str);
+    else if ((uint8_t)*str < ' ')
+      fprintf(out, "\\u%04x", *str);
+    else
+      fputc(*str, out);
+  }
+  fputc('"', out);
+}
+
+static void modelReport(FILE * out, const char * filename, uint8_t index)
+{
+  char name[sizeof(g_model.header.name)+1];
+  zchar2str(name, g_model.header.name, sizeof(g_model.header.name));
+
+  fprintf(out, "{\"file\": ");
+  jsonString(out, filename);
+  fprintf(out, ", \"model\": %d, \"name\": ", index);
+  jsonString(out, name);
+
+  fprintf(out, ", \"channels\": [");
+  for (int i=0; i<MAX_OUTPUT_CHANNELS; i++)
+    fprintf(out, "%s[%d, %d]", i ? ", " : "", headlessStats.channelMin[i], headlessStats.channelMax[i]);
+
+  fprintf(out, "], \"failsafe\": [");
+  for (int i=0; i<NUM_MODULES; i++) {
+    const ModuleData & module = g_model.moduleData[i];
+    fprintf(out, "%s{\"module\": %d, \"mode\": %d", i ? ", " : "", i, module.failsafeMode);
+    if (module.failsafeMode == FAILSAFE_CUSTOM) {
+      fprintf(out, ", \"channels\": [");
+      for (int ch=0; ch<MAX_OUTPUT_CHANNELS; ch++)
+        fprintf(out, "%s%d", ch ? ", " : "", module.failsafeChannels[ch]);
+      fprintf(out, "]");
+    }
+    fprintf(out, "}");
+  }
+
+  fprintf(out, "], \"alerts\": [");
+  for (unsigned i=0; i<headlessStats.alerts.size(); i++) {
+    if (i)
+      fprintf(out, ", ");
+    jsonString(out, headlessStats.alerts[i].c_str());
+  }
+
+  uint32_t runs = std::max<uint32_t>(1, headlessStats.mixerRuns);
+  fprintf(out, "], \"mixer\": {\"runs\": %u, \"avg_us\": %.2f, \"max_us\": %.2f}}",
+          headlessStats.mixerRuns, headlessStats.mixerTotalTime / 1000.0 / runs, headlessStats.mixerMaxTime / 1000.0);
+}
+
+// Child process: simulates one model and writes its report, exit code 2 when the model doesn't exist
+static int batchWorker(const char * filename, uint8_t index, FILE * out)
+{
+  if (!headlessStart(filename, nullptr))
+    return 1;
+
+#if defined(EEPROM)
+  if (!eeModelExists(index)) {
+    headlessStop();
+    return 2;
+  }
+  if (index != g_eeGeneral.currModel) {
+    // as eeLoadModel(), without the checks which would wait for the user
+    preModelLoad();
+    eeLoadModelData(index);
+    postModelLoad(false);
+  }
+#endif
+
+#if defined(PCBTARANIS) || defined(PCBHORUS) || defined(PCBI6X)
+  checkFailsafe();
+#endif
+  checkRSSIAlarmsDisabled();
+
+  std::vector<HeadlessEvent> events;
+  uint32_t duration = standardSweep(events);
+  simulate(events, duration, 0, nullptr);
+
+  modelReport(out, filename, index);
+  fflush(out);
+  headlessStop();
+  return 0;
+}
+
+struct BatchJob {
+  const char * filename;
+  uint8_t index;
+  pid_t pid;
+  FILE * result;
+  int status;
+};
+
+static int batch(const std::vector<const char *> & files, unsigned workers, unsigned timeout, FILE * out)
+{
+  std::vector<BatchJob> jobs;
+  for (auto filename: files) {
+#if defined(EEPROM)
+    for (unsigned index=0; index<MAX_MODELS; index++)
+#else
+    unsigned index = 0;
+#endif
+      jobs.push_back({ filename, (uint8_t)index, 0, nullptr, 0 });
+  }
+
+  unsigned next = 0, running = 0, done = 0;
+  while (done < jobs.size()) {
+    while (running < workers && next < jobs.size()) {
+      BatchJob & job = jobs[next++];
+      job.result = tmpfile();
+      if (!job.result) {
+        perror("tmpfile");
+        return 1;
+      }
+      fflush(nullptr);
+      job.pid = fork();
+      if (job.pid == 0) {
+        // the firmware traces are of no use here
+        int devnull = open("/dev/null", O_WRONLY);
+        dup2(devnull, STDOUT_FILENO);
+        alarm(timeout);
+        _exit(batchWorker(job.filename, job.index, job.result));
+      }
+      else if (job.pid < 0) {
+        perror("fork");
+        return 1;
+      }
+      running++;
+    }
+
+    int status;
+    pid_t pid = wait(&status);
+    if (pid < 0) {
+      perror("wait");
+      return 1;
+    }
+    for (auto & job: jobs) {
+      if (job.pid == pid) {
+        job.status = status;
+        running--;
+        done++;
+        break;
+      }
+    }
+  }
+
+  // reports in the order of the arguments, whatever order the workers ended
+  int result = 0;
+  bool first = true;
+  fprintf(out, "[\n");
+  for (auto & job: jobs) {
+    if (WIFEXITED(job.status) && WEXITSTATUS(job.status) == 2) {
+      // no model at this index
+    }
+    else {
+      fprintf(out, first ? "  " : ",\n  ");
+      first = false;
+      if (WIFEXITED(job.status) && WEXITSTATUS(job.status) == 0) {
+        char buffer[1024];
+        size_t size;
+        rewind(job.result);
+        while ((size = fread(buffer, 1, sizeof(buffer), job.result)) > 0)
+          fwrite(buffer, 1, size, out);
+      }
+      else {
+        fprintf(out, "{\"file\": ");
+        jsonString(out, job.filename);
+        fprintf(out, ", \"model\": %d, \"error\": \"%s\"}", job.index,
+                WIFSIGNALED(job.status) && WTERMSIG(job.status) == SIGALRM ? "timeout" : "crashed");
+        result = 1;
+      }
+    }
+    fclose(job.result);
+  }
+  fprintf(out, "\n]\n");
+  return result;
+}
+#endif
+
+static void usage(const char * name)
+{
+  fprintf(stderr, "Usage: %s [options]\n"
+                  "       %s [-j <workers>] [-t <seconds>] [-o <file>] <eeprom> [<eeprom>...]\n"
+                  "  -e <file>    EEPROM image\n"
+                  "  -sd <path>   SD card folder\n"
+                  "  -s <file>    input script\n"
+                  "  -o <file>    trace output (default stdout)\n"
+                  "  -d <ms>      simulated duration (default %d)\n"
+                  "  -p <ms>      trace period (default %d, 0 for none)\n"
+                  "  -j <count>   batch mode, parallel workers (default one per CPU)\n"
+                  "  -t <s>       batch mode, time limit for each model (default %d)\n",
+                  name, name, HEADLESS_DEFAULT_DURATION_MS, HEADLESS_DEFAULT_TRACE_MS, HEADLESS_DEFAULT_TIMEOUT_S);
+}
+
+int main(int argc, char ** argv)
+{
+  const char * eepromFile = nullptr;
+  const char * sdPath = nullptr;
+  const char * scriptFile = nullptr;
+  const char * traceFile = nullptr;
+  uint32_t duration = HEADLESS_DEFAULT_DURATION_MS;
+  uint32_t tracePeriod = HEADLESS_DEFAULT_TRACE_MS;
+  std::vector<const char *> batchFiles;
+  long workers = 0;
+  unsigned timeout = HEADLESS_DEFAULT_TIMEOUT_S;
+
+  for (int i=1; i<argc; i++) {
+    const char * opt = argv[i];
+    if (opt[0] != '-') {
+      batchFiles.push_back(opt);
+      continue;
+    }
+    if (i+1 >= argc) {
+      usage(argv[0]);
+      return 1;
+    }
+    const char * arg = argv[++i];
+    if (!strcmp(opt, "-e"))
+      eepromFile = arg;
+    else if (!strcmp(opt, "-sd"))
+      sdPath = arg;
+    else if (!strcmp(opt, "-s"))
+      scriptFile = arg;
+    else if (!strcmp(opt, "-o"))
+      traceFile = arg;
+    else if (!strcmp(opt, "-d"))
+      duration = strtoul(arg, nullptr, 10);
+    else if (!strcmp(opt, "-p"))
+      tracePeriod = strtoul(arg, nullptr, 10);
+    else if (!strcmp(opt, "-j"))
+      workers = strtol(arg, nullptr, 10);
+    else if (!strcmp(opt, "-t"))
+      timeout = strtoul(arg, nullptr, 10);
+    else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  std::vector<HeadlessEvent> events;
+  if (scriptFile && !loadScript(scriptFile, events))
+    return 1;
+
+  // the firmware traces go to stdout, keep it for the results and send them to stderr
+  FILE * out = fdopen(dup(STDOUT_FILENO), "w");
+  dup2(STDERR_FILENO, STDOUT_FILENO);
+  if (traceFile) {
+    fclose(out);
+    if (!(out = fopen(traceFile, "w"))) {
+      perror(traceFile);
+      return 1;
+    }
+  }
+
+  int result = 0;
+  if (!batchFiles.empty()) {
+#if defined(_WIN32)
+    fprintf(stderr, "Batch mode is not available on this platform\n");
+    result = 1;
+#else
+    if (workers <= 0)
+      workers = std::max<long>(1, sysconf(_SC_NPROCESSORS_ONLN));
+    result = batch(batchFiles, workers, timeout, out);
+#endif
+  }
+  else if (headlessStart(eepromFile, sdPath)) {
+    simulate(events, duration, tracePeriod, out);
+    headlessStop();
+  }
+  else {
+    result = 1;
+  }
+
+  fclose(out);
+  return result;
+}
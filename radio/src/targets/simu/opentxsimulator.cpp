@@ -32,6 +32,11 @@
 int16_t g_anas[Analogs::NUM_ANALOGS];
 QVector<QIODevice *> OpenTxSimulator::tracebackDevices;
 
+struct OpenTxSimulator::LcdFrame {
+  display_t data[DISPLAY_BUFFER_SIZE];
+  bool backlightEnable;
+};
+
 uint16_t anaIn(uint8_t chan)
 {
   return g_anas[chan];
@@ -54,8 +59,15 @@ OpenTxSimulator::OpenTxSimulator() :
   SimulatorInterface(),
   m_timer10ms(nullptr),
   m_resetOutputsData(true),
-  m_stopRequested(false)
+  m_stopRequested(false),
+  m_lcdFrames(new SimuSnapshot<LcdFrame>()),
+  m_lcdFrame(new LcdFrame())
 {
+  for (auto & words: m_outputsDirty) {
+    for (auto & word: words)
+      word = 0;
+  }
+  memset(m_lcdFrame, 0, sizeof(LcdFrame));
   tracebackDevices.clear();
   traceCallback = firmwareTraceCb;
 }
@@ -75,6 +87,9 @@ OpenTxSimulator::~OpenTxSimulator()
     while (isRunning() && !tmout.hasExpired(1000))
       ;
   }
+
+  delete m_lcdFrames;
+  delete m_lcdFrame;
   //qDebug() << "Deleting OpenTxSimulator";
 }
 
@@ -175,7 +190,37 @@ void OpenTxSimulator::readRadioData(QByteArray & dest)
 
 uint8_t * OpenTxSimulator::getLcd()
 {
-  return (uint8_t *)simuLcdBuf;
+  return (uint8_t *)m_lcdFrame->data;
+}
+
+bool OpenTxSimulator::readLcd(bool & backlightEnable)
+{
+  if (!m_lcdFrames->update())
+    return false;
+  memcpy(m_lcdFrame, &m_lcdFrames->front(), sizeof(LcdFrame));
+  backlightEnable = m_lcdFrame->backlightEnable;
+  return true;
+}
+
+bool OpenTxSimulator::readOutputs(TxOutputs & outputs, TxOutputsDirty & dirty)
+{
+  bool changed = false;
+
+  // the dirty bits are set after the snapshot is published, so the snapshot read after taking
+  //  them is at least as recent as the changes they flag. Bits set in between are taken next
+  //  time, with the same values emitted again at worst
+  for (int type=0; type < OUTPUT_SRC_ENUM_COUNT; type++) {
+    for (int word=0; word < TxOutputsDirty::WORDS; word++) {
+      dirty.bits[type][word] = m_outputsDirty[type][word].exchange(0);
+      if (dirty.bits[type][word])
+        changed = true;
+    }
+  }
+
+  m_outputs.update();
+  if (changed)
+    outputs = m_outputs.front();
+  return changed;
 }
 
 void OpenTxSimulator::setAnalogValue(uint8_t index, int16_t value)
@@ -462,7 +507,10 @@ bool OpenTxSimulator::checkLcdChanged()
 {
   if (simuLcdRefresh) {
     simuLcdRefresh = false;
-    emit lcdChange(isBacklightEnabled());
+    LcdFrame & frame = m_lcdFrames->back();
+    memcpy(frame.data, simuLcdBuf, sizeof(frame.data));
+    frame.backlightEnable = isBacklightEnabled();
+    m_lcdFrames->publish();
     return true;
   }
   return false;
@@ -470,34 +518,30 @@ bool OpenTxSimulator::checkLcdChanged()
 
 void OpenTxSimulator::checkOutputsChanged()
 {
-  static TxOutputs lastOutputs;
   static size_t chansDim = DIM(channelOutputs);
   const static int16_t limit = 512 * 2;
-  qint32 tmpVal;
+  TxOutputs & outputs = m_outputs.back();
+  TxOutputsDirty dirty;
   uint8_t i, idx;
   const uint8_t phase = getFlightMode();  // opentx.cpp
   const uint8_t mode = getStickMode();
 
+  outputs.clear();
+  outputs.chansLimit = (g_model.extendedLimits ? limit * LIMIT_EXT_PERCENT / 100 : limit);
+
   for (i=0; i < chansDim; i++) {
-    if (lastOutputs.chans[i] != channelOutputs[i] || m_resetOutputsData) {
-      emit channelOutValueChange(i, channelOutputs[i], (g_model.extendedLimits ? limit * LIMIT_EXT_PERCENT / 100 : limit));
-      emit outputValueChange(OUTPUT_SRC_CHAN_OUT, i, channelOutputs[i]);
-      lastOutputs.chans[i] = channelOutputs[i];
-    }
-    if (lastOutputs.ex_chans[i] != ex_chans[i] || m_resetOutputsData) {
-      emit channelMixValueChange(i, ex_chans[i], limit * 2);
-      emit outputValueChange(OUTPUT_SRC_CHAN_MIX, i, ex_chans[i]);
-      lastOutputs.ex_chans[i] = ex_chans[i];
-    }
+    outputs.chans[i] = channelOutputs[i];
+    if (outputs.chans[i] != m_lastOutputs.chans[i] || outputs.chansLimit != m_lastOutputs.chansLimit || m_resetOutputsData)
+      dirty.set(OUTPUT_SRC_CHAN_OUT, i);
+    outputs.ex_chans[i] = ex_chans[i];
+    if (outputs.ex_chans[i] != m_lastOutputs.ex_chans[i] || m_resetOutputsData)
+      dirty.set(OUTPUT_SRC_CHAN_MIX, i);
   }
 
   for (i=0; i < MAX_LOGICAL_SWITCHES; i++) {
-    tmpVal = (qint32)GET_SWITCH_BOOL(SWSRC_SW1+i);
-    if (lastOutputs.vsw[i] != (bool)tmpVal || m_resetOutputsData) {
-      emit virtualSwValueChange(i, tmpVal);
-      emit outputValueChange(OUTPUT_SRC_VIRTUAL_SW, i, tmpVal);
-      lastOutputs.vsw[i] = tmpVal;
-    }
+    outputs.vsw[i] = GET_SWITCH_BOOL(SWSRC_SW1+i);
+    if (outputs.vsw[i] != m_lastOutputs.vsw[i] || m_resetOutputsData)
+      dirty.set(OUTPUT_SRC_VIRTUAL_SW, i);
   }
 
   for (i=0; i < Board::TRIM_AXIS_COUNT; i++) {
@@ -506,26 +550,19 @@ void OpenTxSimulator::checkOutputsChanged()
     else
       idx = i;
 
-    tmpVal = getTrimValue(getTrimFlightMode(phase, idx), idx);
-    if (lastOutputs.trims[i] != tmpVal || m_resetOutputsData) {
-      emit trimValueChange(i, tmpVal);
-      emit outputValueChange(OUTPUT_SRC_TRIM_VALUE, i, tmpVal);
-      lastOutputs.trims[i] = tmpVal;
-    }
+    outputs.trims[i] = getTrimValue(getTrimFlightMode(phase, idx), idx);
+    if (outputs.trims[i] != m_lastOutputs.trims[i] || m_resetOutputsData)
+      dirty.set(OUTPUT_SRC_TRIM_VALUE, i);
   }
 
-  tmpVal = g_model.extendedTrims ? TRIM_EXTENDED_MAX : TRIM_MAX;
-  if (lastOutputs.trimRange != tmpVal || m_resetOutputsData) {
-    emit trimRangeChange(Board::TRIM_AXIS_COUNT, -tmpVal, tmpVal);
-    emit outputValueChange(OUTPUT_SRC_TRIM_RANGE, Board::TRIM_AXIS_COUNT, tmpVal);
-    lastOutputs.trimRange = tmpVal;
-  }
+  outputs.trimRange = g_model.extendedTrims ? TRIM_EXTENDED_MAX : TRIM_MAX;
+  if (outputs.trimRange != m_lastOutputs.trimRange || m_resetOutputsData)
+    dirty.set(OUTPUT_SRC_TRIM_RANGE, 0);
 
-  if (lastOutputs.phase != phase || m_resetOutputsData) {
-    emit phaseChanged(phase, getCurrentPhaseName());
-    emit outputValueChange(OUTPUT_SRC_PHASE, 0, qint16(phase));
-    lastOutputs.phase = phase;
-  }
+  outputs.phase = phase;
+  strncpy(outputs.phaseName, getCurrentPhaseName().toUtf8().constData(), sizeof(outputs.phaseName) - 1);
+  if (outputs.phase != m_lastOutputs.phase || strcmp(outputs.phaseName, m_lastOutputs.phaseName) || m_resetOutputsData)
+    dirty.set(OUTPUT_SRC_PHASE, 0);
 
 #if defined(GVAR_VALUE) && defined(GVARS)
   gVarMode_t gvar;
@@ -535,16 +572,24 @@ void OpenTxSimulator::checkOutputsChanged()
     for (uint8_t fm=0; fm < MAX_FLIGHT_MODES; fm++) {
       gvar.mode = fm;
       gvar.value = (int16_t)GVAR_VALUE(gv, getGVarFlightMode(fm, gv));
-      tmpVal = gvar;
-      if (lastOutputs.gvars[fm][gv] != tmpVal || m_resetOutputsData) {
-        lastOutputs.gvars[fm][gv] = tmpVal;
-        emit gVarValueChange(gv, tmpVal);
-        emit outputValueChange(OUTPUT_SRC_GVAR, gv, tmpVal);
-      }
+      outputs.gvars[fm][gv] = gvar;
+      if (outputs.gvars[fm][gv] != m_lastOutputs.gvars[fm][gv] || m_resetOutputsData)
+        dirty.set(OUTPUT_SRC_GVAR, fm * CPN_MAX_GVARS + gv);
     }
   }
 #endif
 
+  m_lastOutputs = outputs;
+  m_outputs.publish();
+
+  // one atomic operation per changed word, nothing at all when nothing changed
+  for (int type=0; type < OUTPUT_SRC_ENUM_COUNT; type++) {
+    for (int word=0; word < TxOutputsDirty::WORDS; word++) {
+      if (dirty.bits[type][word])
+        m_outputsDirty[type][word].fetch_or(dirty.bits[type][word]);
+    }
+  }
+
   m_resetOutputsData = false;
 }
 
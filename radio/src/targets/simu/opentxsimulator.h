@@ -18,6 +18,7 @@
 #define _OPENTX_SIMULATOR_H_
 
 #include "simulatorinterface.h"
+#include "simusnapshot.h"
 
 #include <QMutex>
 #include <QObject>
@@ -45,6 +46,8 @@ class DLLEXPORT OpenTxSimulator : public SimulatorInterface
     virtual uint8_t getSensorInstance(uint16_t id, uint8_t defaultValue = 0);
     virtual uint16_t getSensorRatio(uint16_t id);
     virtual const int getCapability(Capability cap);
+    virtual bool readOutputs(TxOutputs & outputs, TxOutputsDirty & dirty);
+    virtual bool readLcd(bool & backlightEnable);
 
     static QVector<QIODevice *> tracebackDevices;
 
@@ -75,6 +78,8 @@ class DLLEXPORT OpenTxSimulator : public SimulatorInterface
 
   protected:
 
+    struct LcdFrame;
+
     bool isStopRequested();
     void setStopRequested(bool stop);
     bool checkLcdChanged();
@@ -97,6 +102,13 @@ class DLLEXPORT OpenTxSimulator : public SimulatorInterface
     bool m_resetOutputsData;
     bool m_stopRequested;
 
+    // written by the simulator thread, read by the UI one
+    SimuSnapshot<TxOutputs> m_outputs;
+    std::atomic<quint32> m_outputsDirty[OUTPUT_SRC_ENUM_COUNT][TxOutputsDirty::WORDS];
+    TxOutputs m_lastOutputs;
+    SimuSnapshot<LcdFrame> * m_lcdFrames;
+    LcdFrame * m_lcdFrame;  // the UI copy returned by getLcd()
+
 };
 
 #endif // _OPENTX_SIMULATOR_H_
@@ -24,6 +24,7 @@
 #include <errno.h>
 #include <stdarg.h>
 #include <string>
+#include <atomic>
 
 #if !defined (_MSC_VER) || defined (__GNUC__)
   #include <chrono>
@@ -32,6 +33,7 @@
 
 #if defined(SIMU_AUDIO)
   #include <SDL.h>
+  #include "audio_kernels.h"
 #endif
 
 uint8_t MCUCSR, MCUSR, MCUCR;
@@ -74,8 +76,34 @@ void toplcdOff()
 {
 }
 
+static bool simu_virtual_clock = false;
+static std::atomic<uint64_t> simu_virtual_micros(0);
+
+void simuSetVirtualClock(bool enable)
+{
+  if (enable && !simu_virtual_clock) {
+    // continue from the current time so that the timers don't go backwards
+    simu_virtual_micros = simuTimerMicros();
+  }
+  simu_virtual_clock = enable;
+}
+
+bool simuIsVirtualClock()
+{
+  return simu_virtual_clock;
+}
+
+void simuAdvanceTime(uint64_t micros)
+{
+  simu_virtual_micros += micros;
+}
+
 uint64_t simuTimerMicros(void)
 {
+  if (simu_virtual_clock) {
+    return simu_virtual_micros;
+  }
+
 #if SIMPGMSPC_USE_QT
 
   static QElapsedTimer ticker;
@@ -400,6 +428,12 @@ bool simuIsRunning()
 
 uint8_t simuSleep(uint32_t ms)
 {
+  if (simu_virtual_clock) {
+    // the headless driver runs everything in one thread, a wait just moves the time forward
+    simuAdvanceTime(ms * 1000);
+    return simu_shutdown;
+  }
+
   for (uint32_t i = 0; i < ms; ++i){
     if (simu_shutdown || !simu_running)
       return 1;
@@ -430,11 +464,8 @@ int32_t getVolume()
 #if defined(SIMU_AUDIO)
 void copyBuffer(uint8_t * dest, const uint16_t * buff, unsigned int samples)
 {
-  for(unsigned int i=0; i<samples; i++) {
-    int sample = ((int32_t)(uint32_t)(buff[i]) - 0x8000);  // conversion from uint16_t
-    *((uint16_t*)dest) = (int16_t)((sample * simuAudio.currentVolume)/127);
-    dest += 2;
-  }
+  int16_t gain = min<int>(simuAudio.currentVolume * AUDIO_GAIN_UNIT / 127, AUDIO_GAIN_MAX);
+  audioConvertS16((int16_t *)dest, buff, samples, AUDIO_DATA_SILENCE, 16 - AUDIO_BITS_PER_SAMPLE, gain);
 }
 
 void fillAudioBuffer(void *udata, Uint8 *stream, int len)
@@ -693,6 +724,12 @@ uint32_t isBootloaderStart(const uint8_t * block) { return 1; }
 void LCD_ControlLight(uint16_t dutyCycle) { }
 #endif
 
+#if defined(INTERNAL_GPS)
+void gpsInit(uint32_t baudrate) { }
+uint8_t gpsGetByte(uint8_t * byte) { return 0; }
+void gpsSendByte(uint8_t byte) { }
+#endif
+
 void serialPrintf(const char * format, ...) { }
 void serialCrlf() { }
 void serialPutc(char c) { }
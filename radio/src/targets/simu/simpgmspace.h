@@ -236,6 +236,12 @@ static inline void getADC() { }
 
 uint64_t simuTimerMicros(void);
 
+// Virtual clock: simuTimerMicros() and the RTOS waits follow a counter which only moves
+// with simuAdvanceTime(), for deterministic faster than real time runs (see headless.cpp)
+void simuSetVirtualClock(bool enable);
+bool simuIsVirtualClock();
+void simuAdvanceTime(uint64_t micros);
+
 void simuInit();
 void StartSimu(bool tests=true, const char * sdPath = 0, const char * settingsPath = 0);
 void StopSimu();
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _SIMUSNAPSHOT_H_
+#define _SIMUSNAPSHOT_H_
+
+#include <atomic>
+#include <stdint.h>
+
+// Lock-free triple buffer between one writer thread and one reader thread:
+// the writer fills back() then calls publish(), the reader calls update() then reads front().
+// Neither of them ever waits, the reader always gets the latest complete copy.
+template <class T>
+class SimuSnapshot
+{
+  public:
+    SimuSnapshot():
+      backIndex(0),
+      frontIndex(2),
+      middle(1)
+    {
+    }
+
+    T & back()
+    {
+      return buffers[backIndex];
+    }
+
+    void publish()
+    {
+      backIndex = middle.exchange(backIndex | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // returns false if nothing was published since the previous call
+    bool update()
+    {
+      if (!(middle.load(std::memory_order_relaxed) & FRESH))
+        return false;
+      frontIndex = middle.exchange(frontIndex, std::memory_order_acq_rel) & INDEX_MASK;
+      return true;
+    }
+
+    const T & front() const
+    {
+      return buffers[frontIndex];
+    }
+
+  protected:
+    enum {
+      INDEX_MASK = 0x03,
+      FRESH = 0x04
+    };
+
+    T buffers[3];
+    uint8_t backIndex;         // only used by the writer
+    uint8_t frontIndex;        // only used by the reader
+    std::atomic<uint8_t> middle;
+};
+
+#endif // _SIMUSNAPSHOT_H_
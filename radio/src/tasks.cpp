@@ -185,7 +185,7 @@ TASK_FUNCTION(mixerTask) {
 
 #define MENU_TASK_PERIOD_TICKS (50 / RTOS_MS_PER_TICK)   // 50ms
 
-#if defined(COLORLCD) && defined(CLI)
+#if defined(CLI)
 bool perMainEnabled = true;
 #endif
 
@@ -206,7 +206,7 @@ TASK_FUNCTION(menusTask) {
 #endif
     uint32_t start = (uint32_t)RTOS_GET_TIME();
     DEBUG_TIMER_START(debugTimerPerMain);
-#if defined(COLORLCD) && defined(CLI)
+#if defined(CLI)
     if (perMainEnabled) {
       perMain();
     }
@@ -214,6 +214,14 @@ TASK_FUNCTION(menusTask) {
     perMain();
 #endif
     DEBUG_TIMER_STOP(debugTimerPerMain);
+#if defined(LUA)
+    // Lua garbage collection uses the time left in this period
+    uint32_t elapsed = ((uint32_t)RTOS_GET_TIME() - start);
+#if defined(CLI)
+    if (perMainEnabled)
+#endif
+    luaGcTask(elapsed < MENU_TASK_PERIOD_TICKS ? (MENU_TASK_PERIOD_TICKS - elapsed) * RTOS_MS_PER_TICK * 1000 : 0);
+#endif
     // TODO remove completely massstorage from sky9x firmware
     uint32_t runtime = ((uint32_t)RTOS_GET_TIME() - start);
     // deduct the thread run-time from the wait, if run-time was more than
@@ -50,8 +50,13 @@ extern RTOS_DEFINE_STACK(audioStack, AUDIO_STACK_SIZE);
 extern RTOS_MUTEX_HANDLE mixerMutex;
 extern RTOS_FLAG_HANDLE openTxInitCompleteFlag;
 
+#if defined(CLI)
+extern bool perMainEnabled;   // menus task, disabled by the CLI tests and benchmarks
+#endif
+
 void stackPaint();
 void tasksStart();
+void execMixerFrequentActions();
 
 extern volatile uint16_t timeForcePowerOffPressed;
 inline void resetForcePowerOffRequest()
@@ -83,20 +83,20 @@ void processCrossfireTelemetryValue(uint8_t index, int32_t value) {
   setTelemetryValue(TELEM_PROTO_CROSSFIRE, sensor.id, 0, sensor.subId, value, sensor.unit, sensor.precision);
 }
 
-bool checkCrossfireTelemetryFrameCRC() {
-  uint8_t len = telemetryRxBuffer[1];
+bool checkCrossfireTelemetryFrameCRC(const uint8_t * frame) {
+  uint8_t len = frame[1];
 #if defined(PCBI6X)
-  uint8_t crc = crc8_hw(&telemetryRxBuffer[2], len - 1);
+  uint8_t crc = crc8_hw(&frame[2], len - 1);
 #else
-  uint8_t crc = crc8(&telemetryRxBuffer[2], len - 1);
+  uint8_t crc = crc8(&frame[2], len - 1);
 #endif
-  return (crc == telemetryRxBuffer[len + 1]);
+  return (crc == frame[len + 1]);
 }
 
 template <int N>
-bool getCrossfireTelemetryValue(uint8_t index, int32_t &value) {
+bool getCrossfireTelemetryValue(const uint8_t * frame, uint8_t index, int32_t &value) {
   bool result = false;
-  uint8_t *byte = &telemetryRxBuffer[index];
+  const uint8_t *byte = &frame[index];
   value = (*byte & 0x80) ? -1 : 0;
   for (uint8_t i = 0; i < N; i++) {
     value <<= 8;
@@ -108,38 +108,39 @@ bool getCrossfireTelemetryValue(uint8_t index, int32_t &value) {
   return result;
 }
 
-void processCrossfireTelemetryFrame() {
+// frame holds a whole frame with a valid CRC, len is its size
+void processCrossfireTelemetryFrame(const uint8_t * frame, uint8_t len) {
 
   if (telemetryState == TELEMETRY_INIT && moduleState[EXTERNAL_MODULE].counter != CRSF_FRAME_MODELID_SENT) {
     moduleState[EXTERNAL_MODULE].counter = CRSF_FRAME_MODELID;
   }
 
-  uint8_t crsfPayloadLen = telemetryRxBuffer[1];
-  uint8_t id = telemetryRxBuffer[2];
+  uint8_t crsfPayloadLen = frame[1];
+  uint8_t id = frame[2];
   int32_t value;
   switch (id) {
     case CF_VARIO_ID:
-      if (getCrossfireTelemetryValue<2>(3, value))
+      if (getCrossfireTelemetryValue<2>(frame, 3, value))
         processCrossfireTelemetryValue(VERTICAL_SPEED_INDEX, value);
       break;
 
     case GPS_ID:
-      if (getCrossfireTelemetryValue<4>(3, value))
+      if (getCrossfireTelemetryValue<4>(frame, 3, value))
         processCrossfireTelemetryValue(GPS_LATITUDE_INDEX, value / 10);
-      if (getCrossfireTelemetryValue<4>(7, value))
+      if (getCrossfireTelemetryValue<4>(frame, 7, value))
         processCrossfireTelemetryValue(GPS_LONGITUDE_INDEX, value / 10);
-      if (getCrossfireTelemetryValue<2>(11, value))
+      if (getCrossfireTelemetryValue<2>(frame, 11, value))
         processCrossfireTelemetryValue(GPS_GROUND_SPEED_INDEX, value);
-      if (getCrossfireTelemetryValue<2>(13, value))
+      if (getCrossfireTelemetryValue<2>(frame, 13, value))
         processCrossfireTelemetryValue(GPS_HEADING_INDEX, value);
-      if (getCrossfireTelemetryValue<2>(15, value))
+      if (getCrossfireTelemetryValue<2>(frame, 15, value))
         processCrossfireTelemetryValue(GPS_ALTITUDE_INDEX, value - 1000);
-      if (getCrossfireTelemetryValue<1>(17, value))
+      if (getCrossfireTelemetryValue<1>(frame, 17, value))
         processCrossfireTelemetryValue(GPS_SATELLITES_INDEX, value);
       break;
 
     case BARO_ALT_ID:
-      if (getCrossfireTelemetryValue<2>(3, value)) {
+      if (getCrossfireTelemetryValue<2>(frame, 3, value)) {
         if (value & 0x8000) {
           // Altitude in meters
           value &= ~(0x8000);
@@ -153,13 +154,13 @@ void processCrossfireTelemetryFrame() {
       }
       // Length of TBS BARO_ALT has 4 payload bytes with just 2 bytes of altitude
       // but support including VARIO if the declared payload length is 6 bytes or more
-      if (crsfPayloadLen > 5 && getCrossfireTelemetryValue<2>(5, value))
+      if (crsfPayloadLen > 5 && getCrossfireTelemetryValue<2>(frame, 5, value))
         processCrossfireTelemetryValue(VERTICAL_SPEED_INDEX, value);
       break;
 
     case LINK_ID:
       for (unsigned int i = 0; i <= TX_SNR_INDEX; i++) {
-        if (getCrossfireTelemetryValue<1>(3 + i, value)) {
+        if (getCrossfireTelemetryValue<1>(frame, 3 + i, value)) {
           if (i == TX_POWER_INDEX) {
             static const int32_t power_values[] = {0, 10, 25, 100, 500, 1000, 2000, 250, 50};
             value = ((unsigned)value < DIM(power_values) ? power_values[value] : 0);
@@ -179,56 +180,59 @@ void processCrossfireTelemetryFrame() {
       break;
 
     case LINK_RX_ID:
-      if (getCrossfireTelemetryValue<1>(4, value))
+      if (getCrossfireTelemetryValue<1>(frame, 4, value))
         processCrossfireTelemetryValue(RX_RSSI_PERC_INDEX, value);
-      if (getCrossfireTelemetryValue<1>(7, value))
+      if (getCrossfireTelemetryValue<1>(frame, 7, value))
         processCrossfireTelemetryValue(TX_RF_POWER_INDEX, value);
       break;
 
     case LINK_TX_ID:
-      if (getCrossfireTelemetryValue<1>(4, value))
+      if (getCrossfireTelemetryValue<1>(frame, 4, value))
         processCrossfireTelemetryValue(TX_RSSI_PERC_INDEX, value);
-      if (getCrossfireTelemetryValue<1>(7, value))
+      if (getCrossfireTelemetryValue<1>(frame, 7, value))
         processCrossfireTelemetryValue(RX_RF_POWER_INDEX, value);
-      if (getCrossfireTelemetryValue<1>(8, value))
+      if (getCrossfireTelemetryValue<1>(frame, 8, value))
         processCrossfireTelemetryValue(TX_FPS_INDEX, value * 10);
       break;
 
     case BATTERY_ID:
-      if (getCrossfireTelemetryValue<2>(3, value))
+      if (getCrossfireTelemetryValue<2>(frame, 3, value))
         processCrossfireTelemetryValue(BATT_VOLTAGE_INDEX, value);
-      if (getCrossfireTelemetryValue<2>(5, value))
+      if (getCrossfireTelemetryValue<2>(frame, 5, value))
         processCrossfireTelemetryValue(BATT_CURRENT_INDEX, value);
-      if (getCrossfireTelemetryValue<3>(7, value))
+      if (getCrossfireTelemetryValue<3>(frame, 7, value))
         processCrossfireTelemetryValue(BATT_CAPACITY_INDEX, value);
-      if (getCrossfireTelemetryValue<1>(10, value))
+      if (getCrossfireTelemetryValue<1>(frame, 10, value))
         processCrossfireTelemetryValue(BATT_REMAINING_INDEX, value);
       break;
 
     case ATTITUDE_ID:
-      if (getCrossfireTelemetryValue<2>(3, value))
+      if (getCrossfireTelemetryValue<2>(frame, 3, value))
         processCrossfireTelemetryValue(ATTITUDE_PITCH_INDEX, value / 10);
-      if (getCrossfireTelemetryValue<2>(5, value))
+      if (getCrossfireTelemetryValue<2>(frame, 5, value))
         processCrossfireTelemetryValue(ATTITUDE_ROLL_INDEX, value / 10);
-      if (getCrossfireTelemetryValue<2>(7, value))
+      if (getCrossfireTelemetryValue<2>(frame, 7, value))
         processCrossfireTelemetryValue(ATTITUDE_YAW_INDEX, value / 10);
       break;
 
     case FLIGHT_MODE_ID: {
       const CrossfireSensor &sensor = crossfireSensors[FLIGHT_MODE_INDEX];
-      auto textLength = min<int>(16, telemetryRxBuffer[1]);
-      telemetryRxBuffer[textLength] = '\0';
-      setTelemetryText(TELEM_PROTO_CROSSFIRE, sensor.id, 0, sensor.subId, (const char *)telemetryRxBuffer + 3);
+      // the text ends at most at byte 16 of the frame, which is parsed in place
+      char text[16];
+      auto textLength = limit<int>(0, min<int>(16, frame[1]) - 3, sizeof(text) - 1);
+      memcpy(text, frame + 3, textLength);
+      text[textLength] = '\0';
+      setTelemetryText(TELEM_PROTO_CROSSFIRE, sensor.id, 0, sensor.subId, text);
       break;
     }
 
     case RADIO_ID:
-      if (telemetryRxBuffer[3] == 0xEA     // radio address
-          && telemetryRxBuffer[5] == 0x10  // timing correction frame
+      if (frame[3] == 0xEA     // radio address
+          && frame[5] == 0x10  // timing correction frame
       ) {
         uint32_t update_interval;
         int32_t offset;
-        if (getCrossfireTelemetryValue<4>(6, (int32_t &)update_interval) && getCrossfireTelemetryValue<4>(10, offset)) {
+        if (getCrossfireTelemetryValue<4>(frame, 6, (int32_t &)update_interval) && getCrossfireTelemetryValue<4>(frame, 10, offset)) {
           // values are in 10th of micro-seconds
           update_interval /= 10;
           offset /= 10;
@@ -240,16 +244,16 @@ void processCrossfireTelemetryFrame() {
       break;
     default:
 #if defined(LUA)
-      if (luaInputTelemetryFifo && luaInputTelemetryFifo->hasSpace(telemetryRxBufferCount - 2)) {
-        for (uint8_t i = 1; i < telemetryRxBufferCount - 1; i++) {
+      if (luaInputTelemetryFifo && luaInputTelemetryFifo->hasSpace(len - 2)) {
+        for (uint8_t i = 1; i < len - 1; i++) {
           // destination address and CRC are skipped
-          luaInputTelemetryFifo->push(telemetryRxBuffer[i]);
+          luaInputTelemetryFifo->push(frame[i]);
         }
       }
 #else
       // <Device address 0><Frame length 1><Type 2><Payload 3><CRC>
       // destination address and CRC are skipped
-      runCrossfireTelemetryCallback(telemetryRxBuffer[2], telemetryRxBuffer + 2, telemetryRxBuffer[1] - 1);
+      runCrossfireTelemetryCallback(frame[2], frame + 2, frame[1] - 1);
 #endif
       break;
   }
@@ -296,14 +300,8 @@ void crossfireTelemetrySeekStart(uint8_t *rxBuffer, uint8_t &rxBufferCount)
   rxBufferCount = 0;
 }
 
-void processCrossfireTelemetryData(uint8_t data) {
-
-#if defined(AUX_SERIAL)
-  if (g_eeGeneral.auxSerialMode == UART_MODE_TELEMETRY_MIRROR) {
-    auxSerialPutc(data);
-  }
-#endif
-
+// Byte by byte frame assembly in telemetryRxBuffer
+static void pushCrossfireTelemetryByte(uint8_t data) {
   if (telemetryRxBufferCount == 0 && data != RADIO_ADDRESS) {
     TRACE("[XF] address 0x%02X error", data);
     return;
@@ -324,8 +322,8 @@ void processCrossfireTelemetryData(uint8_t data) {
 
   // telemetryRxBuffer[1] holds the packet length-2, check if the whole packet was received
   while (telemetryRxBufferCount > 4 && (telemetryRxBuffer[1]+2) == telemetryRxBufferCount) {
-    if (checkCrossfireTelemetryFrameCRC()) {
-      processCrossfireTelemetryFrame();
+    if (checkCrossfireTelemetryFrameCRC(telemetryRxBuffer)) {
+      processCrossfireTelemetryFrame(telemetryRxBuffer, telemetryRxBufferCount);
       telemetryRxBufferCount = 0;
     }
     else {
@@ -335,6 +333,48 @@ void processCrossfireTelemetryData(uint8_t data) {
   }
 }
 
+void processCrossfireTelemetryData(uint8_t data) {
+
+#if defined(AUX_SERIAL)
+  if (g_eeGeneral.auxSerialMode == UART_MODE_TELEMETRY_MIRROR) {
+    auxSerialPutc(data);
+  }
+#endif
+
+  pushCrossfireTelemetryByte(data);
+}
+
+void processCrossfireTelemetryChunk(const uint8_t * data, uint32_t len) {
+
+#if defined(AUX_SERIAL)
+  if (g_eeGeneral.auxSerialMode == UART_MODE_TELEMETRY_MIRROR) {
+    for (uint32_t i = 0; i < len; i++) {
+      auxSerialPutc(data[i]);
+    }
+  }
+#endif
+
+  const uint8_t * end = data + len;
+  while (data < end) {
+    uint32_t remain = end - data;
+    // Frames split between 2 chunks, and bytes to skip, go through the byte by byte assembly
+    if (telemetryRxBufferCount > 0 || remain < 2 || data[0] != RADIO_ADDRESS || !crossfireLenIsSane(data[1]) || uint32_t(data[1] + 2) > remain) {
+      pushCrossfireTelemetryByte(*data++);
+      continue;
+    }
+    // Whole frames are parsed in place
+    uint8_t frameLen = data[1] + 2;
+    if (checkCrossfireTelemetryFrameCRC(data)) {
+      processCrossfireTelemetryFrame(data, frameLen);
+      data += frameLen;
+    }
+    else {
+      TRACE("[XF] CRC error ");
+      data++;
+    }
+  }
+}
+
 void crossfireSetDefault(int index, uint8_t id, uint8_t subId) {
   TelemetrySensor &telemetrySensor = g_model.telemetrySensors[index];
 
@@ -359,13 +399,13 @@ void crossfireSetDefault(int index, uint8_t id, uint8_t subId) {
 /**
  * Skip luaInputTelemetryFifo and luaCrossfireTelemetryPop() to save RAM and provide synchronous API instead
  */
-void (*crossfireTelemetryCallback)(uint8_t, uint8_t*, uint8_t);
+void (*crossfireTelemetryCallback)(uint8_t, const uint8_t*, uint8_t);
 
-void registerCrossfireTelemetryCallback(void (*callback)(uint8_t, uint8_t*, uint8_t)) {
+void registerCrossfireTelemetryCallback(void (*callback)(uint8_t, const uint8_t*, uint8_t)) {
   crossfireTelemetryCallback = callback;
 }
 
-inline void runCrossfireTelemetryCallback(uint8_t command, uint8_t* data, uint8_t length) {
+inline void runCrossfireTelemetryCallback(uint8_t command, const uint8_t* data, uint8_t length) {
   if (crossfireTelemetryCallback != nullptr) {
     crossfireTelemetryCallback(command, data, length);
   }
@@ -99,10 +99,12 @@ enum CrossfireFrames{
   CRSF_FRAME_MODELID_SENT
 };
 
-void registerCrossfireTelemetryCallback(void (*callback)(uint8_t, uint8_t*, uint8_t));
-void runCrossfireTelemetryCallback(uint8_t command, uint8_t* data, uint8_t length);
+void registerCrossfireTelemetryCallback(void (*callback)(uint8_t, const uint8_t*, uint8_t));
+void runCrossfireTelemetryCallback(uint8_t command, const uint8_t* data, uint8_t length);
 
 void processCrossfireTelemetryData(uint8_t data);
+// Parses the whole frames of a received chunk in place, frames split between chunks are reassembled
+void processCrossfireTelemetryChunk(const uint8_t * data, uint32_t len);
 void crossfireSetDefault(int index, uint8_t id, uint8_t subId);
 bool isCrossfireOutputBufferAvailable();
 uint8_t createCrossfireModelIDFrame(uint8_t * frame);
@@ -65,6 +65,20 @@ void processTelemetryData(uint8_t data)
 #endif
 }
 
+void processTelemetryFrame(const uint8_t * frame, uint32_t len)
+{
+#if defined(CROSSFIRE)
+  if (telemetryProtocol == PROTOCOL_PULSES_CROSSFIRE) {
+    processCrossfireTelemetryChunk(frame, len);
+    return;
+  }
+#endif
+  // the other protocols have no frame parser yet
+  for (uint32_t i = 0; i < len; i++) {
+    processTelemetryData(frame[i]);
+  }
+}
+
 void telemetryWakeup()
 {
   uint8_t requiredTelemetryProtocol = modelTelemetryProtocol();
@@ -78,7 +92,18 @@ void telemetryWakeup()
     telemetryInit(requiredTelemetryProtocol);
   }
 
-#if defined(STM32)
+#if defined(TELEMETRY_RX_FRAMES)
+  const uint8_t * frame;
+  uint32_t len;
+  while (telemetryGetFrame(frame, len)) {
+    LOG_TELEMETRY_WRITE_START();
+    for (uint32_t i = 0; i < len; i++) {
+      LOG_TELEMETRY_WRITE_BYTE(frame[i]);
+    }
+    processTelemetryFrame(frame, len);
+    telemetryReleaseFrame();
+  }
+#elif defined(STM32)
   uint8_t data;
   if (telemetryGetByte(&data)) {
     LOG_TELEMETRY_WRITE_START();
@@ -101,12 +126,7 @@ void telemetryWakeup()
 #endif
 
 
-  for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
-    const TelemetrySensor & sensor = g_model.telemetrySensors[i];
-    if (sensor.type == TELEM_TYPE_CALCULATED) {
-      telemetryItems[i].eval(sensor);
-    }
-  }
+  evalCalculatedSensors();
 
 #if defined(VARIO)
   if (TELEMETRY_STREAMING() && !IS_FAI_ENABLED()) {
@@ -217,6 +237,7 @@ void telemetryReset()
   for (int index=0; index<MAX_TELEMETRY_SENSORS; index++) {
     telemetryItems[index].clear();
   }
+  calculatedSensorsChanged();
 
   telemetryStreaming = 0; // reset counter only if valid frsky packets are being detected
 
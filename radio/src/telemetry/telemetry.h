@@ -53,6 +53,8 @@ enum TelemetryProtocol
 
 void telemetryInit(uint8_t protocol);
 void telemetryWakeup();
+// Processes a chunk of received bytes, made of whole frames when the driver receives by frames
+void processTelemetryFrame(const uint8_t * frame, uint32_t len);
 void telemetryReset();
 void telemetryInterrupt10ms();
 int setTelemetryValue(TelemetryProtocol protocol, uint16_t id, uint8_t subId, uint8_t instance, int32_t value, uint32_t unit, uint32_t prec);
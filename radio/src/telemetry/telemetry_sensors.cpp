@@ -421,6 +421,139 @@ void TelemetryItem::eval(const TelemetrySensor& sensor) {
   }
 }
 
+static_assert(MAX_TELEMETRY_SENSORS <= 32, "The updated sensors don't fit in a 32 bits mask");
+
+// Calculated sensors are only evaluated when one of their sources was updated (fresh value or
+// lost), in an order where each sensor comes after its sources: a chain of calculated sensors
+// (cells -> lowest cell -> sum) is then evaluated within the same telemetryWakeup().
+static uint32_t telemetryUpdatedSensors;  // set by setFresh() / setOld(), also from the 10ms interrupt
+static uint8_t calculatedSensorsOrder[MAX_TELEMETRY_SENSORS];
+static uint8_t calculatedSensorsCount;
+static uint32_t calculatedSensorsLoop;    // sensors depending on themselves, evaluated at each wakeup
+static bool calculatedSensorsOrderValid;
+
+static void setSensorUpdated(unsigned int index)
+{
+  if (index < MAX_TELEMETRY_SENSORS) {
+    __disable_irq();
+    telemetryUpdatedSensors |= (1u << index);
+    __enable_irq();
+  }
+}
+
+void TelemetryItem::setFresh()
+{
+  timeout = TELEMETRY_SENSOR_TIMEOUT_START;
+  setSensorUpdated(this - telemetryItems);
+}
+
+void TelemetryItem::setOld()
+{
+  timeout = TELEMETRY_SENSOR_TIMEOUT_OLD;
+  setSensorUpdated(this - telemetryItems);
+}
+
+static uint32_t sensorMask(unsigned int source) {
+  // source is 1-based, 0 meaning none
+  return (source > 0 && source <= MAX_TELEMETRY_SENSORS) ? (1u << (source - 1)) : 0;
+}
+
+// The sensors read by TelemetryItem::eval(), 0 if there is nothing to evaluate
+static uint32_t getCalculatedSensorSources(const TelemetrySensor& sensor) {
+  if (sensor.type != TELEM_TYPE_CALCULATED)
+    return 0;
+
+  switch (sensor.formula) {
+    case TELEM_FORMULA_CELL:
+      return sensorMask(sensor.cell.source);
+
+    case TELEM_FORMULA_DIST:
+      return sensor.dist.gps ? (sensorMask(sensor.dist.gps) | sensorMask(sensor.dist.alt)) : 0;
+
+    case TELEM_FORMULA_ADD:
+    case TELEM_FORMULA_AVERAGE:
+    case TELEM_FORMULA_MIN:
+    case TELEM_FORMULA_MAX:
+    case TELEM_FORMULA_MULTIPLY: {
+      uint32_t sources = 0;
+      int maxitems = (sensor.formula == TELEM_FORMULA_MULTIPLY ? 2 : 4);
+      for (int i = 0; i < maxitems; i++) {
+        sources |= sensorMask(abs(sensor.calc.sources[i]));
+      }
+      return sources;
+    }
+
+    default:
+      // consumption and totalize are updated with their source
+      return 0;
+  }
+}
+
+static void buildCalculatedSensorsOrder() {
+  uint32_t pending = 0;
+  for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+    if (getCalculatedSensorSources(g_model.telemetrySensors[i]))
+      pending |= (1u << i);
+  }
+
+  calculatedSensorsCount = 0;
+  calculatedSensorsLoop = 0;
+  while (pending) {
+    bool progress = false;
+    for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+      if ((pending & (1u << i)) && !(getCalculatedSensorSources(g_model.telemetrySensors[i]) & pending)) {
+        calculatedSensorsOrder[calculatedSensorsCount++] = i;
+        pending &= ~(1u << i);
+        progress = true;
+      }
+    }
+    if (!progress) {
+      // a loop between sensors: evaluate the rest in the index order and keep them
+      // updated, so that they are evaluated at each wakeup as before
+      for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+        if (pending & (1u << i))
+          calculatedSensorsOrder[calculatedSensorsCount++] = i;
+      }
+      calculatedSensorsLoop = pending;
+      break;
+    }
+  }
+
+  calculatedSensorsOrderValid = true;
+}
+
+// also called once an edit is written (see checkStorageChanges()), the order may have been built
+// between storageDirty() and the write
+void calculatedSensorsChanged() {
+  calculatedSensorsOrderValid = false;
+}
+
+void evalCalculatedSensors() {
+  uint32_t consumed;
+
+  if (calculatedSensorsOrderValid) {
+    consumed = telemetryUpdatedSensors;
+  }
+  else {
+    buildCalculatedSensorsOrder();
+    consumed = 0xFFFFFFFF;  // evaluate them all once
+  }
+
+  for (uint8_t i = 0; i < calculatedSensorsCount; i++) {
+    uint8_t index = calculatedSensorsOrder[i];
+    const TelemetrySensor& sensor = g_model.telemetrySensors[index];
+    // the sensors evaluated before in this loop are already in telemetryUpdatedSensors
+    if (getCalculatedSensorSources(sensor) & (consumed | telemetryUpdatedSensors)) {
+      telemetryItems[index].eval(sensor);
+      consumed |= (1u << index);
+    }
+  }
+
+  __disable_irq();
+  telemetryUpdatedSensors &= ~(consumed & ~calculatedSensorsLoop);
+  __enable_irq();
+}
+
 void delTelemetryIndex(uint8_t index) {
   memclear(&g_model.telemetrySensors[index], sizeof(TelemetrySensor));
   telemetryItems[index].clear();
@@ -121,19 +121,16 @@ class TelemetryItem
       return TELEMETRY_SENSOR_TIMEOUT_START - timeout <= 1; // 2 * 160ms
     }
 
-    inline void setFresh()
-    {
-      timeout = TELEMETRY_SENSOR_TIMEOUT_START;
-    }
-
-    inline void setOld()
-    {
-      timeout = TELEMETRY_SENSOR_TIMEOUT_OLD;
-    }
+    // both also flag the item as updated for evalCalculatedSensors()
+    void setFresh();
+    void setOld();
 };
 
 extern TelemetryItem telemetryItems[MAX_TELEMETRY_SENSORS];
 extern uint8_t allowNewSensors;
 bool isFaiForbidden(source_t idx);
 
+void evalCalculatedSensors();
+void calculatedSensorsChanged();
+
 #endif // _TELEMETRY_SENSORS_H_
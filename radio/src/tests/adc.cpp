@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <algorithm>
+#include "gtests.h"
+#include "analogs_filter.h"
+
+// stick at rest: a few LSB of noise and one spike
+static const uint16_t traceRest[] = {
+  2047, 2049, 2048, 2046, 2050, 2048, 2047, 2049, 2051, 2048, 2046, 2047, 2048, 2049, 2048, 2047,
+  2048, 2050, 2049, 2047, 2046, 2048, 2049, 2048, 2047, 2048, 2631, 2049, 2048, 2046, 2047, 2049,
+  2048, 2050, 2048, 2047, 2049, 2048, 2046, 2048, 2049, 2047, 2048, 2050, 2049, 2048, 2047, 2048,
+  2046, 2048, 2049, 2047, 2048, 2050, 2048, 2047, 2049, 2048, 2047, 2048, 2049, 2046, 2048, 2049,
+};
+
+// stick moved from the center to the top with the same noise
+static const uint16_t traceMove[] = {
+  2048, 2047, 2050, 2048, 2049, 2047, 2048, 2046, 2120, 2251, 2389, 2540, 2698, 2851, 3010, 3161,
+  3302, 3439, 3561, 3672, 3770, 3851, 3917, 3968, 4004, 4026, 4040, 4046, 4049, 4047, 4050, 4048,
+  4049, 4047, 4048, 4050, 4049, 4048, 4046, 4049, 4048, 4047, 4050, 4049, 4048, 4047, 4049, 4048,
+};
+
+// the samples of one channel interleaved with 2 other channels, as written by the DMA
+template <unsigned N>
+static void fillRing(uint16_t * ring, const uint16_t * trace, unsigned stride)
+{
+  for (unsigned i = 0; i < N; i++) {
+    ring[i * stride] = trace[i];
+    ring[i * stride + 1] = 0;
+    ring[i * stride + 2] = 4095;
+  }
+}
+
+TEST(AdcFilter, medians)
+{
+  uint16_t values[5];
+  for (int test = 0; test < 10000; test++) {
+    for (int i = 0; i < 5; i++)
+      values[i] = rand() % 16;  // small range so that there are equal values
+    uint16_t sorted[5];
+    std::copy(values, values + 3, sorted);
+    std::sort(sorted, sorted + 3);
+    EXPECT_EQ(sorted[1], median3(values[0], values[1], values[2]));
+    std::copy(values, values + 5, sorted);
+    std::sort(sorted, sorted + 5);
+    EXPECT_EQ(sorted[2], median5(values[0], values[1], values[2], values[3], values[4]));
+  }
+}
+
+TEST(AdcFilter, constant)
+{
+  uint16_t ring[3 * 20];
+  uint16_t trace[20];
+  for (uint16_t value: { 0, 1, 2048, 4094, 4095 }) {
+    std::fill(trace, trace + 20, value);
+    fillRing<20>(ring, trace, 3);
+    EXPECT_EQ(value, adcFilterChannel(ring, 3, 1, 1));
+    EXPECT_EQ(value, adcFilterChannel(ring, 3, 1, 16));
+    EXPECT_EQ(value, adcFilterChannel(ring, 3, 3, 4));
+    EXPECT_EQ(value, adcFilterChannel(ring, 3, 5, 4));
+  }
+}
+
+TEST(AdcFilter, oversampling)
+{
+  uint16_t ring[3 * 4];
+  const uint16_t trace[] = { 100, 101, 101, 101 };
+  fillRing<4>(ring, trace, 3);
+  EXPECT_EQ(101, adcFilterChannel(ring, 3, 1, 4));  // 100.75 rounded
+  EXPECT_EQ(100, adcFilterChannel(ring, 3, 1, 1));
+  EXPECT_EQ(101, adcFilterChannel(ring, 3, 1, 2));  // 100.5 rounded up
+}
+
+TEST(AdcFilter, spike)
+{
+  // a window around the spike of traceRest
+  uint16_t ring[3 * 16];
+  fillRing<16>(ring, &traceRest[20], 3);
+
+  // the average lets a part of the spike through, the median removes it
+  EXPECT_GT(adcFilterChannel(ring, 3, 1, 16), 2060);
+  for (unsigned median: { 3, 5 }) {
+    for (unsigned offset = 0; offset + median <= 16; offset++) {
+      uint16_t value = adcFilterChannel(&ring[offset * 3], 3, median, 1);
+      EXPECT_GE(value, 2046);
+      EXPECT_LE(value, 2050);
+    }
+  }
+}
+
+TEST(AdcFilter, noise)
+{
+  // the windows of 4 samples of the trace at rest (spike excluded) stay closer to the center than the samples
+  uint16_t ring[3 * 4];
+  int maxSampleError = 0, maxFilteredError = 0;
+  for (unsigned offset = 0; offset + 4 <= DIM(traceRest); offset += 4) {
+    if (offset <= 26 && offset + 4 > 26)
+      continue;
+    fillRing<4>(ring, &traceRest[offset], 3);
+    for (unsigned i = 0; i < 4; i++)
+      maxSampleError = std::max(maxSampleError, abs(traceRest[offset + i] - 2048));
+    maxFilteredError = std::max(maxFilteredError, abs(adcFilterChannel(ring, 3, 1, 4) - 2048));
+  }
+  EXPECT_EQ(3, maxSampleError);
+  EXPECT_LE(maxFilteredError, 1);
+}
+
+// the previous getADC() code, before the filter was moved to analogs_filter.h
+static uint16_t jitterFilterReference(uint16_t filtered, uint16_t v, bool active)
+{
+  uint16_t previous = filtered / 16;
+  uint16_t diff = (v > previous) ? (v - previous) : (previous - v);
+  if (active && diff < (10 * 2))
+    return (filtered - previous) + v;
+  else
+    return v * 16;
+}
+
+TEST(AdcFilter, jitter)
+{
+  for (const uint16_t * trace: { traceRest, traceMove }) {
+    unsigned count = (trace == traceRest ? DIM(traceRest) : DIM(traceMove));
+    uint16_t filtered = trace[0] * 16, reference = filtered;
+    for (unsigned i = 0; i < count; i++) {
+      filtered = jitterFilter(filtered, trace[i], 16, 10 * 2);
+      reference = jitterFilterReference(reference, trace[i], true);
+      EXPECT_EQ(reference, filtered);
+    }
+  }
+
+  // a small change is smoothed, a big one goes through
+  EXPECT_EQ(2048 * 16 - 2048 + 2058, jitterFilter(2048 * 16, 2058, 16, 20));
+  EXPECT_EQ(2100 * 16, jitterFilter(2048 * 16, 2100, 16, 20));
+
+  // the stick movement is followed without delay
+  uint16_t filtered = traceMove[0] * 16;
+  for (unsigned i = 0; i < DIM(traceMove); i++) {
+    filtered = jitterFilter(filtered, traceMove[i], 16, 20);
+    EXPECT_LE(abs(filtered / 16 - traceMove[i]), 20);
+  }
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <algorithm>
+#include "gtests.h"
+#include "audio_kernels.h"
+
+#define SAMPLES_COUNT                  (AUDIO_BUFFER_SIZE + 13)
+
+// 12 bits DAC samples, 16 bits simulator samples and X12S samples
+static const uint16_t silences[] = { 0x800, 0x8000, 0 };
+
+static void randomSamples(uint16_t * samples, unsigned count, uint16_t silence)
+{
+  for (unsigned i = 0; i < count; i++) {
+    if (silence == 0x800)
+      samples[i] = rand() % 0x1000;
+    else
+      samples[i] = rand() & 0xffff;
+  }
+  // the extremes
+  samples[0] = (silence == 0x800 ? 0 : silence ^ 0x8000);
+  samples[1] = (silence == 0x800 ? 0xfff : silence ^ 0x7fff);
+}
+
+TEST(AudioKernels, fill)
+{
+  uint16_t samples[SAMPLES_COUNT + 1];
+  // all alignments and lengths, the area around is untouched
+  for (unsigned offset = 0; offset < 2; offset++) {
+    for (unsigned count = 0; offset + count <= SAMPLES_COUNT; count += (count < 40 ? 1 : 37)) {
+      for (uint16_t silence: silences) {
+        std::fill(samples, samples + DIM(samples), 0x1234);
+        audioFill(&samples[offset], count, silence);
+        for (unsigned i = 0; i < DIM(samples); i++) {
+          EXPECT_EQ((i >= offset && i < offset + count) ? silence : 0x1234, samples[i]);
+        }
+      }
+    }
+  }
+}
+
+TEST(AudioKernels, gain)
+{
+  uint16_t samples[SAMPLES_COUNT + 1];
+  uint16_t reference[SAMPLES_COUNT + 1];
+  for (uint16_t silence: silences) {
+    for (int16_t gain: { 0, 1, AUDIO_GAIN_UNIT / 23, 11 * AUDIO_GAIN_UNIT / 23, AUDIO_GAIN_UNIT - 1, AUDIO_GAIN_UNIT, 3 * AUDIO_GAIN_UNIT, AUDIO_GAIN_MAX, -AUDIO_GAIN_UNIT }) {
+      for (unsigned offset = 0; offset < 2; offset++) {
+        for (unsigned count: { 0, 1, 7, 8, 9, 31, SAMPLES_COUNT }) {
+          randomSamples(samples, DIM(samples), silence);
+          std::copy(samples, samples + DIM(samples), reference);
+          audioApplyGain(&samples[offset], count, silence, gain);
+          audioApplyGainRef(&reference[offset], count, silence, gain);
+          for (unsigned i = 0; i < DIM(samples); i++) {
+            EXPECT_EQ(reference[i], samples[i]) << "silence=" << silence << " gain=" << gain << " i=" << i;
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(AudioKernels, volume)
+{
+  // the speaker volume stays within 1 LSB of the previous (sample * volume) / VOLUME_LEVEL_MAX
+  uint16_t samples[SAMPLES_COUNT];
+  uint16_t original[SAMPLES_COUNT];
+  randomSamples(original, DIM(original), 0x800);
+  for (int volume = 0; volume < VOLUME_LEVEL_MAX; volume++) {
+    std::copy(original, original + DIM(original), samples);
+    audioApplyGain(samples, DIM(samples), 0x800, (volume * AUDIO_GAIN_UNIT) / VOLUME_LEVEL_MAX);
+    for (unsigned i = 0; i < DIM(samples); i++) {
+      int expected = ((original[i] - 0x800) * volume) / VOLUME_LEVEL_MAX + 0x800;
+      EXPECT_LE(abs(expected - samples[i]), 1);
+      EXPECT_LE(samples[i], 0xfff);
+    }
+  }
+}
+
+TEST(AudioKernels, convert)
+{
+  uint16_t samples[SAMPLES_COUNT];
+  int16_t result[SAMPLES_COUNT + 1];
+  int16_t reference[SAMPLES_COUNT + 1];
+  for (uint16_t silence: silences) {
+    unsigned shift = (silence == 0x800 ? 4 : 0);
+    for (int16_t gain: { 0, AUDIO_GAIN_UNIT / 2, AUDIO_GAIN_UNIT, 3 * AUDIO_GAIN_UNIT, AUDIO_GAIN_MAX }) {
+      for (unsigned count: { 0, 1, 8, 15, SAMPLES_COUNT }) {
+        randomSamples(samples, DIM(samples), silence);
+        std::fill(result, result + DIM(result), 0x1234);
+        std::fill(reference, reference + DIM(reference), 0x1234);
+        audioConvertS16(result, samples, count, silence, shift, gain);
+        audioConvertS16Ref(reference, samples, count, silence, shift, gain);
+        for (unsigned i = 0; i < DIM(result); i++) {
+          EXPECT_EQ(reference[i], result[i]) << "silence=" << silence << " gain=" << gain << " i=" << i;
+        }
+      }
+    }
+  }
+
+  // 12 bits to 16 bits at unity gain, the amplified extremes are saturated
+  const uint16_t dac[] = { 0, 0x7ff, 0x800, 0x801, 0xfff };
+  audioConvertS16(result, dac, DIM(dac), 0x800, 4, AUDIO_GAIN_UNIT);
+  EXPECT_EQ(-32768, result[0]);
+  EXPECT_EQ(-16, result[1]);
+  EXPECT_EQ(0, result[2]);
+  EXPECT_EQ(16, result[3]);
+  EXPECT_EQ(32752, result[4]);
+  audioConvertS16(result, dac, DIM(dac), 0x800, 4, 2 * AUDIO_GAIN_UNIT);
+  EXPECT_EQ(INT16_MIN, result[0]);
+  EXPECT_EQ(INT16_MAX, result[4]);
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "gtests.h"
+#include "bench.h"
+
+TEST(Benchmarks, registry)
+{
+  for (const Benchmark * bench = benchmarks; bench->name != nullptr; bench++) {
+    EXPECT_EQ(bench, benchFind(bench->name));
+    EXPECT_NE(nullptr, bench->run);
+  }
+  EXPECT_EQ(nullptr, benchFind("all"));
+  EXPECT_EQ(nullptr, benchFind(""));
+}
+
+// The same bodies as the CLI "bench all" command on the radio, with the same output
+TEST(Benchmarks, run)
+{
+  MODEL_RESET();
+#if defined(LUA)
+  if (!lsScripts) luaInit();
+#endif
+
+  printf("bench,name,runs,us,ns/run\n");
+  for (const Benchmark * bench = benchmarks; bench->name != nullptr; bench++) {
+    BenchmarkResult result;
+    if (benchRun(bench, 20, result)) {
+      EXPECT_GT(result.runs, 0u);
+      EXPECT_GE(result.timeUs(), 20u * 1000);
+      printf("bench,%s,%u,%u,%u\n", bench->name, result.runs, result.timeUs(), result.nsPerRun());
+      RecordProperty(bench->name, result.nsPerRun());
+    }
+    else {
+      printf("bench,%s,skipped\n", bench->name);
+    }
+  }
+}
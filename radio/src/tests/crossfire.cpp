@@ -19,6 +19,7 @@
  */
 
 #include "gtests.h"
+#include "framefifo.h"
 
 #if defined(CROSSFIRE)
 uint8_t createCrossfireChannelsFrame(uint8_t * frame, int16_t * pulses);
@@ -37,6 +38,66 @@ TEST(Crossfire, createCrossfireChannelsFrame)
   // TODO check
 }
 
+// previous implementation, bit accumulator with divisions
+static uint8_t createCrossfireChannelsFrameReference(uint8_t * frame, int16_t * pulses)
+{
+  uint8_t * buf = frame;
+  *buf++ = MODULE_ADDRESS;
+  *buf++ = 24;
+  uint8_t * crc_start = buf;
+  *buf++ = CHANNELS_ID;
+  uint32_t bits = 0;
+  uint8_t bitsavailable = 0;
+  for (int i = 0; i < CROSSFIRE_CHANNELS_COUNT; i++) {
+#if defined(PPM_CENTER_ADJUSTABLE)
+    int offset = (2 * limitAddress(i)->ppmCenter) + 1;
+#else
+    int offset = 0;
+#endif
+    uint32_t val = limit(0, 0x3E0 + (offset * 4) / 5 + (pulses[i] * 4) / 5, 2 * 0x3E0);
+    bits |= val << bitsavailable;
+    bitsavailable += 11;
+    while (bitsavailable >= 8) {
+      *buf++ = bits;
+      bits >>= 8;
+      bitsavailable -= 8;
+    }
+  }
+  *buf++ = crc8(crc_start, 23);
+  return buf - frame;
+}
+
+TEST(Crossfire, createCrossfireChannelsFrameExhaustive)
+{
+  int16_t pulses[CROSSFIRE_CHANNELS_COUNT];
+  uint8_t frame[CROSSFIRE_FRAME_MAXLEN];
+  uint8_t reference[CROSSFIRE_FRAME_MAXLEN];
+
+  MODEL_RESET();
+#if defined(PPM_CENTER_ADJUSTABLE)
+  for (int i=0; i<CROSSFIRE_CHANNELS_COUNT; i++) {
+    limitAddress(i)->ppmCenter = (i * 67) % 1000 - 500;
+  }
+#endif
+
+  // every value on every channel position, the other channels spread over the range
+  for (int32_t value = INT16_MIN; value <= INT16_MAX; value++) {
+    for (int i=0; i<CROSSFIRE_CHANNELS_COUNT; i++) {
+      pulses[i] = (i & 1) ? value : -1536 + ((value + i * 193) & 0xFFF) * 3 / 4;
+    }
+    uint8_t len = createCrossfireChannelsFrame(frame, pulses);
+    ASSERT_EQ(createCrossfireChannelsFrameReference(reference, pulses), len);
+    ASSERT_EQ(0, memcmp(frame, reference, len)) << "value " << value;
+
+    for (int i=0; i<CROSSFIRE_CHANNELS_COUNT; i++) {
+      pulses[i] = (i & 1) ? -1536 + ((value + i * 193) & 0xFFF) * 3 / 4 : value;
+    }
+    createCrossfireChannelsFrame(frame, pulses);
+    createCrossfireChannelsFrameReference(reference, pulses);
+    ASSERT_EQ(0, memcmp(frame, reference, len)) << "value " << value;
+  }
+}
+
 TEST(Crossfire, crc8)
 {
   uint8_t frame[] = { 0x00, 0x0C, 0x14, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x01, 0x03, 0x00, 0x00, 0x00, 0xF4 };
@@ -45,3 +106,134 @@ TEST(Crossfire, crc8)
 }
 #endif
 
+
+#if defined(CROSSFIRE)
+static uint8_t appendCrossfireFrame(uint8_t * stream, uint8_t id, const uint8_t * payload, uint8_t size)
+{
+  stream[0] = RADIO_ADDRESS;
+  stream[1] = size + 2;
+  stream[2] = id;
+  memcpy(&stream[3], payload, size);
+  stream[size + 3] = crc8(&stream[2], size + 1);
+  return size + 4;
+}
+
+// a telemetry stream as a CRSF receiver sends it, with some noise between the frames
+static uint32_t createCrossfireStream(uint8_t * stream)
+{
+  const uint8_t battery[] = { 0x00, 0x6F, 0x00, 0x0C, 0x00, 0x01, 0x2C, 0x55 };
+  const uint8_t batteryBad[] = { 0x03, 0xE7, 0x00, 0x0C, 0x00, 0x01, 0x2C, 0x55 };
+  const uint8_t attitude[] = { 0x01, 0x00, 0xFF, 0x00, 0x00, 0x10 };
+  const uint8_t vario[] = { 0x00, 0x2A };
+  const uint8_t flightMode[] = { 'A', 'C', 'R', 'O', 0x00 };
+  uint8_t parameters[70];  // longer than a DMA buffer
+  for (unsigned i = 0; i < sizeof(parameters); i++) {
+    parameters[i] = i;
+  }
+
+  uint32_t len = 0;
+  stream[len++] = 0x00;
+  stream[len++] = RADIO_ADDRESS;
+  stream[len++] = 0xFF;  // length out of range
+  len += appendCrossfireFrame(&stream[len], BATTERY_ID, battery, sizeof(battery));
+  uint32_t bad = len;
+  len += appendCrossfireFrame(&stream[len], BATTERY_ID, batteryBad, sizeof(batteryBad));
+  stream[bad + 5] ^= 0x01;  // CRC error
+  len += appendCrossfireFrame(&stream[len], ATTITUDE_ID, attitude, sizeof(attitude));
+  stream[len++] = 0x55;
+  len += appendCrossfireFrame(&stream[len], CF_VARIO_ID, vario, sizeof(vario));
+  len += appendCrossfireFrame(&stream[len], 0x2B, parameters, sizeof(parameters));
+  len += appendCrossfireFrame(&stream[len], FLIGHT_MODE_ID, flightMode, sizeof(flightMode));
+  return len;
+}
+
+static void resetCrossfireTelemetry()
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryRxBufferCount = 0;
+  allowNewSensors = true;
+}
+
+// byte by byte parsing as reference
+static void getCrossfireReference(const uint8_t * stream, uint32_t len, int32_t * reference)
+{
+  resetCrossfireTelemetry();
+  for (uint32_t i = 0; i < len; i++) {
+    processCrossfireTelemetryData(stream[i]);
+  }
+  for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+    reference[i] = telemetryItems[i].value;
+  }
+}
+
+TEST(Crossfire, telemetryChunks)
+{
+  uint8_t stream[256];
+  uint32_t len = createCrossfireStream(stream);
+  int32_t reference[MAX_TELEMETRY_SENSORS];
+
+  getCrossfireReference(stream, len, reference);
+  EXPECT_EQ(BATTERY_ID, g_model.telemetrySensors[0].id);
+  EXPECT_EQ(0x6F, reference[0]);  // the frame with a CRC error was dropped
+  EXPECT_EQ(8, lastUsedTelemetryIndex());  // battery (4), attitude (3), vario and flight mode sensors
+
+  // every split of the stream in 3 chunks, the frames split between 2 chunks are reassembled
+  for (uint32_t first = 0; first <= len; first++) {
+    for (uint32_t second = first; second <= len; second++) {
+      resetCrossfireTelemetry();
+      processCrossfireTelemetryChunk(stream, first);
+      processCrossfireTelemetryChunk(stream + first, second - first);
+      processCrossfireTelemetryChunk(stream + second, len - second);
+      for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+        ASSERT_EQ(reference[i], telemetryItems[i].value) << "sensor " << i << " chunks " << first << " " << second;
+      }
+      ASSERT_EQ(0, telemetryRxBufferCount);
+    }
+  }
+}
+
+// the reception of the i6X: a DMA buffer is committed when the line goes idle and when it is
+// full (burst without idle gap), the telemetry task parses the committed buffers later
+TEST(Crossfire, telemetryDmaBuffers)
+{
+  const uint32_t bufferSize = 64;
+  uint8_t stream[256];
+  uint32_t len = createCrossfireStream(stream);
+  int32_t reference[MAX_TELEMETRY_SENSORS];
+
+  getCrossfireReference(stream, len, reference);
+
+  // idle line after each gap bytes (never with len), the task reads after each reads commits
+  for (uint32_t gap: { 1u, 5u, bufferSize - 1, bufferSize, bufferSize + 1, len }) {
+    for (uint32_t reads: { 1u, 3u }) {
+      FrameFifo<4, bufferSize> fifo;
+      uint8_t * buffer = fifo.writeBuffer();
+      uint32_t count = 0;
+      uint32_t commits = 0;
+      resetCrossfireTelemetry();
+      for (uint32_t i = 0; i < len; i++) {
+        buffer[count++] = stream[i];
+        bool full = (count == bufferSize);
+        bool idle = ((i + 1) % gap == 0 || i == len - 1);
+        if (full || idle) {
+          buffer = fifo.commit(count);
+          count = 0;
+          if (++commits % reads == 0 || i == len - 1) {
+            const uint8_t * frame;
+            uint32_t frameLen;
+            while (fifo.peek(frame, frameLen)) {
+              processCrossfireTelemetryChunk(frame, frameLen);
+              fifo.pop();
+            }
+          }
+        }
+      }
+      ASSERT_EQ(0u, fifo.getOverruns()) << "gap " << gap << " reads " << reads;
+      for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+        ASSERT_EQ(reference[i], telemetryItems[i].value) << "sensor " << i << " gap " << gap << " reads " << reads;
+      }
+    }
+  }
+}
+#endif
@@ -92,6 +92,147 @@ TEST(Eeprom, test2)
   EXPECT_EQ(sz, 300);
 }
 
+TEST(Eeprom, segments)
+{
+  eepromFile = NULL; // in memory
+  RlcFile f;
+  uint8_t buf[1000];
+  uint8_t buf2[1000];
+  RlcSegment segments[8];
+
+  storageFormat();
+
+  for (int i=0; i<50; i++) {
+    int size = 0;
+    for (unsigned s=0; s<DIM(segments); s++) {
+      int len = rand() % 100;
+      bool zeroes = (rand() % 3 == 0);
+      segments[s].buf = zeroes ? nullptr : &buf[size];
+      segments[s].len = len;
+      for (int j=0; j<len; j++) {
+        buf[size+j] = zeroes || rand() % 4 == 0 ? 0 : rand();
+      }
+      size += len;
+    }
+    f.writeRlc(5, 5, segments, DIM(segments), 100);
+    f.openRd(5);
+    uint16_t n = f.readRlc(buf2, size+1);
+    EXPECT_EQ(n, size);
+    EXPECT_EQ(memcmp(buf, buf2, size), 0);
+  }
+}
+
+TEST(Eeprom, modelLists)
+{
+  eepromFile = NULL; // in memory
+  storageFormat();
+  MODEL_RESET();
+
+  for (uint8_t i=0; i<3; i++) {
+    ExpoData * expo = insertExpoData(i);
+    expo->srcRaw = MIXSRC_Rud + i;
+    expo->chn = i;
+    expo->weight = 50 + i;
+    expo->mode = 3;
+  }
+  for (uint8_t i=0; i<5; i++) {
+    MixData * mix = insertMixData(0);
+    mix->destCh = i;
+    mix->srcRaw = MIXSRC_Rud + i;
+    mix->weight = 10 * i + 1;
+  }
+  deleteMixData(1);
+  deleteExpoData(0);
+
+  storageDirty(EE_MODEL);
+  storageCheck(true);
+  MODEL_RESET();
+  EXPECT_EQ(MODEL_DATA_SIZE, eeLoadModelData(g_eeGeneral.currModel));
+
+  const uint8_t mixes[] = { 4, 2, 1, 0 };
+  for (uint8_t i=0; i<DIM(mixes); i++) {
+    EXPECT_EQ(mixes[i], mixAddress(i)->destCh);
+    EXPECT_EQ(MIXSRC_Rud + mixes[i], mixAddress(i)->srcRaw);
+    EXPECT_EQ(10 * mixes[i] + 1, mixAddress(i)->weight);
+  }
+  EXPECT_EQ(0, mixAddress(DIM(mixes))->srcRaw);
+
+  for (uint8_t i=0; i<2; i++) {
+    EXPECT_EQ(i + 1, expoAddress(i)->chn);
+    EXPECT_EQ(51 + i, expoAddress(i)->weight);
+  }
+  EXPECT_FALSE(EXPO_VALID(expoAddress(2)));
+
+  clearMixData();
+  EXPECT_EQ(0, mixAddress(0)->srcRaw);
+  EXPECT_EQ(1, expoAddress(0)->chn);
+  EXPECT_TRUE(hasFreeMix());
+  EXPECT_TRUE(hasFreeExpo());
+}
+
+TEST(Eeprom, modelListsFull)
+{
+  MODEL_RESET();
+
+  while (hasFreeMix()) {
+    MixData * mix = insertMixData(0);
+    ASSERT_NE(nullptr, mix);
+    mix->destCh = 5;
+    mix->srcRaw = MIXSRC_MAX;
+    mix->weight = 50;
+  }
+#if defined(MODEL_ARENA)
+  EXPECT_EQ(nullptr, insertMixData(0));
+#endif
+
+  // the template lines which do not fit are skipped
+  applyDefaultTemplate();
+  EXPECT_FALSE(hasFreeMix());
+  for (uint8_t i=0; i<NUM_STICKS; i++) {
+    EXPECT_EQ(i, expoAddress(i)->chn);
+    EXPECT_EQ(100, expoAddress(i)->weight);
+  }
+#if defined(MODEL_ARENA)
+  EXPECT_EQ(5, mixAddress(0)->destCh);
+#endif
+}
+
+#if defined(MODEL_ARENA)
+TEST(Eeprom, modelArenaOverflow)
+{
+  if (MODEL_ARENA_SIZE >= MAX_MIXERS * sizeof(MixData))
+    return;
+
+  eepromFile = NULL; // in memory
+  storageFormat();
+  MODEL_RESET();
+
+  // a model saved with all the mixes, which do not fit in the arena
+  static uint8_t buf[MODEL_DATA_SIZE];
+  memset(buf, 0, sizeof(buf));
+  for (uint8_t i=0; i<MAX_MIXERS; i++) {
+    buf[offsetof(ModelData, arena) + i * sizeof(MixData)] = i + 1;
+  }
+  theFile.writeRlc(FILE_MODEL(0), FILE_TYP_MODEL, buf, sizeof(buf), true);
+
+  g_eeGeneral.currModel = 0;
+  eeLoadModelData(0);
+  EXPECT_TRUE(eeModelArenaOverflow());
+
+  // the stored model is kept
+  storageDirty(EE_MODEL);
+  storageCheck(true);
+  static uint8_t buf2[MODEL_DATA_SIZE];
+  theFile.openRlc(FILE_MODEL(0));
+  EXPECT_EQ(sizeof(buf), theFile.readRlc(buf2, sizeof(buf2)));
+  EXPECT_EQ(0, memcmp(buf, buf2, sizeof(buf)));
+
+  // a model which fits is written again
+  eeLoadModelData(1);
+  EXPECT_FALSE(eeModelArenaOverflow());
+}
+#endif
+
 TEST(Eeprom, storageCheckImmediately)
 {
   eepromFile = NULL; // in memory
@@ -395,6 +395,65 @@ TEST(FrSkySPORT, frskySetCellVoltageTwoSensors)
 #endif
 }
 
+TEST(FrSkySPORT, calculatedSensorsChain)
+{
+  uint8_t packet[FRSKY_SPORT_PACKET_SIZE];
+
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  allowNewSensors = true;
+
+  //sensor 1: 3 cell battery
+  generateSportCellPacket(packet, 3, 0, _V(418), _V(416)); sportProcessTelemetryPacket(packet);
+  generateSportCellPacket(packet, 3, 2, _V(415), _V(  0)); sportProcessTelemetryPacket(packet);
+
+  //sensor 3: lowest cell of sensor 1
+  g_model.telemetrySensors[2].type = TELEM_TYPE_CALCULATED;
+  g_model.telemetrySensors[2].formula = TELEM_FORMULA_CELL;
+  g_model.telemetrySensors[2].unit = UNIT_VOLTS;
+  g_model.telemetrySensors[2].prec = 2;
+  g_model.telemetrySensors[2].cell.source = 1;
+  g_model.telemetrySensors[2].cell.index = TELEM_CELL_INDEX_LOWEST;
+
+  //sensor 2: depends on sensor 3, which comes after it
+  g_model.telemetrySensors[1].type = TELEM_TYPE_CALCULATED;
+  g_model.telemetrySensors[1].formula = TELEM_FORMULA_ADD;
+  g_model.telemetrySensors[1].unit = UNIT_VOLTS;
+  g_model.telemetrySensors[1].prec = 2;
+  g_model.telemetrySensors[1].calc.sources[0] = 3;
+  calculatedSensorsChanged();
+
+  telemetryWakeup();
+
+  EXPECT_EQ(telemetryItems[2].value, 415);
+  EXPECT_EQ(telemetryItems[1].value, 415);
+
+  //the whole chain follows a new value in the same wakeup
+  generateSportCellPacket(packet, 3, 2, _V(405), _V(  0)); sportProcessTelemetryPacket(packet);
+  telemetryWakeup();
+
+  EXPECT_EQ(telemetryItems[2].value, 405);
+  EXPECT_EQ(telemetryItems[1].value, 405);
+  EXPECT_EQ(telemetryItems[1].valueMin, 405);
+  EXPECT_EQ(telemetryItems[1].valueMax, 415);
+
+  //a source written after storageDirty(), the order was built in between
+  storageDirty(EE_MODEL);
+  telemetryWakeup();
+  g_model.telemetrySensors[1].calc.sources[0] = 1;
+  checkStorageChanges();
+  telemetryWakeup();
+
+  EXPECT_NE(telemetryItems[1].value, 405);
+
+  //and the loss of the source
+  telemetryItems[0].setOld();
+  telemetryWakeup();
+
+  EXPECT_TRUE(telemetryItems[2].isOld());
+  EXPECT_TRUE(telemetryItems[1].isOld());
+}
+
 void generateSportFasVoltagePacket(uint8_t * packet, uint32_t voltage)
 {
   packet[0] = 0x22; //DATA_ID_FAS
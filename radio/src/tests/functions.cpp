@@ -38,6 +38,7 @@ TEST_F(SpecialFunctionsTest, FlightReset)
   g_model.customFn[0].func = FUNC_RESET;
   g_model.customFn[0].all.val = FUNC_RESET_FLIGHT;
   g_model.customFn[0].active = true;
+  storageDirty(EE_MODEL);
 
   mainRequestFlags = 0;
   simuSetSwitch(0, 0);
@@ -68,6 +69,7 @@ TEST_F(SpecialFunctionsTest, GvarsInc)
   g_model.customFn[0].all.param = 0; // GV1
   g_model.customFn[0].all.val = -1;   // inc/dec value
   g_model.customFn[0].active = true;
+  storageDirty(EE_MODEL);
 
   g_model.flightModeData[0].gvars[0] = 10;  // GV1 = 10;
   evalFunctions(g_model.customFn, modelFunctionsContext);
@@ -114,5 +116,245 @@ TEST_F(SpecialFunctionsTest, GvarsInc)
 }
 #endif // #if defined(GVARS)
 
+#if defined(GVARS) && defined(OVERRIDE_CHANNEL_FUNCTION)
+// the previous evalFunctions(), which read the switch of all the functions at each
+// evaluation, limited to the functions used in EdgeDrivenEvaluation
+static void evalFunctionsReference(const CustomFunctionData * functions, CustomFunctionsContext & functionsContext)
+{
+  MASK_FUNC_TYPE newActiveFunctions  = 0;
+  MASK_CFN_TYPE  newActiveSwitches = 0;
+
+  for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++) {
+    safetyCh[i] = OVERRIDE_CHANNEL_UNDEFINED;
+  }
+
+  for (uint8_t i=0; i<NUM_TRIMS; i++) {
+    trimGvar[i] = -1;
+  }
+
+  for (uint8_t i=0; i<MAX_SPECIAL_FUNCTIONS; i++) {
+    const CustomFunctionData * cfn = &functions[i];
+    swsrc_t swtch = CFN_SWITCH(cfn);
+    if (swtch) {
+      MASK_CFN_TYPE switch_mask = ((MASK_CFN_TYPE)1 << i);
+
+      bool active = getSwitch(swtch, IS_PLAY_FUNC(CFN_FUNC(cfn)) ? GETSWITCH_MIDPOS_DELAY : 0);
+
+      if (HAS_ENABLE_PARAM(CFN_FUNC(cfn))) {
+        active &= (bool)CFN_ACTIVE(cfn);
+      }
+
+      if (active) {
+        switch (CFN_FUNC(cfn)) {
+          case FUNC_OVERRIDE_CHANNEL:
+            safetyCh[CFN_CH_INDEX(cfn)] = CFN_PARAM(cfn);
+            break;
+
+          case FUNC_TRAINER:
+          {
+            uint8_t mask = 0x0f;
+            if (CFN_CH_INDEX(cfn) > 0) {
+              mask = (1<<(CFN_CH_INDEX(cfn)-1));
+            }
+            newActiveFunctions |= mask;
+            break;
+          }
+
+          case FUNC_RESET:
+            switch (CFN_PARAM(cfn)) {
+              case FUNC_RESET_TIMER1:
+              case FUNC_RESET_TIMER2:
+              case FUNC_RESET_TIMER3:
+                timerReset(CFN_PARAM(cfn));
+                break;
+              case FUNC_RESET_FLIGHT:
+                if (!(functionsContext.activeSwitches & switch_mask)) {
+                  mainRequestFlags |= (1 << REQUEST_FLIGHT_RESET);
+                }
+                break;
+            }
+            break;
+
+          case FUNC_SET_TIMER:
+            timerSet(CFN_TIMER_INDEX(cfn), CFN_PARAM(cfn));
+            break;
+
+          case FUNC_ADJUST_GVAR:
+            if (CFN_GVAR_MODE(cfn) == FUNC_ADJUST_GVAR_CONSTANT) {
+              SET_GVAR(CFN_GVAR_INDEX(cfn), CFN_PARAM(cfn), mixerCurrentFlightMode);
+            }
+            else if (CFN_GVAR_MODE(cfn) == FUNC_ADJUST_GVAR_GVAR) {
+              SET_GVAR(CFN_GVAR_INDEX(cfn), GVAR_VALUE(CFN_PARAM(cfn), getGVarFlightMode(mixerCurrentFlightMode, CFN_PARAM(cfn))), mixerCurrentFlightMode);
+            }
+            else if (CFN_GVAR_MODE(cfn) == FUNC_ADJUST_GVAR_INCDEC) {
+              if (!(functionsContext.activeSwitches & switch_mask)) {
+                SET_GVAR(CFN_GVAR_INDEX(cfn), limit<int16_t>(MODEL_GVAR_MIN(CFN_GVAR_INDEX(cfn)), GVAR_VALUE(CFN_GVAR_INDEX(cfn), getGVarFlightMode(mixerCurrentFlightMode, CFN_GVAR_INDEX(cfn))) + CFN_PARAM(cfn), MODEL_GVAR_MAX(CFN_GVAR_INDEX(cfn))), mixerCurrentFlightMode);
+              }
+            }
+            else if (CFN_PARAM(cfn) >= MIXSRC_FIRST_TRIM && CFN_PARAM(cfn) <= MIXSRC_LAST_TRIM) {
+              trimGvar[CFN_PARAM(cfn)-MIXSRC_FIRST_TRIM] = CFN_GVAR_INDEX(cfn);
+            }
+            else {
+              SET_GVAR(CFN_GVAR_INDEX(cfn), limit<int16_t>(MODEL_GVAR_MIN(CFN_GVAR_INDEX(cfn)), calcRESXto100(getValue(CFN_PARAM(cfn))), MODEL_GVAR_MAX(CFN_GVAR_INDEX(cfn))), mixerCurrentFlightMode);
+            }
+            break;
+
+          case FUNC_BACKLIGHT:
+          {
+            newActiveFunctions |= (1u << FUNCTION_BACKLIGHT);
+            if (!CFN_PARAM(cfn)) {
+              requiredBacklightBright = BACKLIGHT_FORCED_ON;
+              break;
+            }
+            getvalue_t raw = getValue(CFN_PARAM(cfn));
+            requiredBacklightBright = (1024 - raw) * 100 / 2048;
+            break;
+          }
+        }
+
+        newActiveSwitches |= switch_mask;
+      }
+      else {
+        functionsContext.lastFunctionTime[i] = 0;
+      }
+    }
+  }
+
+  functionsContext.activeSwitches   = newActiveSwitches;
+  functionsContext.activeFunctions  = newActiveFunctions;
+}
+
+struct FunctionsOutputs {
+  ModelData model;
+  TimerState timers[TIMERS];
+  safetych_t safetyCh[MAX_OUTPUT_CHANNELS];
+  int8_t trimGvar[NUM_TRIMS];
+  uint8_t mainRequestFlags;
+  uint8_t requiredBacklightBright;
+
+  void save()
+  {
+    memcpy(&model, &g_model, sizeof(model));
+    memcpy(timers, timersStates, sizeof(timers));
+    memcpy(this->safetyCh, ::safetyCh, sizeof(this->safetyCh));
+    memcpy(this->trimGvar, ::trimGvar, sizeof(this->trimGvar));
+    this->mainRequestFlags = ::mainRequestFlags;
+    this->requiredBacklightBright = ::requiredBacklightBright;
+  }
+
+  void restore() const
+  {
+    memcpy(&g_model, &model, sizeof(model));
+    memcpy(timersStates, timers, sizeof(timers));
+    memcpy(::safetyCh, this->safetyCh, sizeof(this->safetyCh));
+    memcpy(::trimGvar, this->trimGvar, sizeof(this->trimGvar));
+    ::mainRequestFlags = this->mainRequestFlags;
+    ::requiredBacklightBright = this->requiredBacklightBright;
+  }
+};
+
+TEST_F(SpecialFunctionsTest, EdgeDrivenEvaluation)
+{
+  static const uint8_t funcs[] = { FUNC_OVERRIDE_CHANNEL, FUNC_TRAINER, FUNC_RESET, FUNC_SET_TIMER, FUNC_ADJUST_GVAR, FUNC_BACKLIGHT };
+  static const swsrc_t switches[] = { SWSRC_NONE, SWSRC_SA0, SWSRC_SA1, SWSRC_SA2, -SWSRC_SA2, SWSRC_SB0, SWSRC_SB2, SWSRC_ON };
+  static FunctionsOutputs before, expected, result;
+  CustomFunctionsContext referenceContext;
+
+  srand(0x5F);
+
+  for (int test=0; test<20; test++) {
+    memclear(g_model.customFn, sizeof(g_model.customFn));
+    for (int i=0; i<MAX_SPECIAL_FUNCTIONS; i++) {
+      CustomFunctionData * cfn = &g_model.customFn[i];
+      cfn->swtch = switches[rand() % DIM(switches)];
+      cfn->func = funcs[rand() % DIM(funcs)];
+      cfn->active = rand() % 4 != 0;
+      switch (cfn->func) {
+        case FUNC_OVERRIDE_CHANNEL:
+          cfn->all.param = rand() % MAX_OUTPUT_CHANNELS;
+          cfn->all.val = rand() % 201 - 100;
+          break;
+        case FUNC_TRAINER:
+          cfn->all.param = rand() % 5;
+          break;
+        case FUNC_RESET:
+          cfn->all.val = rand() % 2 ? FUNC_RESET_TIMER1 + rand() % TIMERS : FUNC_RESET_FLIGHT;
+          break;
+        case FUNC_SET_TIMER:
+          cfn->all.param = rand() % TIMERS;
+          cfn->all.val = rand() % 600;
+          break;
+        case FUNC_ADJUST_GVAR:
+          cfn->all.param = rand() % MAX_GVARS;
+          cfn->all.mode = rand() % 4;
+          if (cfn->all.mode == FUNC_ADJUST_GVAR_GVAR)
+            cfn->all.val = rand() % MAX_GVARS;
+          else if (cfn->all.mode == FUNC_ADJUST_GVAR_SOURCE)
+            cfn->all.val = rand() % 2 ? MIXSRC_FIRST_TRIM + rand() % NUM_TRIMS : MIXSRC_Rud;
+          else
+            cfn->all.val = rand() % 21 - 10;
+          break;
+        case FUNC_BACKLIGHT:
+          cfn->all.val = rand() % 2 ? MIXSRC_Rud : 0;
+          break;
+      }
+    }
+    storageDirty(EE_MODEL);
+    modelFunctionsContext.reset();
+    referenceContext.reset();
+
+    for (int tick=0; tick<50; tick++) {
+      simuSetSwitch(0, rand() % 3 - 1);
+      simuSetSwitch(1, rand() % 3 - 1);
+      anaInValues[0] = rand() % 2048;
+      if (rand() % 4 == 0) {
+        // written after storageDirty(), the index may be built in between
+        g_model.customFn[rand() % MAX_SPECIAL_FUNCTIONS].swtch = switches[rand() % DIM(switches)];
+      }
+
+      before.save();
+      evalFunctionsReference(g_model.customFn, referenceContext);
+      expected.save();
+      before.restore();
+      evalFunctions(g_model.customFn, modelFunctionsContext);
+      result.save();
+
+      EXPECT_EQ(0, memcmp(&expected, &result, sizeof(result))) << "test=" << test << " tick=" << tick;
+      EXPECT_EQ(referenceContext.activeSwitches, modelFunctionsContext.activeSwitches);
+      EXPECT_EQ(referenceContext.activeFunctions, modelFunctionsContext.activeFunctions);
+      EXPECT_EQ(0, memcmp(referenceContext.lastFunctionTime, modelFunctionsContext.lastFunctionTime, sizeof(referenceContext.lastFunctionTime)));
+    }
+  }
+}
+#endif // #if defined(GVARS) && defined(OVERRIDE_CHANNEL_FUNCTION)
+
+#if defined(OVERRIDE_CHANNEL_FUNCTION)
+TEST_F(SpecialFunctionsTest, SwitchWrittenAfterStorageDirty)
+{
+  CustomFunctionData * cfn = &g_model.customFn[0];
+  cfn->swtch = SWSRC_SA0;
+  cfn->func = FUNC_OVERRIDE_CHANNEL;
+  cfn->all.param = 0;
+  cfn->all.val = -100;
+  cfn->active = true;
+  storageDirty(EE_MODEL);
+
+  simuSetSwitch(0, 1);  // SA2
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(OVERRIDE_CHANNEL_UNDEFINED, safetyCh[0]);
+
+  // the menus call storageDirty() before the write, the index was built with the old switch
+  storageDirty(EE_MODEL);
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  cfn->swtch = SWSRC_SA2;
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(-100, safetyCh[0]);
+
+  cfn->swtch = SWSRC_NONE;
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(OVERRIDE_CHANNEL_UNDEFINED, safetyCh[0]);
+}
+#endif
+
 #endif // #if defined(PCBTARANIS) || defined(PCBHORUS)
 
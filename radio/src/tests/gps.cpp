@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+
+#if defined(INTERNAL_GPS)
+
+// NAV-PVT (u-blox 8): 3D fix, 12 satellites, 46.5195660N 6.5661850E, 455.123m MSL,
+// 5.4m/s, heading 273.45deg, 2020-06-14 12:34:56 UTC
+static const uint8_t navPvtFix[] = {
+  0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x00, 0xCA, 0x5B, 0x07, 0xE4, 0x07, 0x06, 0x0E, 0x0C, 0x22,
+  0x38, 0x07, 0x32, 0x00, 0x00, 0x00, 0xC7, 0xCF, 0xFF, 0xFF, 0x03, 0x01, 0x0A, 0x0C, 0x9A, 0xEB,
+  0xE9, 0x03, 0x8C, 0x52, 0xBA, 0x1B, 0x6B, 0xA9, 0x07, 0x00, 0xD3, 0xF1, 0x06, 0x00, 0xDC, 0x05,
+  0x00, 0x00, 0xC4, 0x09, 0x00, 0x00, 0xB8, 0x0B, 0x00, 0x00, 0x60, 0xF0, 0xFF, 0xFF, 0x64, 0x00,
+  0x00, 0x00, 0x18, 0x15, 0x00, 0x00, 0x68, 0x40, 0xA1, 0x01, 0x90, 0x01, 0x00, 0x00, 0xF0, 0x49,
+  0x02, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0xC3, 0x80,
+};
+
+// NAV-PVT (u-blox 8): no fix, 3 satellites, date and time not valid
+static const uint8_t navPvtNoFix[] = {
+  0xB5, 0x62, 0x01, 0x07, 0x5C, 0x00, 0x00, 0xCA, 0x5B, 0x07, 0xE4, 0x07, 0x06, 0x0E, 0x0C, 0x22,
+  0x38, 0x00, 0x32, 0x00, 0x00, 0x00, 0xC7, 0xCF, 0xFF, 0xFF, 0x00, 0x00, 0x0A, 0x03, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x98, 0xB7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xDC, 0x05,
+  0x00, 0x00, 0xC4, 0x09, 0x00, 0x00, 0xB8, 0x0B, 0x00, 0x00, 0x60, 0xF0, 0xFF, 0xFF, 0x64, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x90, 0x01, 0x00, 0x00, 0xF0, 0x49,
+  0x02, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x7E, 0xB5,
+};
+
+// the same position as navPvtFix, as sent by the receiver before it is switched to UBX
+static const char nmeaGGA[] = "$GPGGA,123456.00,4631.17396,N,00633.97110,E,1,08,1.01,455.1,M,47.0,M,,*57\r\n";
+static const char nmeaRMC[] = "$GPRMC,123456.00,A,4631.17396,N,00633.97110,E,10.500,273.45,140620,,,A*59\r\n";
+
+static void gpsFeed(const uint8_t * data, unsigned length)
+{
+  for (unsigned i = 0; i < length; i++) {
+    gpsNewData(data[i]);
+  }
+}
+
+static void gpsFeed(const char * sentence)
+{
+  gpsFeed((const uint8_t *)sentence, strlen(sentence));
+}
+
+class GpsTest : public OpenTxTest
+{
+  protected:
+    void SetUp() override
+    {
+      OpenTxTest::SetUp();
+      memclear(&gpsData, sizeof(gpsData));
+      gpsProtocol = GPS_PROTOCOL_NMEA;
+    }
+};
+
+TEST_F(GpsTest, NmeaFrames)
+{
+  gpsFeed(nmeaGGA);
+  gpsFeed(nmeaRMC);
+  EXPECT_EQ(GPS_PROTOCOL_NMEA, gpsProtocol);
+  EXPECT_EQ(2u, gpsData.packetCount);
+  EXPECT_EQ(1, gpsData.fix);
+  EXPECT_EQ(8, gpsData.numSat);
+  EXPECT_EQ(46519565, gpsData.latitude);
+  EXPECT_EQ(6566185, gpsData.longitude);
+  EXPECT_EQ(455, gpsData.altitude);
+  EXPECT_EQ(540, gpsData.speed);
+  EXPECT_EQ(2734, gpsData.groundCourse);
+}
+
+TEST_F(GpsTest, UbxNavPvt)
+{
+  gpsFeed(navPvtFix, sizeof(navPvtFix));
+  EXPECT_EQ(GPS_PROTOCOL_UBX, gpsProtocol);
+  EXPECT_EQ(1u, gpsData.packetCount);
+  EXPECT_EQ(0u, gpsData.errorCount);
+  EXPECT_EQ(1, gpsData.fix);
+  EXPECT_EQ(12, gpsData.numSat);
+  // the same units (and nearly the same values) as the NMEA parser
+  EXPECT_EQ(46519566, gpsData.latitude);
+  EXPECT_EQ(6566185, gpsData.longitude);
+  EXPECT_EQ(455, gpsData.altitude);
+  EXPECT_EQ(540, gpsData.speed);
+  EXPECT_EQ(2734, gpsData.groundCourse);
+
+  // the position is kept when the fix is lost
+  gpsFeed(navPvtNoFix, sizeof(navPvtNoFix));
+  EXPECT_EQ(2u, gpsData.packetCount);
+  EXPECT_EQ(0, gpsData.fix);
+  EXPECT_EQ(3, gpsData.numSat);
+  EXPECT_EQ(46519566, gpsData.latitude);
+  EXPECT_EQ(6566185, gpsData.longitude);
+}
+
+TEST_F(GpsTest, UbxChecksum)
+{
+  uint8_t frame[sizeof(navPvtFix)];
+  memcpy(frame, navPvtFix, sizeof(frame));
+  frame[30] ^= 0x01;  // longitude
+  gpsFeed(frame, sizeof(frame));
+  EXPECT_EQ(GPS_PROTOCOL_NMEA, gpsProtocol);
+  EXPECT_EQ(0u, gpsData.packetCount);
+  EXPECT_EQ(1u, gpsData.errorCount);
+  EXPECT_EQ(0, gpsData.longitude);
+
+  // the parser resynchronizes on the next frame
+  gpsFeed(navPvtFix, sizeof(navPvtFix));
+  EXPECT_EQ(1u, gpsData.packetCount);
+  EXPECT_EQ(6566185, gpsData.longitude);
+}
+
+TEST_F(GpsTest, UbxLength)
+{
+  // a length bigger than the buffer is rejected before the payload
+  uint8_t frame[sizeof(navPvtFix)];
+  memcpy(frame, navPvtFix, sizeof(frame));
+  frame[5] = 0xFF;
+  gpsFeed(frame, sizeof(frame));
+  EXPECT_EQ(0u, gpsData.packetCount);
+  EXPECT_EQ(1u, gpsData.errorCount);
+  EXPECT_EQ(0, gpsData.longitude);
+
+  gpsFeed(navPvtFix, sizeof(navPvtFix));
+  EXPECT_EQ(1u, gpsData.packetCount);
+  EXPECT_EQ(6566185, gpsData.longitude);
+}
+
+TEST_F(GpsTest, MixedStream)
+{
+  // the receiver switches to UBX in the middle of its NMEA output, a byte at a time
+  std::string stream = std::string(nmeaGGA) + std::string(nmeaRMC, 20);
+  stream.append((const char *)navPvtNoFix, sizeof(navPvtNoFix));
+  stream.append(nmeaGGA);
+  stream.append((const char *)navPvtFix, sizeof(navPvtFix));
+  stream.append(nmeaRMC);
+
+  gpsData.latitude = 0;
+  for (unsigned i = 0; i < stream.size(); i++) {
+    gpsNewData(stream[i]);
+    if (i == strlen(nmeaGGA) - 1) {
+      EXPECT_EQ(46519565, gpsData.latitude);
+    }
+  }
+
+  // the NMEA sentences received once in UBX don't overwrite the NAV-PVT data
+  EXPECT_EQ(GPS_PROTOCOL_UBX, gpsProtocol);
+  EXPECT_EQ(0u, gpsData.errorCount);
+  EXPECT_EQ(12, gpsData.numSat);
+  EXPECT_EQ(46519566, gpsData.latitude);
+}
+
+TEST_F(GpsTest, NmeaFallback)
+{
+  g_tmr10ms = 1000;
+  gpsFeed(navPvtFix, sizeof(navPvtFix));
+  EXPECT_EQ(GPS_PROTOCOL_UBX, gpsProtocol);
+
+  g_tmr10ms += 100;
+  gpsWakeup();
+  EXPECT_EQ(GPS_PROTOCOL_UBX, gpsProtocol);
+
+  // no NAV-PVT anymore (receiver power cycled), back to NMEA
+  g_tmr10ms += 200;
+  gpsWakeup();
+  EXPECT_EQ(GPS_PROTOCOL_NMEA, gpsProtocol);
+  EXPECT_EQ(0, gpsData.fix);
+
+  gpsFeed(nmeaGGA);
+  EXPECT_EQ(1, gpsData.fix);
+  EXPECT_EQ(8, gpsData.numSat);
+  EXPECT_EQ(46519565, gpsData.latitude);
+}
+
+#endif // defined(INTERNAL_GPS)
@@ -58,6 +58,8 @@ inline void MODEL_RESET()
 {
   memset(&g_model, 0, sizeof(g_model));
   memset(&anaInValues, 0, sizeof(anaInValues));
+  limitsChanged();
+  calculatedSensorsChanged();
   extern uint8_t s_mixer_first_run_done;
   s_mixer_first_run_done = false;
   evalMixes(1);  // this is needed to reset fp_act
@@ -76,6 +78,17 @@ inline void MIXER_RESET()
   logicalSwitchesReset();
 }
 
+// the mix line idx to write, with MODEL_ARENA the lines up to idx are inserted first
+inline MixData * testMixAddress(uint8_t idx)
+{
+#if defined(MODEL_ARENA)
+  while (g_model.arena.mixesCount <= idx) {
+    insertMixData(g_model.arena.mixesCount);
+  }
+#endif
+  return mixAddress(idx);
+}
+
 inline void TELEMETRY_RESET()
 {
 #if defined(TELEMETRY_FRSKY)
@@ -175,4 +175,72 @@ TEST(Lcd_480x272, fonts)
 }
 
 
+// same encoding as util/img2lbm.py
+static unsigned rleEncode(uint8_t * out, const uint8_t * data, unsigned size)
+{
+  uint8_t * p = out;
+  int prev = -1;
+  bool sequence = false;
+  uint8_t count = 0;
+  for (unsigned i = 0; i < size; i++) {
+    uint8_t value = data[i];
+    if (!sequence) {
+      *p++ = value;
+      if (value == prev) {
+        sequence = true;
+        count = 0;
+      }
+      else {
+        prev = value;
+      }
+    }
+    else if (value == prev) {
+      if (++count == 255) {
+        *p++ = count;
+        prev = -1;
+        sequence = false;
+      }
+    }
+    else {
+      *p++ = count;
+      *p++ = value;
+      prev = value;
+      sequence = false;
+    }
+  }
+  if (sequence) {
+    *p++ = count;
+  }
+  return p - out;
+}
+
+TEST(Lcd_480x272, rleBitmap)
+{
+  // long runs, runs of an odd number of bytes and single pixels
+  const uint16_t colors[] = { 0x0000, 0xFFFF, 0x1234, 0x5555, 0x00FF };
+  const int w = 137, h = 23;
+  static uint16_t pixels[w * h];
+  for (int y = 0; y < h; y++) {
+    for (int x = 0; x < w; x++) {
+      pixels[y * w + x] = ((x * y) % 13 == 1) ? x * y : colors[(x / 29 + y) % DIM(colors)];
+    }
+  }
+  static uint8_t rle[4 + 2 * sizeof(pixels)];
+  rle[0] = w; rle[1] = 0; rle[2] = h; rle[3] = 0;
+  unsigned size = rleEncode(rle + 4, (const uint8_t *)pixels, sizeof(pixels));
+  EXPECT_LT(size, sizeof(pixels));
+
+  BitmapBuffer bitmap(BMP_RGB565, w, h, pixels);
+  BitmapBuffer expected(BMP_RGB565, LCD_W, LCD_H);
+  BitmapBuffer actual(BMP_RGB565, LCD_W, LCD_H);
+  const coord_t positions[][2] = { { 0, 0 }, { 101, 57 }, { LCD_W - 50, 10 }, { 20, LCD_H - 7 }, { LCD_W - 1, LCD_H - 1 } };
+  for (auto & position: positions) {
+    expected.clear(TEXT_BGCOLOR);
+    actual.clear(TEXT_BGCOLOR);
+    expected.drawBitmap(position[0], position[1], &bitmap);
+    actual.drawRleBitmap(position[0], position[1], rle);
+    EXPECT_EQ(0, memcmp(expected.getData(), actual.getData(), expected.getDataSize()));
+  }
+}
+
 #endif
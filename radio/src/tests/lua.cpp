@@ -113,51 +113,51 @@ TEST(Lua, testModelInputs)
 
   // add one line on Input4
   luaExecStr("model.insertInput(3, 0, {name='test1', source=MIXSRC_Thr, weight=56, offset=3, switch=2})");
-  EXPECT_EQ(3, (int)g_model.expoData[0].chn);
-  EXPECT_ZSTREQ("test1", g_model.expoData[0].name);
-  EXPECT_EQ(MIXSRC_Thr, g_model.expoData[0].srcRaw);
-  EXPECT_EQ(56, g_model.expoData[0].weight);
-  EXPECT_EQ(3, g_model.expoData[0].offset);
-  EXPECT_EQ(2, g_model.expoData[0].swtch);
+  EXPECT_EQ(3, (int)expoAddress(0)->chn);
+  EXPECT_ZSTREQ("test1", expoAddress(0)->name);
+  EXPECT_EQ(MIXSRC_Thr, expoAddress(0)->srcRaw);
+  EXPECT_EQ(56, expoAddress(0)->weight);
+  EXPECT_EQ(3, expoAddress(0)->offset);
+  EXPECT_EQ(2, expoAddress(0)->swtch);
 
   // add another one before existing line on Input4
   luaExecStr("model.insertInput(3, 0, {name='test2', source=MIXSRC_Rud, weight=-56})");
-  EXPECT_EQ(3, (int)g_model.expoData[0].chn);
-  EXPECT_ZSTREQ("test2", g_model.expoData[0].name);
-  EXPECT_EQ(MIXSRC_Rud, g_model.expoData[0].srcRaw);
-  EXPECT_EQ(-56, g_model.expoData[0].weight);
-  EXPECT_EQ(0, g_model.expoData[0].offset);
-  EXPECT_EQ(0, g_model.expoData[0].swtch);
-
-  EXPECT_EQ(3, (int)g_model.expoData[1].chn);
-  EXPECT_ZSTREQ("test1", g_model.expoData[1].name);
-  EXPECT_EQ(MIXSRC_Thr, g_model.expoData[1].srcRaw);
-  EXPECT_EQ(56, g_model.expoData[1].weight);
-  EXPECT_EQ(3, g_model.expoData[1].offset);
-  EXPECT_EQ(2, g_model.expoData[1].swtch);
+  EXPECT_EQ(3, (int)expoAddress(0)->chn);
+  EXPECT_ZSTREQ("test2", expoAddress(0)->name);
+  EXPECT_EQ(MIXSRC_Rud, expoAddress(0)->srcRaw);
+  EXPECT_EQ(-56, expoAddress(0)->weight);
+  EXPECT_EQ(0, expoAddress(0)->offset);
+  EXPECT_EQ(0, expoAddress(0)->swtch);
+
+  EXPECT_EQ(3, (int)expoAddress(1)->chn);
+  EXPECT_ZSTREQ("test1", expoAddress(1)->name);
+  EXPECT_EQ(MIXSRC_Thr, expoAddress(1)->srcRaw);
+  EXPECT_EQ(56, expoAddress(1)->weight);
+  EXPECT_EQ(3, expoAddress(1)->offset);
+  EXPECT_EQ(2, expoAddress(1)->swtch);
 
   // add another line after existing lines on Input4
   luaExecStr("model.insertInput(3, model.getInputsCount(3), {name='test3', source=MIXSRC_Ail, weight=100})");
-  EXPECT_EQ(3, (int)g_model.expoData[0].chn);
-  EXPECT_ZSTREQ("test2", g_model.expoData[0].name);
-  EXPECT_EQ(MIXSRC_Rud, g_model.expoData[0].srcRaw);
-  EXPECT_EQ(-56, g_model.expoData[0].weight);
-  EXPECT_EQ(0, g_model.expoData[0].offset);
-  EXPECT_EQ(0, g_model.expoData[0].swtch);
-
-  EXPECT_EQ(3, (int)g_model.expoData[1].chn);
-  EXPECT_ZSTREQ("test1", g_model.expoData[1].name);
-  EXPECT_EQ(MIXSRC_Thr, g_model.expoData[1].srcRaw);
-  EXPECT_EQ(56, g_model.expoData[1].weight);
-  EXPECT_EQ(3, g_model.expoData[1].offset);
-  EXPECT_EQ(2, g_model.expoData[1].swtch);
-
-  EXPECT_EQ(3, (int)g_model.expoData[2].chn);
-  EXPECT_ZSTREQ("test3", g_model.expoData[2].name);
-  EXPECT_EQ(MIXSRC_Ail, g_model.expoData[2].srcRaw);
-  EXPECT_EQ(100, g_model.expoData[2].weight);
-  EXPECT_EQ(0, g_model.expoData[2].offset);
-  EXPECT_EQ(0, g_model.expoData[2].swtch);
+  EXPECT_EQ(3, (int)expoAddress(0)->chn);
+  EXPECT_ZSTREQ("test2", expoAddress(0)->name);
+  EXPECT_EQ(MIXSRC_Rud, expoAddress(0)->srcRaw);
+  EXPECT_EQ(-56, expoAddress(0)->weight);
+  EXPECT_EQ(0, expoAddress(0)->offset);
+  EXPECT_EQ(0, expoAddress(0)->swtch);
+
+  EXPECT_EQ(3, (int)expoAddress(1)->chn);
+  EXPECT_ZSTREQ("test1", expoAddress(1)->name);
+  EXPECT_EQ(MIXSRC_Thr, expoAddress(1)->srcRaw);
+  EXPECT_EQ(56, expoAddress(1)->weight);
+  EXPECT_EQ(3, expoAddress(1)->offset);
+  EXPECT_EQ(2, expoAddress(1)->swtch);
+
+  EXPECT_EQ(3, (int)expoAddress(2)->chn);
+  EXPECT_ZSTREQ("test3", expoAddress(2)->name);
+  EXPECT_EQ(MIXSRC_Ail, expoAddress(2)->srcRaw);
+  EXPECT_EQ(100, expoAddress(2)->weight);
+  EXPECT_EQ(0, expoAddress(2)->offset);
+  EXPECT_EQ(0, expoAddress(2)->swtch);
 
   // verify number of lines for Input4
   luaExecStr("noInputs = model.getInputsCount(3)");
@@ -165,4 +165,106 @@ TEST(Lua, testModelInputs)
 
 }
 
+TEST(Lua, testModelLineTables)
+{
+  MODEL_RESET();
+  luaExecStr("model.deleteMixes()");
+  luaExecStr("for i = 1, 3 do model.insertMix(0, i - 1, {name='mix'..i, source=MIXSRC_Thr, weight=10*i}) end");
+
+  // a table given to getMix() is filled and returned
+  luaExecStr("t = {} if model.getMix(0, 1, t) ~= t or t.name ~= 'mix2' or t.weight ~= 20 then error('getMix()') end");
+  luaExecStr("if model.getMix(0, 3, t) ~= nil then error('getMix()') end");
+
+  // getMixes() reuses the array and its tables, the lines removed are cleared
+  luaExecStr("a = model.getMixes(0) if #a ~= 3 or a[3].name ~= 'mix3' or a[2].source ~= MIXSRC_Thr then error('getMixes()') end");
+  luaExecStr("b = a[1] model.deleteMix(0, 0)");
+  luaExecStr("if model.getMixes(0, a) ~= a or #a ~= 2 or a[3] ~= nil or a[1] ~= b or b.name ~= 'mix2' then error('getMixes()') end");
+  luaExecStr("if #model.getMixes(1) ~= 0 then error('getMixes()') end");
+
+  // getMixFields() returns the values in the order of the names
+  luaExecStr("w, n, c = model.getMixFields(0, 1, 'weight', 'name', 'carryTrim')");
+  luaExecStr("if w ~= 30 or n ~= 'mix3' or c ~= false then error('getMixFields()') end");
+  luaExecStr("if model.getMixFields(0, 2, 'weight') ~= nil then error('getMixFields()') end");
+  luaExecStr("if pcall(model.getMixFields, 0, 0, 'unknown') then error('getMixFields()') end");
+
+  luaExecStr("model.insertInput(3, 0, {name='in1', source=MIXSRC_Ail, weight=50})");
+  luaExecStr("a = model.getInputs(3) if #a ~= 1 or a[1].name ~= 'in1' or a[1].weight ~= 50 then error('getInputs()') end");
+  luaExecStr("if model.getInputFields(3, 0, 'source') ~= MIXSRC_Ail then error('getInputFields()') end");
+
+  // the curve of an output is removed from the table when it is not set anymore
+  g_model.limitData[1].curve = 2;
+  luaExecStr("t = model.getOutput(1) if t.curve ~= 1 then error('getOutput()') end");
+  g_model.limitData[1].curve = 0;
+  luaExecStr("model.getOutput(1, t) if t.curve ~= nil or t.max ~= 1000 then error('getOutput()') end");
+  char str[128];
+  snprintf(str, sizeof(str), "a = model.getOutputs(%d, 5) if #a ~= 2 or a[2].min ~= -1000 then error('getOutputs()') end", MAX_OUTPUT_CHANNELS - 2);
+  luaExecStr(str);
+  luaExecStr("if model.getOutputFields(0, 'revert') ~= 0 then error('getOutputFields()') end");
+
+  g_model.logicalSw[2].func = LS_FUNC_VPOS;
+  g_model.logicalSw[2].andsw = 5;
+  snprintf(str, sizeof(str), "a = model.getLogicalSwitches(1, 2) if #a ~= 2 or a[2].func ~= %d or a[2]['and'] ~= 5 then error('getLogicalSwitches()') end", LS_FUNC_VPOS);
+  luaExecStr(str);
+  snprintf(str, sizeof(str), "f, s = model.getLogicalSwitchFields(2, 'func', 'and') if f ~= %d or s ~= 5 then error('getLogicalSwitchFields()') end", LS_FUNC_VPOS);
+  luaExecStr(str);
+  snprintf(str, sizeof(str), "if #model.getLogicalSwitches(%d, 3) ~= 0 then error('getLogicalSwitches()') end", MAX_LOGICAL_SWITCHES);
+  luaExecStr(str);
+}
+
+struct LuaAllocCounter {
+  lua_Alloc alloc;
+  void * ud;
+  unsigned count;
+};
+
+static void * luaCountingAlloc(void * ud, void * ptr, size_t osize, size_t nsize)
+{
+  LuaAllocCounter * counter = (LuaAllocCounter *)ud;
+  if (nsize > 0 && (!ptr || nsize > osize))
+    counter->count++;
+  return counter->alloc(counter->ud, ptr, osize, nsize);
+}
+
+// Runs the global Lua function name(n) without collection, returns the allocations done
+// (the time of the calls is measured by the lua-getoutput benchmarks)
+static unsigned luaCountAllocations(const char * name, unsigned n)
+{
+  extern lua_State * lsScripts;
+  LuaAllocCounter counter = { nullptr, nullptr, 0 };
+  counter.alloc = lua_getallocf(lsScripts, &counter.ud);
+  lua_gc(lsScripts, LUA_GCSTOP, 0);
+  lua_setallocf(lsScripts, luaCountingAlloc, &counter);
+  lua_getglobal(lsScripts, name);
+  lua_pushinteger(lsScripts, n);
+  int result = lua_pcall(lsScripts, 1, 0, 0);
+  lua_setallocf(lsScripts, counter.alloc, counter.ud);
+  lua_gc(lsScripts, LUA_GCRESTART, 0);
+  EXPECT_EQ(LUA_OK, result) << name;
+  return counter.count;
+}
+
+TEST(Lua, testModelLineAllocations)
+{
+  MODEL_RESET();
+  luaExecStr("model.deleteMixes()");
+  luaExecStr("for i = 1, 4 do model.insertMix(0, i - 1, {name='mix'..i, source=MIXSRC_Thr, weight=10*i}) end");
+
+  // the first calls create the key strings and the reused tables
+  luaExecStr("t = model.getMix(0, 0) a = model.getMixes(0) o = model.getOutput(0) model.getMixFields(0, 0, 'weight', 'offset')");
+  luaExecStr("function newTable(n) for i = 1, n do model.getMix(0, 0) end end");
+  luaExecStr("function inPlace(n) for i = 1, n do model.getMix(0, 0, t) end end");
+  luaExecStr("function bulk(n) for i = 1, n do model.getMixes(0, a) end end");
+  luaExecStr("function fields(n) for i = 1, n do local w, o = model.getMixFields(0, 0, 'weight', 'offset') end end");
+  luaExecStr("function output(n) for i = 1, n do model.getOutput(0, o) end end");
+
+  const unsigned calls = 1000;
+  for (const char * name: { "newTable", "inPlace", "bulk", "fields", "output" }) {
+    unsigned allocations = luaCountAllocations(name, calls);
+    if (!strcmp(name, "newTable"))
+      EXPECT_LE(allocations, 2 * calls);  // the table and its hash part
+    else
+      EXPECT_EQ(0u, allocations) << name;
+  }
+}
+
 #endif   // #if defined(LUA)
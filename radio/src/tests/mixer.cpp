@@ -376,19 +376,104 @@ TEST(Curves, LinearIntpol)
   EXPECT_EQ(applyCustomCurve(-192, 0), -192);
 }
 
+TEST(Curves, ExpoCoef)
+{
+  for (int k=-100; k<=100; k++) {
+    int coef = expoCoef(k);
+    for (int x=-RESX-100; x<=RESX+100; x++) {
+      EXPECT_EQ(expo(x, k), expoWithCoef(x, coef)) << "k=" << k << " x=" << x;
+    }
+  }
+}
+
+TEST(Curves, ExpoWeightCoef)
+{
+  for (int weight=MIN_EXPO_WEIGHT*10; weight<=1000; weight++) {
+    uint32_t coef = weightCoef(weight);
+    for (int x=-RESX; x<=RESX; x++) {
+      EXPECT_EQ(div_and_round(x * weight, 1000), applyWeightCoef(x, weight, coef)) << "weight=" << weight << " x=" << x;
+    }
+  }
+}
+
+TEST_F(MixerTest, ExpoWeightAndOffset)
+{
+  ExpoData * ed = expoAddress(0);
+  ed->curve.type = CURVE_REF_EXPO;
+  ed->curve.value = 40;
+  ed->weight = 75;
+  ed->offset = -10;
+  for (int x=-RESX; x<=RESX; x+=8) {
+    int16_t anas[MAX_INPUTS] = {0};
+    applyExpos(anas, e_perout_mode_normal, ed->srcRaw, x);
+    EXPECT_EQ(div_and_round(expo(x, 40) * 750, 1000) + div_and_round(calc100toRESX(-100), 10), anas[ed->chn]);
+  }
 
+  // the coefficients follow the changes of the expo line
+  ed->curve.value = -60;
+  ed->weight = 100;
+  ed->offset = 0;
+  int16_t anas[MAX_INPUTS] = {0};
+  applyExpos(anas, e_perout_mode_normal, ed->srcRaw, 512);
+  EXPECT_EQ(expo(512, -60), anas[ed->chn]);
+}
+
+
+
+TEST_F(MixerTest, LimitsAll)
+{
+  for (int i=0; i<MAX_OUTPUT_CHANNELS; i++) {
+    LimitData * lim = limitAddress(i);
+    lim->min = -(i * 61) % 500;
+    lim->max = (i * 37) % 500 - 250;
+    lim->offset = (i * 113) % 1000 - 500;
+    lim->revert = i & 1;
+  }
+  limitAddress(3)->curve = 1;                                   // slow path: curve
+  limitAddress(5)->offset = GV_CALC_VALUE_IDX_POS(0, GV1_LARGE);  // slow path: GVAR
+  limitsChanged();
+
+  int32_t values[MAX_OUTPUT_CHANNELS];
+  int16_t outputs[MAX_OUTPUT_CHANNELS];
+  for (int32_t value=-RESX*256*2; value<=RESX*256*2; value+=997) {
+    for (int i=0; i<MAX_OUTPUT_CHANNELS; i++) {
+      values[i] = value * (i & 2 ? -1 : 1);
+    }
+    applyLimitsAll(values, outputs);
+    for (int i=0; i<MAX_OUTPUT_CHANNELS; i++) {
+      EXPECT_EQ(applyLimits(i, values[i]), outputs[i]) << "channel=" << i << " value=" << values[i];
+    }
+  }
+
+  // edits are taken into account
+  limitAddress(0)->revert = 0;
+  limitAddress(0)->offset = 0;
+  limitAddress(0)->min = limitAddress(0)->max = 0;
+  storageDirty(EE_MODEL);
+  values[0] = RESX*128;
+  applyLimitsAll(values, outputs);
+  EXPECT_EQ(RESX/2, outputs[0]);
+
+  // the menus call storageDirty() before the write, the mixer may run in between
+  storageDirty(EE_MODEL);
+  applyLimitsAll(values, outputs);
+  limitAddress(0)->revert = 1;
+  checkStorageChanges();
+  applyLimitsAll(values, outputs);
+  EXPECT_EQ(-RESX/2, outputs[0]);
+}
 
 TEST_F(MixerTest, InfiniteRecursiveChannels)
 {
-  g_model.mixData[0].destCh = 0;
-  g_model.mixData[0].srcRaw = MIXSRC_CH2;
-  g_model.mixData[0].weight = 100;
-  g_model.mixData[1].destCh = 1;
-  g_model.mixData[1].srcRaw = MIXSRC_CH3;
-  g_model.mixData[1].weight = 100;
-  g_model.mixData[2].destCh = 2;
-  g_model.mixData[2].srcRaw = MIXSRC_CH1;
-  g_model.mixData[2].weight = 100;
+  testMixAddress(0)->destCh = 0;
+  testMixAddress(0)->srcRaw = MIXSRC_CH2;
+  testMixAddress(0)->weight = 100;
+  testMixAddress(1)->destCh = 1;
+  testMixAddress(1)->srcRaw = MIXSRC_CH3;
+  testMixAddress(1)->weight = 100;
+  testMixAddress(2)->destCh = 2;
+  testMixAddress(2)->srcRaw = MIXSRC_CH1;
+  testMixAddress(2)->weight = 100;
   evalFlightModeMixes(e_perout_mode_normal, 0);
   EXPECT_EQ(chans[2], 0);
   EXPECT_EQ(chans[1], 0);
@@ -397,26 +482,26 @@ TEST_F(MixerTest, InfiniteRecursiveChannels)
 
 TEST_F(MixerTest, BlockingChannel)
 {
-  g_model.mixData[0].destCh = 0;
-  g_model.mixData[0].srcRaw = MIXSRC_CH1;
-  g_model.mixData[0].weight = 100;
+  testMixAddress(0)->destCh = 0;
+  testMixAddress(0)->srcRaw = MIXSRC_CH1;
+  testMixAddress(0)->weight = 100;
   evalFlightModeMixes(e_perout_mode_normal, 0);
   EXPECT_EQ(chans[0], 0);
 }
 
 TEST_F(MixerTest, RecursiveAddChannel)
 {
-  g_model.mixData[0].destCh = 0;
-  g_model.mixData[0].mltpx = MLTPX_ADD;
-  g_model.mixData[0].srcRaw = MIXSRC_MAX;
-  g_model.mixData[0].weight = 50;
-  g_model.mixData[1].destCh = 0;
-  g_model.mixData[1].mltpx = MLTPX_ADD;
-  g_model.mixData[1].srcRaw = MIXSRC_CH2;
-  g_model.mixData[1].weight = 100;
-  g_model.mixData[2].destCh = 1;
-  g_model.mixData[2].srcRaw = MIXSRC_Rud;
-  g_model.mixData[2].weight = 100;
+  testMixAddress(0)->destCh = 0;
+  testMixAddress(0)->mltpx = MLTPX_ADD;
+  testMixAddress(0)->srcRaw = MIXSRC_MAX;
+  testMixAddress(0)->weight = 50;
+  testMixAddress(1)->destCh = 0;
+  testMixAddress(1)->mltpx = MLTPX_ADD;
+  testMixAddress(1)->srcRaw = MIXSRC_CH2;
+  testMixAddress(1)->weight = 100;
+  testMixAddress(2)->destCh = 1;
+  testMixAddress(2)->srcRaw = MIXSRC_Rud;
+  testMixAddress(2)->weight = 100;
   evalFlightModeMixes(e_perout_mode_normal, 0);
   EXPECT_EQ(chans[0], CHANNEL_MAX/2);
   EXPECT_EQ(chans[1], 0);
@@ -425,19 +510,19 @@ TEST_F(MixerTest, RecursiveAddChannel)
 TEST_F(MixerTest, RecursiveAddChannelAfterInactivePhase)
 {
   g_model.flightModeData[1].swtch = SWSRC_ID1;
-  g_model.mixData[0].destCh = 0;
-  g_model.mixData[0].mltpx = MLTPX_ADD;
-  g_model.mixData[0].srcRaw = MIXSRC_CH2;
-  g_model.mixData[0].flightModes = 0b11110;
-  g_model.mixData[0].weight = 50;
-  g_model.mixData[1].destCh = 0;
-  g_model.mixData[1].mltpx = MLTPX_ADD;
-  g_model.mixData[1].srcRaw = MIXSRC_MAX;
-  g_model.mixData[1].flightModes = 0b11101;
-  g_model.mixData[1].weight = 50;
-  g_model.mixData[2].destCh = 1;
-  g_model.mixData[2].srcRaw = MIXSRC_MAX;
-  g_model.mixData[2].weight = 100;
+  testMixAddress(0)->destCh = 0;
+  testMixAddress(0)->mltpx = MLTPX_ADD;
+  testMixAddress(0)->srcRaw = MIXSRC_CH2;
+  testMixAddress(0)->flightModes = 0b11110;
+  testMixAddress(0)->weight = 50;
+  testMixAddress(1)->destCh = 0;
+  testMixAddress(1)->mltpx = MLTPX_ADD;
+  testMixAddress(1)->srcRaw = MIXSRC_MAX;
+  testMixAddress(1)->flightModes = 0b11101;
+  testMixAddress(1)->weight = 50;
+  testMixAddress(2)->destCh = 1;
+  testMixAddress(2)->srcRaw = MIXSRC_MAX;
+  testMixAddress(2)->weight = 100;
   simuSetSwitch(3, -1);
   evalMixes(1);
   EXPECT_EQ(chans[0], CHANNEL_MAX/2);
@@ -452,13 +537,13 @@ TEST_F(MixerTest, RecursiveAddChannelAfterInactivePhase)
 TEST_F(MixerTest, SlowOnPhase)
 {
   g_model.flightModeData[1].swtch = TR(SWSRC_THR, SWSRC_SA0);
-  g_model.mixData[0].destCh = 0;
-  g_model.mixData[0].mltpx = MLTPX_ADD;
-  g_model.mixData[0].srcRaw = MIXSRC_MAX;
-  g_model.mixData[0].weight = 100;
-  g_model.mixData[0].flightModes = 0x2 + 0x4 + 0x8 + 0x10 /*only enabled in phase 0*/;
-  g_model.mixData[0].speedUp = 50;
-  g_model.mixData[0].speedDown = 50;
+  testMixAddress(0)->destCh = 0;
+  testMixAddress(0)->mltpx = MLTPX_ADD;
+  testMixAddress(0)->srcRaw = MIXSRC_MAX;
+  testMixAddress(0)->weight = 100;
+  testMixAddress(0)->flightModes = 0x2 + 0x4 + 0x8 + 0x10 /*only enabled in phase 0*/;
+  testMixAddress(0)->speedUp = 50;
+  testMixAddress(0)->speedDown = 50;
 
   s_mixer_first_run_done = true;
   mixerCurrentFlightMode = 0;
@@ -474,19 +559,19 @@ TEST_F(MixerTest, SlowOnPhase)
 
 TEST_F(MixerTest, SlowOnSwitchSource)
 {
-  g_model.mixData[0].destCh = 0;
-  g_model.mixData[0].mltpx = MLTPX_ADD;
+  testMixAddress(0)->destCh = 0;
+  testMixAddress(0)->mltpx = MLTPX_ADD;
 #if defined(PCBTARANIS) || defined(PCBHORUS)
   g_eeGeneral.switchConfig = 0x03;
-  g_model.mixData[0].srcRaw = MIXSRC_SA;
+  testMixAddress(0)->srcRaw = MIXSRC_SA;
   int switch_index = 0;
 #else
-  g_model.mixData[0].srcRaw = MIXSRC_THR;
+  testMixAddress(0)->srcRaw = MIXSRC_THR;
   int switch_index = 1;
 #endif
-  g_model.mixData[0].weight = 100;
-  g_model.mixData[0].speedUp = 50;
-  g_model.mixData[0].speedDown = 50;
+  testMixAddress(0)->weight = 100;
+  testMixAddress(0)->speedUp = 50;
+  testMixAddress(0)->speedDown = 50;
 
   s_mixer_first_run_done = true;
 
@@ -500,12 +585,12 @@ TEST_F(MixerTest, SlowOnSwitchSource)
 
 TEST_F(MixerTest, SlowDisabledOnStartup)
 {
-  g_model.mixData[0].destCh = 0;
-  g_model.mixData[0].mltpx = MLTPX_ADD;
-  g_model.mixData[0].srcRaw = MIXSRC_MAX;
-  g_model.mixData[0].weight = 100;
-  g_model.mixData[0].speedUp = 50;
-  g_model.mixData[0].speedDown = 50;
+  testMixAddress(0)->destCh = 0;
+  testMixAddress(0)->mltpx = MLTPX_ADD;
+  testMixAddress(0)->srcRaw = MIXSRC_MAX;
+  testMixAddress(0)->weight = 100;
+  testMixAddress(0)->speedUp = 50;
+  testMixAddress(0)->speedDown = 50;
 
   evalFlightModeMixes(e_perout_mode_normal, 0);
   EXPECT_EQ(chans[0], CHANNEL_MAX);
@@ -513,19 +598,19 @@ TEST_F(MixerTest, SlowDisabledOnStartup)
 
 TEST_F(MixerTest, DelayOnSwitch)
 {
-  g_model.mixData[0].destCh = 0;
-  g_model.mixData[0].mltpx = MLTPX_ADD;
-  g_model.mixData[0].srcRaw = MIXSRC_MAX;
-  g_model.mixData[0].weight = 100;
+  testMixAddress(0)->destCh = 0;
+  testMixAddress(0)->mltpx = MLTPX_ADD;
+  testMixAddress(0)->srcRaw = MIXSRC_MAX;
+  testMixAddress(0)->weight = 100;
 #if defined(PCBTARANIS) || defined(PCBHORUS)
-  g_model.mixData[0].swtch = SWSRC_SA2;
+  testMixAddress(0)->swtch = SWSRC_SA2;
   int switch_index = 0;
 #else
-  g_model.mixData[0].swtch = SWSRC_THR;
+  testMixAddress(0)->swtch = SWSRC_THR;
   int switch_index = 1;
 #endif
-  g_model.mixData[0].delayUp = 50;
-  g_model.mixData[0].delayDown = 50;
+  testMixAddress(0)->delayUp = 50;
+  testMixAddress(0)->delayDown = 50;
 
   evalFlightModeMixes(e_perout_mode_normal, 0);
   EXPECT_EQ(chans[0], 0);
@@ -545,17 +630,17 @@ TEST_F(MixerTest, DelayOnSwitch)
 
 TEST_F(MixerTest, SlowOnMultiply)
 {
-  g_model.mixData[0].destCh = 0;
-  g_model.mixData[0].mltpx = MLTPX_ADD;
-  g_model.mixData[0].srcRaw = MIXSRC_MAX;
-  g_model.mixData[0].weight = 100;
-  g_model.mixData[1].destCh = 0;
-  g_model.mixData[1].mltpx = MLTPX_MUL;
-  g_model.mixData[1].srcRaw = MIXSRC_MAX;
-  g_model.mixData[1].weight = 100;
-  g_model.mixData[1].swtch = TR(SWSRC_THR, SWSRC_SA0);
-  g_model.mixData[1].speedUp = 50;
-  g_model.mixData[1].speedDown = 50;
+  testMixAddress(0)->destCh = 0;
+  testMixAddress(0)->mltpx = MLTPX_ADD;
+  testMixAddress(0)->srcRaw = MIXSRC_MAX;
+  testMixAddress(0)->weight = 100;
+  testMixAddress(1)->destCh = 0;
+  testMixAddress(1)->mltpx = MLTPX_MUL;
+  testMixAddress(1)->srcRaw = MIXSRC_MAX;
+  testMixAddress(1)->weight = 100;
+  testMixAddress(1)->swtch = TR(SWSRC_THR, SWSRC_SA0);
+  testMixAddress(1)->speedUp = 50;
+  testMixAddress(1)->speedDown = 50;
 
   s_mixer_first_run_done = true;
 
@@ -605,18 +690,18 @@ TEST(Heli, BasicTest)
   g_model.swashR.elevatorWeight = 100;
   g_model.swashR.aileronWeight = 100;
   g_model.swashR.type = SWASH_TYPE_120;
-  g_model.mixData[0].destCh = 0;
-  g_model.mixData[0].mltpx = MLTPX_ADD;
-  g_model.mixData[0].srcRaw = MIXSRC_CYC1;
-  g_model.mixData[0].weight = 100;
-  g_model.mixData[1].destCh = 1;
-  g_model.mixData[1].mltpx = MLTPX_ADD;
-  g_model.mixData[1].srcRaw = MIXSRC_CYC2;
-  g_model.mixData[1].weight = 100;
-  g_model.mixData[2].destCh = 2;
-  g_model.mixData[2].mltpx = MLTPX_ADD;
-  g_model.mixData[2].srcRaw = MIXSRC_CYC3;
-  g_model.mixData[2].weight = 100;
+  testMixAddress(0)->destCh = 0;
+  testMixAddress(0)->mltpx = MLTPX_ADD;
+  testMixAddress(0)->srcRaw = MIXSRC_CYC1;
+  testMixAddress(0)->weight = 100;
+  testMixAddress(1)->destCh = 1;
+  testMixAddress(1)->mltpx = MLTPX_ADD;
+  testMixAddress(1)->srcRaw = MIXSRC_CYC2;
+  testMixAddress(1)->weight = 100;
+  testMixAddress(2)->destCh = 2;
+  testMixAddress(2)->mltpx = MLTPX_ADD;
+  testMixAddress(2)->srcRaw = MIXSRC_CYC3;
+  testMixAddress(2)->weight = 100;
   anaInValues[ELE_STICK] = 1024;
   evalFlightModeMixes(e_perout_mode_normal, 0);
   EXPECT_EQ(chans[0], -CHANNEL_MAX);
@@ -639,18 +724,18 @@ TEST(Heli, Mode2Test)
   g_model.swashR.elevatorWeight = 100;
   g_model.swashR.aileronWeight = 100;
   g_model.swashR.type = SWASH_TYPE_120;
-  g_model.mixData[0].destCh = 0;
-  g_model.mixData[0].mltpx = MLTPX_ADD;
-  g_model.mixData[0].srcRaw = MIXSRC_CYC1;
-  g_model.mixData[0].weight = 100;
-  g_model.mixData[1].destCh = 1;
-  g_model.mixData[1].mltpx = MLTPX_ADD;
-  g_model.mixData[1].srcRaw = MIXSRC_CYC2;
-  g_model.mixData[1].weight = 100;
-  g_model.mixData[2].destCh = 2;
-  g_model.mixData[2].mltpx = MLTPX_ADD;
-  g_model.mixData[2].srcRaw = MIXSRC_CYC3;
-  g_model.mixData[2].weight = 100;
+  testMixAddress(0)->destCh = 0;
+  testMixAddress(0)->mltpx = MLTPX_ADD;
+  testMixAddress(0)->srcRaw = MIXSRC_CYC1;
+  testMixAddress(0)->weight = 100;
+  testMixAddress(1)->destCh = 1;
+  testMixAddress(1)->mltpx = MLTPX_ADD;
+  testMixAddress(1)->srcRaw = MIXSRC_CYC2;
+  testMixAddress(1)->weight = 100;
+  testMixAddress(2)->destCh = 2;
+  testMixAddress(2)->mltpx = MLTPX_ADD;
+  testMixAddress(2)->srcRaw = MIXSRC_CYC3;
+  testMixAddress(2)->weight = 100;
   anaInValues[ELE_STICK] = 1024;
   evalFlightModeMixes(e_perout_mode_normal, 0);
   EXPECT_EQ(chans[0], -CHANNEL_MAX);
@@ -666,12 +751,12 @@ TEST(Trainer, UnpluggedTest)
   MODEL_RESET();
   MIXER_RESET();
   modelDefault(0);
-  g_model.mixData[0].destCh = 0;
-  g_model.mixData[0].mltpx = MLTPX_ADD;
-  g_model.mixData[0].srcRaw = MIXSRC_FIRST_TRAINER;
-  g_model.mixData[0].weight = 100;
-  g_model.mixData[0].delayUp = 50;
-  g_model.mixData[0].delayDown = 50;
+  testMixAddress(0)->destCh = 0;
+  testMixAddress(0)->mltpx = MLTPX_ADD;
+  testMixAddress(0)->srcRaw = MIXSRC_FIRST_TRAINER;
+  testMixAddress(0)->weight = 100;
+  testMixAddress(0)->delayUp = 50;
+  testMixAddress(0)->delayDown = 50;
   ppmInputValidityTimer = 0;
   ppmInput[0] = 1024;
   CHECK_DELAY(0, 5000);
@@ -688,16 +773,16 @@ TEST_F(MixerTest, flightModeTransition)
   g_model.flightModeData[0].fadeOut = 100;
   g_model.flightModeData[1].fadeIn = 100;
   g_model.flightModeData[1].fadeOut = 100;
-  g_model.mixData[0].destCh = 0;
-  g_model.mixData[0].mltpx = MLTPX_REP;
-  g_model.mixData[0].srcRaw = MIXSRC_MAX;
-  g_model.mixData[0].flightModes = 0b11110;
-  g_model.mixData[0].weight = 100;
-  g_model.mixData[1].destCh = 0;
-  g_model.mixData[1].mltpx = MLTPX_REP;
-  g_model.mixData[1].srcRaw = MIXSRC_MAX;
-  g_model.mixData[1].flightModes = 0b11101;
-  g_model.mixData[1].weight = -10;
+  testMixAddress(0)->destCh = 0;
+  testMixAddress(0)->mltpx = MLTPX_REP;
+  testMixAddress(0)->srcRaw = MIXSRC_MAX;
+  testMixAddress(0)->flightModes = 0b11110;
+  testMixAddress(0)->weight = 100;
+  testMixAddress(1)->destCh = 0;
+  testMixAddress(1)->mltpx = MLTPX_REP;
+  testMixAddress(1)->srcRaw = MIXSRC_MAX;
+  testMixAddress(1)->flightModes = 0b11101;
+  testMixAddress(1)->weight = -10;
   evalMixes(1);
   simuSetSwitch(0, 1);
   CHECK_FLIGHT_MODE_TRANSITION(0, 1000, 1024, -102);
@@ -712,11 +797,11 @@ TEST_F(MixerTest, flightModeOverflow)
   g_model.flightModeData[1].swtch = TR(SWSRC_ID2, SWSRC_SA2);
   g_model.flightModeData[0].fadeIn = 100;
   g_model.flightModeData[0].fadeOut = 100;
-  g_model.mixData[0].destCh = 0;
-  g_model.mixData[0].mltpx = MLTPX_REP;
-  g_model.mixData[0].srcRaw = MIXSRC_MAX;
-  g_model.mixData[0].flightModes = 0;
-  g_model.mixData[0].weight = 250;
+  testMixAddress(0)->destCh = 0;
+  testMixAddress(0)->mltpx = MLTPX_REP;
+  testMixAddress(0)->srcRaw = MIXSRC_MAX;
+  testMixAddress(0)->flightModes = 0;
+  testMixAddress(0)->weight = 250;
   evalMixes(1);
   simuSetSwitch(0, 1);
   CHECK_FLIGHT_MODE_TRANSITION(0, 1000, 1024, 1024);
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x 
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+#include "channels_packing.h"
+
+// previous implementation, bit accumulator
+static void packChannelsReference(uint8_t * out, const uint16_t * in)
+{
+  uint32_t bits = 0;
+  uint8_t bitsavailable = 0;
+  for (int i=0; i<PACKED_CHANNELS_COUNT; i++) {
+    bits |= in[i] << bitsavailable;
+    bitsavailable += PACKED_CHANNEL_BITS;
+    while (bitsavailable >= 8) {
+      *out++ = bits;
+      bits >>= 8;
+      bitsavailable -= 8;
+    }
+  }
+}
+
+static void unpackChannelsReference(uint16_t * out, const uint8_t * in)
+{
+  uint32_t inputbitsavailable = 0;
+  uint32_t inputbits = 0;
+  for (int i=0; i<PACKED_CHANNELS_COUNT; i++) {
+    while (inputbitsavailable < PACKED_CHANNEL_BITS) {
+      inputbits |= *in++ << inputbitsavailable;
+      inputbitsavailable += 8;
+    }
+    *out++ = inputbits & PACKED_CHANNEL_MASK;
+    inputbitsavailable -= PACKED_CHANNEL_BITS;
+    inputbits >>= PACKED_CHANNEL_BITS;
+  }
+}
+
+TEST(ChannelsPacking, packExhaustive)
+{
+  uint16_t values[PACKED_CHANNELS_COUNT];
+  uint8_t frame[PACKED_CHANNELS_SIZE];
+  uint8_t reference[PACKED_CHANNELS_SIZE];
+
+  for (int channel=0; channel<PACKED_CHANNELS_COUNT; channel++) {
+    for (int value=0; value<=PACKED_CHANNEL_MASK; value++) {
+      for (int i=0; i<PACKED_CHANNELS_COUNT; i++) {
+        values[i] = (i == channel ? value : (value * 7 + i * 301) & PACKED_CHANNEL_MASK);
+      }
+      packChannels(frame, values);
+      packChannelsReference(reference, values);
+      ASSERT_EQ(0, memcmp(frame, reference, sizeof(frame))) << "channel " << channel << " value " << value;
+    }
+  }
+}
+
+TEST(ChannelsPacking, unpackExhaustive)
+{
+  uint8_t frame[PACKED_CHANNELS_SIZE];
+  uint16_t values[PACKED_CHANNELS_COUNT];
+  uint16_t reference[PACKED_CHANNELS_COUNT];
+
+  // every byte value at every position
+  for (int pos=0; pos<PACKED_CHANNELS_SIZE; pos++) {
+    for (int byte=0; byte<256; byte++) {
+      for (int i=0; i<PACKED_CHANNELS_SIZE; i++) {
+        frame[i] = (i == pos ? byte : byte * 13 + i * 37);
+      }
+      unpackChannels(values, frame);
+      unpackChannelsReference(reference, frame);
+      ASSERT_EQ(0, memcmp(values, reference, sizeof(values))) << "pos " << pos << " byte " << byte;
+    }
+  }
+}
+
+TEST(ChannelsPacking, roundTrip)
+{
+  uint16_t values[PACKED_CHANNELS_COUNT];
+  uint16_t result[PACKED_CHANNELS_COUNT];
+  uint8_t frame[PACKED_CHANNELS_SIZE];
+
+  for (int value=0; value<=PACKED_CHANNEL_MASK; value++) {
+    for (int i=0; i<PACKED_CHANNELS_COUNT; i++) {
+      values[i] = (value + i * 128) & PACKED_CHANNEL_MASK;
+    }
+    packChannels(frame, values);
+    unpackChannels(result, frame);
+    ASSERT_EQ(0, memcmp(values, result, sizeof(values)));
+  }
+}
+
+TEST(ChannelsPacking, scale)
+{
+  for (int32_t x=-PACKED_CHANNEL_SCALE_MAX; x<=PACKED_CHANNEL_SCALE_MAX; x++) {
+    ASSERT_EQ(x * 4 / 5, channelScale4div5(x)) << "x " << x;
+  }
+}
+
+#if defined(SBUS)
+void processSbusFrame(uint8_t * sbus, int16_t * pulses, uint32_t size);
+
+TEST(Sbus, processSbusFrame)
+{
+  uint8_t frame[SBUS_FRAME_SIZE];
+  uint16_t values[PACKED_CHANNELS_COUNT];
+  int16_t pulses[MAX_TRAINER_CHANNELS];
+
+  for (int value=0; value<=PACKED_CHANNEL_MASK; value++) {
+    frame[0] = 0x0F;
+    for (int i=0; i<PACKED_CHANNELS_COUNT; i++) {
+      values[i] = (value + i * 128) & PACKED_CHANNEL_MASK;
+    }
+    packChannelsReference(&frame[1], values);
+    frame[SBUS_FRAME_SIZE-2] = 0;
+    frame[SBUS_FRAME_SIZE-1] = 0;
+    processSbusFrame(frame, pulses, SBUS_FRAME_SIZE);
+    for (int i=0; i<MAX_TRAINER_CHANNELS; i++) {
+      ASSERT_EQ(((int32_t)values[i] - 0x3E0) * 5 / 8, pulses[i]);
+    }
+  }
+}
+#endif
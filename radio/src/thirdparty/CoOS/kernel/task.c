@@ -793,7 +793,7 @@ void Schedule(void)
 #endif
 
 
-#if defined(DEBUG_TASKS)
+#if defined(DEBUG_TASKS) || defined(DEBUG_LOAD)
     CoTaskSwitchHook(pRdyTcb->taskID);
 #endif
 
@@ -0,0 +1,53 @@
+#!/usr/bin/env python
+
+# Converts images (PNG, JPG, BMP) into the raw bitmaps read by the color radios
+# without decoding: <image>.raw is written next to each image, to be copied on the SD card.
+# The image should not be modified afterwards, the radio ignores the raw bitmap when the
+# size of the image changes.
+
+from __future__ import division, print_function
+
+import sys
+import os.path
+import struct
+from PIL import Image
+
+BMP_RGB565 = 0
+BMP_ARGB4444 = 1
+
+
+def rgb565(r, g, b):
+    return ((r & 0xF8) << 8) + ((g & 0xFC) << 3) + ((b & 0xF8) >> 3)
+
+
+def argb4444(a, r, g, b):
+    return ((a & 0xF0) << 8) + ((r & 0xF0) << 4) + (g & 0xF0) + ((b & 0xF0) >> 4)
+
+
+def convert(filename):
+    image = Image.open(filename)
+    alpha = image.mode in ("RGBA", "LA") or "transparency" in image.info
+    image = image.convert("RGBA")
+    width, height = image.size
+
+    with open(filename + ".raw", "wb") as f:
+        f.write(struct.pack("<4sBBHHHI", b"OTXB", BMP_ARGB4444 if alpha else BMP_RGB565, 0, width, height, 0, os.path.getsize(filename)))
+        pixels = image.load()
+        for y in range(height):
+            for x in range(width):
+                r, g, b, a = pixels[x, y]
+                f.write(struct.pack("<H", argb4444(a, r, g, b) if alpha else rgb565(r, g, b)))
+
+
+def main():
+    if len(sys.argv) < 2:
+        print("Usage: %s image [image...]" % sys.argv[0])
+        sys.exit(1)
+
+    for filename in sys.argv[1:]:
+        convert(filename)
+        print("%s.raw written" % filename)
+
+
+if __name__ == "__main__":
+    main()
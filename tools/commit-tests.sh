@@ -94,6 +94,11 @@ if [[ " X7 ALL " =~ " ${FLAVOR} " ]] ; then
   make -j${CORES} ${FIRMARE_TARGET}
   make -j${CORES} libsimulator
   make -j${CORES} gtests ; ./gtests ${TEST_OPTIONS}
+  # mixes and inputs in the model arena
+  rm -rf *
+  cmake ${COMMON_OPTIONS} -DPCB=X7 -DHELI=YES -DGVARS=YES -DMODEL_ARENA=YES ${SRCDIR}
+  make -j${CORES} ${FIRMARE_TARGET}
+  make -j${CORES} gtests ; ./gtests ${TEST_OPTIONS}
 fi
 
 if [[ " XLITE ALL " =~ " ${FLAVOR} " ]] ; then
@@ -166,6 +171,9 @@ if [[ " I6X ALL " =~ " ${FLAVOR} " ]] ; then
   make -j${CORES} ${FIRMARE_TARGET}
 #  make -j${CORES} libsimulator
 #  make -j${CORES} gtests ; ./gtests ${TEST_OPTIONS}
+  rm -rf *
+  cmake ${COMMON_OPTIONS} -DPCB=I6X -DHELI=NO -DLUA=NO -DGVARS=YES -DLUA_COMPILER=NO -DMULTIMODULE=NO -DPCBI6X_ELRS=YES -DDISABLE_COMPANION=YES -DMODEL_ARENA=YES -DMODEL_ARENA_SIZE=512 ${SRCDIR}
+  make -j${CORES} ${FIRMARE_TARGET}
 fi
 
 if [[ " DEFAULT ALL " =~ " ${FLAVOR} " ]] ; then
@@ -173,4 +181,5 @@ if [[ " DEFAULT ALL " =~ " ${FLAVOR} " ]] ; then
   rm -rf *
   cmake ${COMMON_OPTIONS} ${SRCDIR}
   make -j${CORES}
+  make -j${CORES} companion-gtests ; ./companion-gtests ${TEST_OPTIONS}
 fi